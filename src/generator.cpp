@@ -0,0 +1,141 @@
+#define EXIT_DATA 2
+#include "AutomatonGenerator.h"
+#include "AutomatonSink.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const std::string USAGE = R"(Usage: compiler-ta-generator <family> [options]
+
+Families:
+  nfa         random NFA
+  dfa         random DFA
+  nth         (a|b)*a(a|b)^{n-1}, exponential determinization blowup
+  debruijn    unary cycle of length 2^n, Hopcroft worst case
+  chain       chain of n transitions, worst case for partition refinement
+
+Options:
+  --states N      state count for nfa/dfa (default 100)
+  --alphabet K    alphabet size for nfa/dfa (default 2)
+  --density D     transitions per state and symbol (default 1.0)
+  --epsilon R     share of e-transitions for nfa (default 0)
+  --final F       share of final states (default 0.1)
+  --seed S        random seed (default 0)
+  --n N           family parameter for nth/debruijn/chain
+  --disconnected  do not add the reachability chain
+  -o FILE         output .dot file (default stdout)
+)";
+
+void AssertHasValue(int index, int argc, const std::string& option)
+{
+	if (index + 1 >= argc)
+	{
+		throw std::invalid_argument("Option " + option + " requires a value");
+	}
+}
+
+void AssertIsFamilyKnown(const std::string& family)
+{
+	if (family != "nfa" && family != "dfa" && family != "nth" && family != "debruijn" && family != "chain")
+	{
+		throw std::invalid_argument("Unknown family '" + family + "'");
+	}
+}
+
+void Generate(const std::string& family, const RandomAutomatonParams& params, unsigned n, AutomatonSink& sink)
+{
+	if (family == "nfa")
+	{
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+	else if (family == "dfa")
+	{
+		AutomatonGenerator::RandomDfa(params, sink);
+	}
+	else if (family == "nth")
+	{
+		AutomatonGenerator::NthSymbolFromEnd(n, sink);
+	}
+	else if (family == "debruijn")
+	{
+		AutomatonGenerator::DeBruijnCycle(n, sink);
+	}
+	else
+	{
+		AutomatonGenerator::Chain(n, sink);
+	}
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || std::string(argv[1]) == "--help")
+	{
+		std::cout << USAGE;
+		return argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	try
+	{
+		const std::string family = argv[1];
+		AssertIsFamilyKnown(family);
+		RandomAutomatonParams params;
+		unsigned n = 8;
+		std::string outputPath;
+
+		for (int i = 2; i < argc; ++i)
+		{
+			const std::string option = argv[i];
+			if (option == "--disconnected")
+			{
+				params.connected = false;
+				continue;
+			}
+
+			AssertHasValue(i, argc, option);
+			const std::string value = argv[++i];
+
+			if (option == "--states") params.stateCount = std::stoul(value);
+			else if (option == "--alphabet") params.alphabetSize = std::stoul(value);
+			else if (option == "--density") params.density = std::stod(value);
+			else if (option == "--epsilon") params.epsilonRatio = std::stod(value);
+			else if (option == "--final") params.finalRatio = std::stod(value);
+			else if (option == "--seed") params.seed = std::stoull(value);
+			else if (option == "--n") n = std::stoul(value);
+			else if (option == "-o") outputPath = value;
+			else throw std::invalid_argument("Unknown option '" + option + "'");
+		}
+
+		const std::string title = family + "_" + std::to_string(params.seed);
+		if (outputPath.empty())
+		{
+			DotStreamSink sink(std::cout, title);
+			Generate(family, params, n, sink);
+			return EXIT_SUCCESS;
+		}
+
+		std::ofstream file(outputPath);
+		if (!file.is_open())
+		{
+			throw std::invalid_argument("The file cannot be opened");
+		}
+		DotStreamSink sink(file, title);
+		Generate(family, params, n, sink);
+	}
+	catch (const std::invalid_argument& e)
+	{
+		std::cerr << "Data error: " << e.what() << std::endl;
+		return EXIT_DATA;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
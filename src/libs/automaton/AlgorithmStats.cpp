@@ -0,0 +1,73 @@
+#include "AlgorithmStats.h"
+
+#include <sstream>
+
+namespace
+{
+double ToMilliseconds(Duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // namespace
+
+PhaseTimer::PhaseTimer(Duration* target)
+	: m_target(target)
+{
+	if (m_target != nullptr)
+	{
+		m_start = std::chrono::steady_clock::now();
+	}
+}
+
+PhaseTimer::~PhaseTimer()
+{
+	if (m_target != nullptr)
+	{
+		*m_target += std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - m_start);
+	}
+}
+
+std::string DeterminizationStats::ToJson() const
+{
+	std::ostringstream ss;
+	ss << "{"
+	   << "\"closureCalls\": " << closureCalls
+	   << ", \"moveCalls\": " << moveCalls
+	   << ", \"registryHits\": " << registryHits
+	   << ", \"registryMisses\": " << registryMisses
+	   << ", \"peakFrontierSize\": " << peakFrontierSize
+	   << ", \"dfaStates\": " << dfaStates
+	   << ", \"dfaTransitions\": " << dfaTransitions
+	   << ", \"peakBytes\": " << peakBytes
+	   << ", \"timeMs\": {"
+	   << "\"closure\": " << ToMilliseconds(closureTime)
+	   << ", \"move\": " << ToMilliseconds(moveTime)
+	   << ", \"registry\": " << ToMilliseconds(registryTime)
+	   << ", \"finalStates\": " << ToMilliseconds(finalStatesTime)
+	   << ", \"total\": " << ToMilliseconds(totalTime)
+	   << "}}";
+	return ss.str();
+}
+
+std::string MinimizationStats::ToJson() const
+{
+	std::ostringstream ss;
+	ss << "{"
+	   << "\"reachableStates\": " << reachableStates
+	   << ", \"refinementIterations\": " << refinementIterations
+	   << ", \"partitionsPerIteration\": [";
+	for (std::size_t i = 0; i < partitionsPerIteration.size(); ++i)
+	{
+		ss << (i == 0 ? "" : ", ") << partitionsPerIteration[i];
+	}
+	ss << "]"
+	   << ", \"minimizedStates\": " << minimizedStates
+	   << ", \"peakBytes\": " << peakBytes
+	   << ", \"timeMs\": {"
+	   << "\"reachability\": " << ToMilliseconds(reachabilityTime)
+	   << ", \"refinement\": " << ToMilliseconds(refinementTime)
+	   << ", \"build\": " << ToMilliseconds(buildTime)
+	   << ", \"total\": " << ToMilliseconds(totalTime)
+	   << "}}";
+	return ss.str();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using Duration = std::chrono::nanoseconds;
+
+// Замер времени фазы: добавляет прошедшее время к target при выходе из области видимости.
+// С target == nullptr ничего не делает, поэтому без сбора статистики часы не вызываются
+class PhaseTimer
+{
+public:
+	explicit PhaseTimer(Duration* target);
+	~PhaseTimer();
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+	Duration* m_target;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+struct DeterminizationStats
+{
+	std::size_t closureCalls = 0;
+	std::size_t moveCalls = 0;
+	std::size_t registryHits = 0;
+	std::size_t registryMisses = 0;
+	std::size_t peakFrontierSize = 0;
+	std::size_t dfaStates = 0;
+	std::size_t dfaTransitions = 0;
+	// Оценка памяти под реестр подмножеств и очередь (элементы и узлы деревьев)
+	std::size_t peakBytes = 0;
+
+	Duration closureTime{};
+	Duration moveTime{};
+	Duration registryTime{};
+	Duration finalStatesTime{};
+	Duration totalTime{};
+
+	std::string ToJson() const;
+};
+
+struct MinimizationStats
+{
+	// Состояния после удаления недостижимых и бесполезных
+	std::size_t reachableStates = 0;
+	std::size_t refinementIterations = 0;
+	std::vector<std::size_t> partitionsPerIteration;
+	std::size_t minimizedStates = 0;
+	// Оценка памяти под разбиение и сигнатуры состояний на самой тяжелой итерации
+	std::size_t peakBytes = 0;
+
+	Duration reachabilityTime{};
+	Duration refinementTime{};
+	Duration buildTime{};
+	Duration totalTime{};
+
+	std::string ToJson() const;
+};
@@ -0,0 +1,302 @@
+#include "ApproximateMatcher.h"
+
+#include "DeterminizationAlgorithm.h"
+#include "TrimAlgorithm.h"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+// Бит i - прочитано i символов запроса, поэтому длина ограничена разрядностью маски
+constexpr std::size_t MAX_BIT_PARALLEL_LENGTH = 63;
+
+Automaton ToTrimmedDfa(const Automaton& automaton)
+{
+	// Determine обрезает автомат сам
+	return automaton.IsDeterministic() ? TrimAlgorithm::Trim(automaton) : DeterminizationAlgorithm::Determine(automaton);
+}
+
+// Биты 0..count-1
+std::uint64_t LowBits(std::size_t count)
+{
+	return count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+}
+} // namespace
+
+struct ApproximateMatcher::Query
+{
+	Query(std::string_view word, std::size_t limit)
+		: word(word)
+		, limit(limit)
+	{
+	}
+
+	std::string_view word;
+	std::size_t limit;
+
+	// Битово-параллельный режим: маски символов и строки R[0..k] для каждой глубины обхода
+	std::array<Mask, 256> symbolMasks{};
+	Mask lengthMask = 0;
+	std::vector<Mask> masks;
+
+	// Построчная динамика для длинных запросов: на каждую глубину только полоса из bandWidth ячеек
+	std::size_t bandWidth = 0;
+	std::vector<std::size_t> rows;
+};
+
+// Состояние на пути обхода и следующий непросмотренный переход
+struct ApproximateMatcher::Frame
+{
+	State state;
+	std::size_t edge;
+	// Битово-параллельный режим сначала просматривает переходы, продвигающие запрос
+	bool isAdvancingPass;
+};
+
+ApproximateMatcher::ApproximateMatcher(const Automaton& automaton)
+{
+	const Automaton dfa = ToTrimmedDfa(automaton);
+	if (dfa.GetFinalStates().empty())
+	{
+		return;
+	}
+
+	const std::vector<State> states(dfa.GetStates().begin(), dfa.GetStates().end());
+	auto indexOf = [&](State state) {
+		return static_cast<State>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	m_final.assign(states.size(), false);
+	m_offsets.assign(states.size() + 1, 0);
+	for (std::size_t i = 0; i < states.size(); ++i)
+	{
+		m_final[i] = dfa.GetFinalStates().contains(states[i]);
+		const auto it = dfa.GetTransitions().find(states[i]);
+		if (it != dfa.GetTransitions().end())
+		{
+			for (const auto& [symbol, toStates] : it->second)
+			{
+				m_edges.emplace_back(symbol, indexOf(*toStates.begin()));
+			}
+		}
+		m_offsets[i + 1] = m_edges.size();
+	}
+	m_startState = indexOf(dfa.GetStartState());
+	m_isEmpty = false;
+}
+
+bool ApproximateMatcher::Matches(std::string_view word, std::size_t maxDistance) const
+{
+	return Distance(word, maxDistance).has_value();
+}
+
+// Поиск с возрастающим пределом: близкие слова находятся обходом с малым k,
+// который гораздо дешевле обхода с полным пределом
+std::optional<std::size_t> ApproximateMatcher::Distance(std::string_view word, std::size_t maxDistance) const
+{
+	for (std::size_t limit = 0; limit <= maxDistance; ++limit)
+	{
+		if (Search(word, limit))
+		{
+			return limit;
+		}
+	}
+	return std::nullopt;
+}
+
+bool ApproximateMatcher::Search(std::string_view word, std::size_t limit) const
+{
+	if (m_isEmpty)
+	{
+		return false;
+	}
+
+	Query query(word, limit);
+	const std::size_t width = word.size() + 1;
+
+	if (word.size() <= MAX_BIT_PARALLEL_LENGTH)
+	{
+		for (std::size_t i = 0; i < word.size(); ++i)
+		{
+			query.symbolMasks[static_cast<Symbol>(word[i])] |= Mask{1} << (i + 1);
+		}
+		query.lengthMask = LowBits(width);
+		// Глубина без ошибок не больше длины запроса, дальше память растет по мере спуска
+		query.masks.reserve((width + 1) * (limit + 1));
+		query.masks.resize(limit + 1);
+		for (std::size_t d = 0; d <= limit; ++d)
+		{
+			// До d удалений в начале запроса
+			query.masks[d] = LowBits(d + 1) & query.lengthMask;
+		}
+		return VisitBitParallel(query);
+	}
+
+	// Ячейка i глубины depth не больше k, только если |i - depth| <= k
+	query.bandWidth = std::min(width, 2 * limit + 1);
+	query.rows.resize(query.bandWidth);
+	for (std::size_t i = 0; i < query.bandWidth; ++i)
+	{
+		query.rows[i] = i;
+	}
+	return VisitRows(query);
+}
+
+bool ApproximateMatcher::VisitBitParallel(Query& query) const
+{
+	const std::size_t levels = query.limit + 1;
+	if (m_final[m_startState] && (query.masks[query.limit] >> query.word.size()) & 1)
+	{
+		return true;
+	}
+
+	std::vector<Frame> stack;
+	stack.reserve(query.word.size() + 2);
+	stack.push_back({m_startState, m_offsets[m_startState], true});
+	while (!stack.empty())
+	{
+		const std::size_t depth = stack.size() - 1;
+		if (query.masks.size() < (depth + 2) * levels)
+		{
+			query.masks.resize((depth + 2) * levels);
+		}
+		const Mask* current = &query.masks[depth * levels];
+		Mask* next = &query.masks[(depth + 1) * levels];
+		// Сначала символы, которые продвигают запрос, затем остальные
+		const Mask advancing = current[query.limit] << 1;
+
+		// Переходы просматриваются до первого спуска, после возврата просмотр продолжается с того же места
+		Frame& frame = stack.back();
+		const std::size_t end = m_offsets[frame.state + 1];
+		std::optional<State> child;
+		while (!child)
+		{
+			if (frame.edge == end)
+			{
+				if (!frame.isAdvancingPass)
+				{
+					break;
+				}
+				frame.isAdvancingPass = false;
+				frame.edge = m_offsets[frame.state];
+				continue;
+			}
+
+			const auto [symbol, target] = m_edges[frame.edge++];
+			const Mask symbolMask = query.symbolMasks[symbol];
+			if (((symbolMask & advancing) != 0) != frame.isAdvancingPass)
+			{
+				continue;
+			}
+
+			next[0] = (current[0] << 1) & symbolMask;
+			for (std::size_t d = 1; d <= query.limit; ++d)
+			{
+				// Совпадение, вставка, замена и удаление символа запроса
+				next[d] = (((current[d] << 1) & symbolMask) | current[d - 1] | (current[d - 1] << 1) | (next[d - 1] << 1))
+					& query.lengthMask;
+			}
+
+			if (next[query.limit] == 0)
+			{
+				continue;
+			}
+			if (m_final[target] && (next[query.limit] >> query.word.size()) & 1)
+			{
+				return true;
+			}
+			child = target;
+		}
+
+		if (child)
+		{
+			stack.push_back({*child, m_offsets[*child], true});
+		}
+		else
+		{
+			stack.pop_back();
+		}
+	}
+	return false;
+}
+
+bool ApproximateMatcher::VisitRows(Query& query) const
+{
+	const std::size_t width = query.word.size() + 1;
+	const std::size_t band = query.bandWidth;
+	const std::size_t unreachable = query.limit + 1;
+	// Полоса глубины depth начинается с ячейки depth - k и прижимается к краям строки
+	auto bandStart = [&](std::size_t depth) {
+		return std::min(depth > query.limit ? depth - query.limit : 0, width - band);
+	};
+	auto isFinalCellReached = [&](const std::size_t* row, std::size_t depth) {
+		return bandStart(depth) + band == width && row[band - 1] <= query.limit;
+	};
+
+	if (m_final[m_startState] && isFinalCellReached(query.rows.data(), 0))
+	{
+		return true;
+	}
+
+	std::vector<Frame> stack = {{m_startState, m_offsets[m_startState], false}};
+	while (!stack.empty())
+	{
+		const std::size_t depth = stack.size() - 1;
+		if (query.rows.size() < (depth + 2) * band)
+		{
+			query.rows.resize((depth + 2) * band);
+		}
+		const std::size_t* current = &query.rows[depth * band];
+		std::size_t* next = &query.rows[(depth + 1) * band];
+
+		const std::size_t currentStart = bandStart(depth);
+		const std::size_t nextStart = bandStart(depth + 1);
+		// Ячейки вне полосы заведомо больше k
+		auto currentCell = [&](std::size_t i) {
+			return i >= currentStart && i < currentStart + band ? current[i - currentStart] : unreachable;
+		};
+
+		Frame& frame = stack.back();
+		const std::size_t end = m_offsets[frame.state + 1];
+		std::optional<State> child;
+		while (!child && frame.edge != end)
+		{
+			const auto [symbol, target] = m_edges[frame.edge++];
+			std::size_t minimum = unreachable;
+			for (std::size_t j = 0; j < band; ++j)
+			{
+				const std::size_t i = nextStart + j;
+				std::size_t value = depth + 1;
+				if (i > 0)
+				{
+					const std::size_t substitution = currentCell(i - 1) + (static_cast<Symbol>(query.word[i - 1]) != symbol);
+					const std::size_t insertion = j > 0 ? next[j - 1] + 1 : unreachable;
+					value = std::min({currentCell(i) + 1, insertion, substitution});
+				}
+				next[j] = std::min(value, unreachable);
+				minimum = std::min(minimum, next[j]);
+			}
+
+			if (minimum > query.limit)
+			{
+				continue;
+			}
+			if (m_final[target] && isFinalCellReached(next, depth + 1))
+			{
+				return true;
+			}
+			child = target;
+		}
+
+		if (child)
+		{
+			stack.push_back({*child, m_offsets[*child], false});
+		}
+		else
+		{
+			stack.pop_back();
+		}
+	}
+	return false;
+}
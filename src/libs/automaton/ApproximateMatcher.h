@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Нечеткое распознавание: есть ли в языке слово на расстоянии Левенштейна не больше k.
+// Обход обрезанного ДКА в глубину одновременно с битово-параллельным автоматом Левенштейна для запроса
+// (Wu-Manber): R[d] - позиции запроса, достижимые не более чем с d ошибками.
+// Ветка отсекается, как только R[k] пуст; мертвых состояний после обрезки нет,
+// поэтому глубина обхода не превышает длины запроса плюс k.
+// Запросы длиннее 63 символов считаются построчной динамикой в полосе ширины 2k + 1 (Укконен).
+// Обход идет по явному стеку, строки выделяются только для глубин, до которых он дошел
+class ApproximateMatcher
+{
+public:
+	// НКА детерминизируется
+	explicit ApproximateMatcher(const Automaton& automaton);
+
+	bool Matches(std::string_view word, std::size_t maxDistance) const;
+	// Наименьшее расстояние до слова языка, если оно не больше maxDistance
+	std::optional<std::size_t> Distance(std::string_view word, std::size_t maxDistance) const;
+
+private:
+	using Mask = std::uint64_t;
+
+	struct Query;
+	struct Frame;
+
+	bool Search(std::string_view word, std::size_t limit) const;
+	bool VisitBitParallel(Query& query) const;
+	bool VisitRows(Query& query) const;
+
+	// Обрезанный ДКА в сжатом виде: переходы состояния s - m_edges[m_offsets[s]..m_offsets[s + 1])
+	std::vector<std::size_t> m_offsets;
+	std::vector<std::pair<Symbol, State>> m_edges;
+	std::vector<char> m_final;
+	State m_startState = 0;
+	bool m_isEmpty = true;
+};
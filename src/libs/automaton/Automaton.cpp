@@ -2,6 +2,7 @@
 
 #include "AutomatonVisualizer.h"
 #include "DeterminizationAlgorithm.h"
+#include "SymbolFormat.h"
 
 #include <regex>
 
@@ -18,15 +19,15 @@ void AssertIsAutomatonDeterministic(const Automaton& automaton)
 
 bool Automaton::IsDeterministic() const
 {
+	if (!m_epsilonTransitions.empty())
+	{
+		return false;
+	}
+
 	for (const auto& fromPair : m_transitions)
 	{
 		for (const auto& onPair : fromPair.second)
 		{
-			if (onPair.first == EPSILON)
-			{
-				return false;
-			}
-
 			if (onPair.second.size() > 1)
 			{
 				return false;
@@ -37,8 +38,35 @@ bool Automaton::IsDeterministic() const
 	return true;
 }
 
+bool Automaton::HasEpsilonTransitions() const
+{
+	return !m_epsilonTransitions.empty();
+}
+
 bool Automaton::Recognize(const std::string& inputString, bool logSteps) const
 {
+	if (!logSteps && m_epsilonTransitions.empty())
+	{
+		// Без e-переходов замыкание тождественно, достаточно Move
+		std::set<State> currentStates = {m_startState};
+		for (const auto symbol : inputString)
+		{
+			currentStates = DeterminizationAlgorithm::Move(*this, currentStates, symbol);
+			if (currentStates.empty())
+			{
+				return false;
+			}
+		}
+		for (const auto state : currentStates)
+		{
+			if (m_finalStates.contains(state))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	if (!logSteps)
 	{
 		auto currentStates = DeterminizationAlgorithm::EpsilonClosure(*this, m_startState);
@@ -68,7 +96,7 @@ bool Automaton::Recognize(const std::string& inputString, bool logSteps) const
 
 		if (currentStates.empty())
 		{
-			std::string reason = "No valid transition [previous states '" + std::string(1, symbol) + "']";
+			std::string reason = "No valid transition [previous states '" + SymbolFormat::ToLabel(symbol) + "']";
 			AutomatonVisualizer::PrintRecognize(inputString, false, reason);
 			return false;
 		}
@@ -98,6 +126,45 @@ bool Automaton::Recognize(const std::string& inputString, bool logSteps) const
 	return false;
 }
 
+std::optional<std::size_t> Automaton::Search(const std::string& text) const
+{
+	if (m_states.empty())
+	{
+		return std::nullopt;
+	}
+
+	const auto startClosure = DeterminizationAlgorithm::EpsilonClosure(*this, m_startState);
+	auto hasFinal = [this](const std::set<State>& states) {
+		for (const auto state : states)
+		{
+			if (m_finalStates.contains(state))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// Вхождение может начаться в любой позиции, поэтому на каждом шаге добавляем замыкание старта
+	auto currentStates = startClosure;
+	if (hasFinal(currentStates))
+	{
+		return 0;
+	}
+
+	for (std::size_t i = 0; i < text.size(); ++i)
+	{
+		currentStates = DeterminizationAlgorithm::EpsilonClosure(*this, DeterminizationAlgorithm::Move(*this, currentStates, text[i]));
+		if (hasFinal(currentStates))
+		{
+			return i + 1;
+		}
+		currentStates.insert(startClosure.begin(), startClosure.end());
+	}
+
+	return std::nullopt;
+}
+
 void Automaton::Clear()
 {
 	m_title.clear();
@@ -105,9 +172,58 @@ void Automaton::Clear()
 	m_alphabet.clear();
 	m_transitions.clear();
 	m_startState = 0;
+	m_epsilonTransitions.clear();
 	m_finalStates.clear();
 }
 
+void Automaton::RetainStates(const std::set<State>& states)
+{
+	if (m_states.empty())
+	{
+		return;
+	}
+
+	auto isRemoved = [&](State state) {
+		return !states.contains(state);
+	};
+	for (auto from = m_transitions.begin(); from != m_transitions.end();)
+	{
+		auto& transitions = from->second;
+		if (isRemoved(from->first))
+		{
+			transitions.clear();
+		}
+		for (auto transition = transitions.begin(); transition != transitions.end();)
+		{
+			std::erase_if(transition->second, isRemoved);
+			transition = transition->second.empty() ? transitions.erase(transition) : std::next(transition);
+		}
+		from = transitions.empty() ? m_transitions.erase(from) : std::next(from);
+	}
+	for (auto from = m_epsilonTransitions.begin(); from != m_epsilonTransitions.end();)
+	{
+		if (isRemoved(from->first))
+		{
+			from->second.clear();
+		}
+		std::erase_if(from->second, isRemoved);
+		from = from->second.empty() ? m_epsilonTransitions.erase(from) : std::next(from);
+	}
+	std::erase_if(m_finalStates, isRemoved);
+	std::erase_if(m_states, [&](State state) {
+		return isRemoved(state) && state != m_startState;
+	});
+
+	m_alphabet.clear();
+	for (const auto& [from, transitions] : m_transitions)
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			m_alphabet.insert(symbol);
+		}
+	}
+}
+
 void Automaton::Swap(Automaton& other)
 {
 	std::swap(m_title, other.m_title);
@@ -115,6 +231,7 @@ void Automaton::Swap(Automaton& other)
 	std::swap(m_alphabet, other.m_alphabet);
 	std::swap(m_transitions, other.m_transitions);
 	std::swap(m_startState, other.m_startState);
+	std::swap(m_epsilonTransitions, other.m_epsilonTransitions);
 	std::swap(m_finalStates, other.m_finalStates);
 }
 
@@ -135,19 +252,27 @@ void Automaton::AddFinalState(const State finalState)
 	m_states.insert(finalState);
 }
 
+void Automaton::AddState(const State state)
+{
+	m_states.insert(state);
+}
+
 void Automaton::AddTransition(const State from, const Symbol on, const State to)
 {
 	m_states.insert(from);
 	m_states.insert(to);
 
-	if (on != EPSILON)
-	{
-		m_alphabet.insert(on);
-	}
-
+	m_alphabet.insert(on);
 	m_transitions[from][on].insert(to);
 }
 
+void Automaton::AddEpsilonTransition(const State from, const State to)
+{
+	m_states.insert(from);
+	m_states.insert(to);
+	m_epsilonTransitions[from].insert(to);
+}
+
 const std::string& Automaton::GetTitle() const
 {
 	return m_title;
@@ -168,6 +293,11 @@ const std::map<State, std::map<Symbol, std::set<State>>>& Automaton::GetTransiti
 	return m_transitions;
 }
 
+const std::map<State, std::set<State>>& Automaton::GetEpsilonTransitions() const
+{
+	return m_epsilonTransitions;
+}
+
 State Automaton::GetStartState() const
 {
 	return m_startState;
@@ -1,19 +1,25 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <regex>
 
+// Символ - любой байт; e-переходы хранятся отдельно и символа не занимают
 using Symbol = unsigned char;
 using State = unsigned int;
-constexpr Symbol EPSILON = 'e';
 
 class Automaton
 {
 public:
 	Automaton() = default;
 	~Automaton() = default;
+	// Объявленный деструктор подавляет неявное перемещение, без этих строк std::move копировал бы деревья
+	Automaton(const Automaton&) = default;
+	Automaton& operator=(const Automaton&) = default;
+	Automaton(Automaton&&) noexcept = default;
+	Automaton& operator=(Automaton&&) noexcept = default;
 
 	void SetTitle(const std::string& title);
 	const std::string& GetTitle() const;
@@ -24,23 +30,36 @@ public:
 	void AddFinalState(State finalState);
 	const std::set<State>& GetFinalStates() const;
 
+	void AddState(State state);
 	void AddTransition(State from, Symbol on, State to);
 	const std::map<State, std::map<Symbol, std::set<State>>>& GetTransitions() const;
 
+	void AddEpsilonTransition(State from, State to);
+	const std::map<State, std::set<State>>& GetEpsilonTransitions() const;
+
 	const std::set<State>& GetStates() const;
 	const std::set<Symbol>& GetAlphabet() const;
 
 	bool Recognize(const std::string& inputString, bool logSteps = false) const;
+	// Поиск подстроки из языка автомата, возвращает конец самого раннего вхождения
+	std::optional<std::size_t> Search(const std::string& text) const;
 	void Swap(Automaton& automaton);
 	void Clear();
+	// Оставляет только states (и стартовое состояние) и переходы между ними; узлы остальных освобождаются сразу
+	void RetainStates(const std::set<State>& states);
 
 	bool IsDeterministic() const;
+	bool HasEpsilonTransitions() const;
 
 private:
+	// Заполняет деревья уже отсортированными данными, минуя поиск при вставке
+	friend class AutomatonArena;
+
 	std::string m_title;
 	std::set<State> m_states;
 	std::set<Symbol> m_alphabet;
 	std::map<State, std::map<Symbol, std::set<State>>> m_transitions;
+	std::map<State, std::set<State>> m_epsilonTransitions;
 	State m_startState = 0;
 	std::set<State> m_finalStates;
 };
\ No newline at end of file
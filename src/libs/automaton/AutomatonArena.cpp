@@ -0,0 +1,133 @@
+#include "AutomatonArena.h"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+template <typename T>
+void SortUnique(std::vector<T>& values)
+{
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+} // namespace
+
+void AutomatonArena::Reserve(std::size_t states, std::size_t edges)
+{
+	// Концы переходов попадают в список состояний при Freeze
+	m_states.reserve(states + 2 * edges);
+	m_edges.reserve(edges);
+}
+
+void AutomatonArena::SetTitle(const std::string& title)
+{
+	m_title = title;
+}
+
+void AutomatonArena::SetStartState(State startState)
+{
+	m_startState = startState;
+	m_hasStartState = true;
+}
+
+void AutomatonArena::AddFinalState(State finalState)
+{
+	m_finalStates.push_back(finalState);
+}
+
+void AutomatonArena::AddState(State state)
+{
+	m_states.push_back(state);
+}
+
+void AutomatonArena::AddTransition(State from, Symbol on, State to)
+{
+	m_edges.push_back({from, on, to});
+}
+
+void AutomatonArena::AddEpsilonTransition(State from, State to)
+{
+	m_epsilonEdges.emplace_back(from, to);
+}
+
+// После сортировки каждое дерево заполняется по возрастанию ключей, поэтому подсказка end() всегда точна
+Automaton AutomatonArena::Freeze()
+{
+	Automaton automaton;
+	automaton.m_title = std::move(m_title);
+	automaton.m_startState = m_startState;
+
+	if (m_hasStartState)
+	{
+		m_states.push_back(m_startState);
+	}
+	m_states.insert(m_states.end(), m_finalStates.begin(), m_finalStates.end());
+	for (const auto& edge : m_edges)
+	{
+		m_states.push_back(edge.from);
+		m_states.push_back(edge.to);
+	}
+	for (const auto& [from, to] : m_epsilonEdges)
+	{
+		m_states.push_back(from);
+		m_states.push_back(to);
+	}
+	SortUnique(m_states);
+	for (const State state : m_states)
+	{
+		automaton.m_states.emplace_hint(automaton.m_states.end(), state);
+	}
+	SortUnique(m_finalStates);
+	for (const State state : m_finalStates)
+	{
+		automaton.m_finalStates.emplace_hint(automaton.m_finalStates.end(), state);
+	}
+
+	SortUnique(m_edges);
+	std::array<bool, 256> isUsed{};
+	auto& transitions = automaton.m_transitions;
+	for (std::size_t i = 0; i < m_edges.size();)
+	{
+		const State from = m_edges[i].from;
+		auto& row = transitions.emplace_hint(transitions.end(), from, std::map<Symbol, std::set<State>>{})->second;
+		while (i < m_edges.size() && m_edges[i].from == from)
+		{
+			const Symbol on = m_edges[i].on;
+			isUsed[on] = true;
+			auto& targets = row.emplace_hint(row.end(), on, std::set<State>{})->second;
+			for (; i < m_edges.size() && m_edges[i].from == from && m_edges[i].on == on; ++i)
+			{
+				targets.emplace_hint(targets.end(), m_edges[i].to);
+			}
+		}
+	}
+	for (std::size_t symbol = 0; symbol < isUsed.size(); ++symbol)
+	{
+		if (isUsed[symbol])
+		{
+			automaton.m_alphabet.emplace_hint(automaton.m_alphabet.end(), static_cast<Symbol>(symbol));
+		}
+	}
+
+	SortUnique(m_epsilonEdges);
+	auto& epsilonTransitions = automaton.m_epsilonTransitions;
+	for (std::size_t i = 0; i < m_epsilonEdges.size();)
+	{
+		const State from = m_epsilonEdges[i].first;
+		auto& targets = epsilonTransitions.emplace_hint(epsilonTransitions.end(), from, std::set<State>{})->second;
+		for (; i < m_epsilonEdges.size() && m_epsilonEdges[i].first == from; ++i)
+		{
+			targets.emplace_hint(targets.end(), m_epsilonEdges[i].second);
+		}
+	}
+
+	m_title.clear();
+	m_startState = 0;
+	m_hasStartState = false;
+	m_states.clear();
+	m_finalStates.clear();
+	m_edges.clear();
+	m_epsilonEdges.clear();
+	return automaton;
+}
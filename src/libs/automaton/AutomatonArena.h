@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Построитель больших автоматов: состояния и переходы дописываются в плоские массивы без выделения
+// узлов деревьев на каждый вызов, а Freeze один раз сортирует их и заполняет деревья Automaton
+// вставками в конец, без поиска и без узлов для повторов
+class AutomatonArena
+{
+public:
+	AutomatonArena() = default;
+	~AutomatonArena() = default;
+
+	// Ожидаемое число состояний и переходов по символам
+	void Reserve(std::size_t states, std::size_t edges);
+
+	void SetTitle(const std::string& title);
+	void SetStartState(State startState);
+	void AddFinalState(State finalState);
+	void AddState(State state);
+	void AddTransition(State from, Symbol on, State to);
+	void AddEpsilonTransition(State from, State to);
+
+	// Возвращает автомат и очищает построитель, память массивов остается для следующего автомата
+	Automaton Freeze();
+
+private:
+	struct Edge
+	{
+		State from;
+		Symbol on;
+		State to;
+
+		auto operator<=>(const Edge& other) const = default;
+	};
+
+	std::string m_title;
+	State m_startState = 0;
+	bool m_hasStartState = false;
+	std::vector<State> m_states;
+	std::vector<State> m_finalStates;
+	std::vector<Edge> m_edges;
+	std::vector<std::pair<State, State>> m_epsilonEdges;
+};
@@ -1,5 +1,8 @@
 #include "AutomatonBuilder.h"
+#include "SymbolFormat.h"
+
 #include <fstream>
+#include <vector>
 
 namespace
 {
@@ -7,7 +10,7 @@ const std::regex TITLE_REGEX(R"REGEX(\s*digraph\s+(\w+)\s*\{?\s*)REGEX");
 const std::regex START_REGEX(R"REGEX(\s*start\s*=\s*(\w+)\s*;?\s*)REGEX");
 const std::regex FINAL_REGEX(R"REGEX(\s*final\s*=\s*([^;]+);?\s*)REGEX");
 const std::regex TRANSITION_EPS_REGEX(R"REGEX(\s*(\w+)\s*->\s*(\w+)\s*;?\s*)REGEX");
-const std::regex TRANSITION_LABEL_REGEX(R"REGEX(\s*(\w+)\s*->\s*(\w+)\s*\[label\s*=\s*"([^"]*)"\]\s*;?\s*)REGEX");
+const std::regex TRANSITION_LABEL_REGEX(R"REGEX(\s*(\w+)\s*->\s*(\w+)\s*\[label\s*=\s*"((?:[^"\\]|\\.)*)"\]\s*;?\s*)REGEX");
 
 void AssertIsFileOpen(const std::ifstream& file)
 {
@@ -17,14 +20,6 @@ void AssertIsFileOpen(const std::ifstream& file)
 	}
 }
 
-void AssertIsSymbolValid(std::string_view label)
-{
-	if (label.length() > 1)
-	{
-		throw std::invalid_argument("There must be one character");
-	}
-}
-
 std::string_view Trim(std::string_view sv)
 {
 	const auto first = sv.find_first_not_of(" \t\n\r");
@@ -37,6 +32,27 @@ std::string_view Trim(std::string_view sv)
 	return sv.substr(first, last - first + 1);
 }
 
+// Разбивает метку по запятым, не разделяя экранированные "\,"
+std::vector<std::string_view> SplitLabels(std::string_view labels)
+{
+	std::vector<std::string_view> result;
+	std::size_t begin = 0;
+	for (std::size_t i = 0; i < labels.size(); ++i)
+	{
+		if (labels[i] == '\\')
+		{
+			++i;
+		}
+		else if (labels[i] == ',')
+		{
+			result.push_back(labels.substr(begin, i - begin));
+			begin = i + 1;
+		}
+	}
+	result.push_back(labels.substr(begin));
+	return result;
+}
+
 std::set<State> ParseStateList(const std::string& list)
 {
 	std::stringstream ss(list);
@@ -58,9 +74,10 @@ std::set<State> ParseStateList(const std::string& list)
 }
 } // namespace
 
+// Переходы копятся в AutomatonArena и раскладываются в деревья один раз в конце файла
 Automaton AutomatonBuilder::FromFile(const std::string& filename)
 {
-	Automaton automaton;
+	AutomatonArena automaton;
 
 	std::ifstream file(filename);
 	AssertIsFileOpen(file);
@@ -71,10 +88,10 @@ Automaton AutomatonBuilder::FromFile(const std::string& filename)
 		ParseLine(automaton, line);
 	}
 
-	return automaton;
+	return automaton.Freeze();
 }
 
-void AutomatonBuilder::ParseLine(Automaton& automaton, const std::string& line)
+void AutomatonBuilder::ParseLine(AutomatonArena& automaton, const std::string& line)
 {
 	std::smatch match;
 
@@ -100,17 +117,17 @@ void AutomatonBuilder::ParseLine(Automaton& automaton, const std::string& line)
 	}
 }
 
-void AutomatonBuilder::HandleTitleDeclaration(Automaton& automaton,const std::smatch& match)
+void AutomatonBuilder::HandleTitleDeclaration(AutomatonArena& automaton,const std::smatch& match)
 {
 	automaton.SetTitle(match[1].str());
 }
 
-void AutomatonBuilder::HandleStartDeclaration(Automaton& automaton,const std::smatch& match)
+void AutomatonBuilder::HandleStartDeclaration(AutomatonArena& automaton,const std::smatch& match)
 {
 	automaton.SetStartState(std::stoul(match[1].str()));
 }
 
-void AutomatonBuilder::HandleFinalDeclaration(Automaton& automaton,const std::smatch& match)
+void AutomatonBuilder::HandleFinalDeclaration(AutomatonArena& automaton,const std::smatch& match)
 {
 	for (const auto& state : ParseStateList(match[1].str()))
 	{
@@ -118,15 +135,15 @@ void AutomatonBuilder::HandleFinalDeclaration(Automaton& automaton,const std::sm
 	}
 }
 
-void AutomatonBuilder::HandleEpsilonTransition(Automaton& automaton,const std::smatch& match)
+void AutomatonBuilder::HandleEpsilonTransition(AutomatonArena& automaton,const std::smatch& match)
 {
 	const State from = std::stoul(match[1].str());
 	const State to = std::stoul(match[2].str());
 
-	automaton.AddTransition(from, EPSILON, to);
+	automaton.AddEpsilonTransition(from, to);
 }
 
-void AutomatonBuilder::HandleLabelTransition(Automaton& automaton,const std::smatch& match)
+void AutomatonBuilder::HandleLabelTransition(AutomatonArena& automaton,const std::smatch& match)
 {
 	const State from = std::stoul(match[1].str());
 	const State to = std::stoul(match[2].str());
@@ -134,7 +151,7 @@ void AutomatonBuilder::HandleLabelTransition(Automaton& automaton,const std::sma
 
 	if (labelsStr.empty())
 	{
-		automaton.AddTransition(from, EPSILON, to);
+		automaton.AddEpsilonTransition(from, to);
 	}
 	else
 	{
@@ -142,12 +159,9 @@ void AutomatonBuilder::HandleLabelTransition(Automaton& automaton,const std::sma
 	}
 }
 
-void AutomatonBuilder::ParseTransitionLabels(Automaton& automaton, State from, State to, const std::string& labels)
+void AutomatonBuilder::ParseTransitionLabels(AutomatonArena& automaton, State from, State to, const std::string& labels)
 {
-	std::stringstream ss(labels);
-	std::string label;
-
-	while (std::getline(ss, label, ','))
+	for (const auto label : SplitLabels(labels))
 	{
 		auto trimLabel = Trim(label);
 		if (trimLabel.empty())
@@ -155,8 +169,14 @@ void AutomatonBuilder::ParseTransitionLabels(Automaton& automaton, State from, S
 			continue;
 		}
 
-		AssertIsSymbolValid(trimLabel);
-		Symbol symbol = trimLabel[0];
-		automaton.AddTransition(from, symbol, to);
+		const auto symbol = SymbolFormat::FromLabel(trimLabel);
+		if (symbol)
+		{
+			automaton.AddTransition(from, *symbol, to);
+		}
+		else
+		{
+			automaton.AddEpsilonTransition(from, to);
+		}
 	}
 }
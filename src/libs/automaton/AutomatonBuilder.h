@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Automaton.h"
+#include "AutomatonArena.h"
 #include <string>
 #include <regex>
 
@@ -10,11 +11,11 @@ public:
 	static Automaton FromFile(const std::string& filename);
 
 private:
-	static void ParseLine(Automaton& automaton, const std::string& line);
-	static void HandleTitleDeclaration(Automaton& automaton, const std::smatch& match);
-	static void HandleStartDeclaration(Automaton& automaton, const std::smatch& match);
-	static void HandleFinalDeclaration(Automaton& automaton, const std::smatch& match);
-	static void HandleLabelTransition(Automaton& automaton, const std::smatch& match);
-	static void HandleEpsilonTransition(Automaton& automaton, const std::smatch& match);
-	static void ParseTransitionLabels(Automaton& automaton, State from, State to, const std::string& labels);
+	static void ParseLine(AutomatonArena& automaton, const std::string& line);
+	static void HandleTitleDeclaration(AutomatonArena& automaton, const std::smatch& match);
+	static void HandleStartDeclaration(AutomatonArena& automaton, const std::smatch& match);
+	static void HandleFinalDeclaration(AutomatonArena& automaton, const std::smatch& match);
+	static void HandleLabelTransition(AutomatonArena& automaton, const std::smatch& match);
+	static void HandleEpsilonTransition(AutomatonArena& automaton, const std::smatch& match);
+	static void ParseTransitionLabels(AutomatonArena& automaton, State from, State to, const std::string& labels);
 };
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "AutomatonSerializer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::array<char, 4> MAGIC = {'C', 'T', 'A', 'B'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+void AssertIsFileOpen(const std::ios& file)
+{
+	if (!file)
+	{
+		throw std::invalid_argument("The file cannot be opened");
+	}
+}
+
+void AssertIsStreamValid(const std::istream& input)
+{
+	if (!input)
+	{
+		throw std::invalid_argument("Unexpected end of binary automaton");
+	}
+}
+
+template <typename T>
+void Write(std::ostream& output, T value)
+{
+	output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T Read(std::istream& input)
+{
+	T value{};
+	input.read(reinterpret_cast<char*>(&value), sizeof(value));
+	AssertIsStreamValid(input);
+	return value;
+}
+
+void AssertFitsInStream(std::istream& input, std::uint64_t length)
+{
+	const auto position = input.tellg();
+	if (position == std::istream::pos_type(-1))
+	{
+		// Поток без позиционирования: длину ограничит чтение порциями
+		return;
+	}
+	input.seekg(0, std::ios::end);
+	const auto end = input.tellg();
+	input.seekg(position);
+	AssertIsStreamValid(input);
+	if (length > static_cast<std::uint64_t>(end - position))
+	{
+		throw std::invalid_argument("Binary automaton title is longer than the file");
+	}
+}
+
+std::string ReadString(std::istream& input)
+{
+	constexpr std::size_t CHUNK_SIZE = 4096;
+
+	const auto length = Read<std::uint32_t>(input);
+	AssertFitsInStream(input, length);
+
+	// Память растет вместе с прочитанными данными, а не с заявленной длиной
+	std::string result;
+	while (result.size() < length)
+	{
+		const auto offset = result.size();
+		const auto chunk = std::min<std::size_t>(CHUNK_SIZE, length - offset);
+		result.resize(offset + chunk);
+		input.read(result.data() + offset, static_cast<std::streamsize>(chunk));
+		AssertIsStreamValid(input);
+	}
+	return result;
+}
+} // namespace
+
+void AutomatonSerializer::WriteBinary(const Automaton& automaton, std::ostream& output)
+{
+	output.write(MAGIC.data(), MAGIC.size());
+	Write<std::uint32_t>(output, FORMAT_VERSION);
+
+	const auto& title = automaton.GetTitle();
+	Write<std::uint32_t>(output, static_cast<std::uint32_t>(title.size()));
+	output.write(title.data(), static_cast<std::streamsize>(title.size()));
+
+	Write<std::uint32_t>(output, automaton.GetStartState());
+
+	// Состояния пишутся явно, чтобы сохранить изолированные вершины
+	Write<std::uint64_t>(output, automaton.GetStates().size());
+	for (const State state : automaton.GetStates())
+	{
+		Write<std::uint32_t>(output, state);
+	}
+
+	Write<std::uint64_t>(output, automaton.GetFinalStates().size());
+	for (const State state : automaton.GetFinalStates())
+	{
+		Write<std::uint32_t>(output, state);
+	}
+
+	std::uint64_t transitionCount = 0;
+	for (const auto& [from, transitions] : automaton.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			transitionCount += toStates.size();
+		}
+	}
+
+	Write<std::uint64_t>(output, transitionCount);
+	for (const auto& [from, transitions] : automaton.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				Write<std::uint32_t>(output, from);
+				Write<std::uint8_t>(output, symbol);
+				Write<std::uint32_t>(output, to);
+			}
+		}
+	}
+
+	std::uint64_t epsilonCount = 0;
+	for (const auto& [from, toStates] : automaton.GetEpsilonTransitions())
+	{
+		epsilonCount += toStates.size();
+	}
+
+	Write<std::uint64_t>(output, epsilonCount);
+	for (const auto& [from, toStates] : automaton.GetEpsilonTransitions())
+	{
+		for (const State to : toStates)
+		{
+			Write<std::uint32_t>(output, from);
+			Write<std::uint32_t>(output, to);
+		}
+	}
+}
+
+Automaton AutomatonSerializer::ReadBinary(std::istream& input)
+{
+	std::array<char, 4> magic{};
+	input.read(magic.data(), magic.size());
+	if (!input || magic != MAGIC)
+	{
+		throw std::invalid_argument("Not a binary automaton file");
+	}
+	const auto version = Read<std::uint32_t>(input);
+	if (version != FORMAT_VERSION)
+	{
+		throw std::invalid_argument("Unsupported binary automaton version");
+	}
+
+	Automaton automaton;
+
+	automaton.SetTitle(ReadString(input));
+
+	automaton.SetStartState(Read<std::uint32_t>(input));
+
+	const auto stateCount = Read<std::uint64_t>(input);
+	for (std::uint64_t i = 0; i < stateCount; ++i)
+	{
+		automaton.AddState(Read<std::uint32_t>(input));
+	}
+
+	const auto finalCount = Read<std::uint64_t>(input);
+	for (std::uint64_t i = 0; i < finalCount; ++i)
+	{
+		automaton.AddFinalState(Read<std::uint32_t>(input));
+	}
+
+	const auto transitionCount = Read<std::uint64_t>(input);
+	for (std::uint64_t i = 0; i < transitionCount; ++i)
+	{
+		const auto from = Read<std::uint32_t>(input);
+		const auto symbol = Read<std::uint8_t>(input);
+		const auto to = Read<std::uint32_t>(input);
+		automaton.AddTransition(from, symbol, to);
+	}
+
+	const auto epsilonCount = Read<std::uint64_t>(input);
+	for (std::uint64_t i = 0; i < epsilonCount; ++i)
+	{
+		const auto from = Read<std::uint32_t>(input);
+		const auto to = Read<std::uint32_t>(input);
+		automaton.AddEpsilonTransition(from, to);
+	}
+
+	return automaton;
+}
+
+void AutomatonSerializer::ToBinaryFile(const Automaton& automaton, const std::string& filename)
+{
+	std::ofstream file(filename, std::ios::binary);
+	AssertIsFileOpen(file);
+	WriteBinary(automaton, file);
+}
+
+Automaton AutomatonSerializer::FromBinaryFile(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	AssertIsFileOpen(file);
+	return ReadBinary(file);
+}
+
+bool AutomatonSerializer::IsBinaryFile(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	AssertIsFileOpen(file);
+
+	std::array<char, 4> magic{};
+	file.read(magic.data(), magic.size());
+	return file && magic == MAGIC;
+}
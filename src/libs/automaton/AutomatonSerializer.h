@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Компактный двоичный формат автомата: быстрее разбора .dot на больших входах
+class AutomatonSerializer
+{
+public:
+	static void ToBinaryFile(const Automaton& automaton, const std::string& filename);
+	static Automaton FromBinaryFile(const std::string& filename);
+
+	static void WriteBinary(const Automaton& automaton, std::ostream& output);
+	static Automaton ReadBinary(std::istream& input);
+
+	// Определяет формат по сигнатуре в начале файла
+	static bool IsBinaryFile(const std::string& filename);
+};
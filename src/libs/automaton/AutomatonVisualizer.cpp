@@ -1,4 +1,5 @@
 #include "AutomatonVisualizer.h"
+#include "SymbolFormat.h"
 
 #include <fstream>
 #include <iomanip>
@@ -66,7 +67,7 @@ void AutomatonVisualizer::Display(const Automaton& automaton)
 	std::cout << "Alphabet (Σ):     " << "{ ";
 	for (const Symbol symbol : automaton.GetAlphabet())
 	{
-		std::cout << symbol << " ";
+		std::cout << SymbolFormat::ToLabel(symbol) << " ";
 	}
 	std::cout << "}" << std::endl;
 
@@ -80,33 +81,34 @@ void AutomatonVisualizer::Display(const Automaton& automaton)
 	std::cout << "}" << std::endl;
 
 	std::cout << "Transitions (δ):  " << "{" << std::endl;
-	if (automaton.GetTransitions().empty())
+	if (automaton.GetTransitions().empty() && automaton.GetEpsilonTransitions().empty())
 	{
 		std::cout << "(No transitions defined)" << std::endl;
 	}
 	else
 	{
+		auto printTargets = [](const std::set<State>& toStates) {
+			std::cout << ") -> { ";
+			for (const State toState : toStates)
+			{
+				std::cout << toState << " ";
+			}
+			std::cout << "}" << std::endl;
+		};
+
 		for (const auto& fromPair : automaton.GetTransitions())
 		{
 			for (const auto& onPair : fromPair.second)
 			{
-				std::cout << "	δ(" << fromPair.first << ", ";
-				if (onPair.first == EPSILON)
-				{
-					std::cout << "ε";
-				}
-				else
-				{
-					std::cout << onPair.first;
-				}
-				std::cout << ") -> { ";
-				for (const State toState : onPair.second)
-				{
-					std::cout << toState << " ";
-				}
-				std::cout << "}" << std::endl;
+				std::cout << "	δ(" << fromPair.first << ", " << SymbolFormat::ToLabel(onPair.first);
+				printTargets(onPair.second);
 			}
 		}
+		for (const auto& fromPair : automaton.GetEpsilonTransitions())
+		{
+			std::cout << "	δ(" << fromPair.first << ", " << SymbolFormat::EPSILON_LABEL;
+			printTargets(fromPair.second);
+		}
 	}
 	std::cout << "}" << std::endl;
 }
@@ -115,8 +117,12 @@ void AutomatonVisualizer::ExportToDot(const Automaton& automaton, const std::str
 {
 	std::ofstream file(filename);
 	AssertIsFileOpen(file);
+	ExportToDot(automaton, file, filename);
+}
 
-	file << "digraph " << (automaton.GetTitle().empty() ? filename : automaton.GetTitle()) << std::endl;
+void AutomatonVisualizer::ExportToDot(const Automaton& automaton, std::ostream& file, const std::string& defaultTitle)
+{
+	file << "digraph " << (automaton.GetTitle().empty() ? defaultTitle : automaton.GetTitle()) << std::endl;
 	file << " {" << std::endl;
 
 	file << "    start = " << automaton.GetStartState() << ";" << std::endl;
@@ -133,44 +139,44 @@ void AutomatonVisualizer::ExportToDot(const Automaton& automaton, const std::str
 	file << finalStatesStr << ";" << std::endl
 		 << std::endl;
 
-	std::map<std::pair<State, State>, std::vector<Symbol>> transitionsByPair;
+	// Для каждой пары состояний: символы переходов и наличие e-перехода
+	std::map<std::pair<State, State>, std::pair<std::vector<Symbol>, bool>> transitionsByPair;
 	for (const auto& fromPair : automaton.GetTransitions())
 	{
 		for (const auto& onPair : fromPair.second)
 		{
 			for (const State toState : onPair.second)
 			{
-				transitionsByPair[{fromPair.first, toState}].emplace_back(onPair.first);
+				transitionsByPair[{fromPair.first, toState}].first.emplace_back(onPair.first);
 			}
 		}
 	}
+	for (const auto& fromPair : automaton.GetEpsilonTransitions())
+	{
+		for (const State toState : fromPair.second)
+		{
+			transitionsByPair[{fromPair.first, toState}].second = true;
+		}
+	}
 
 	for (const auto& pair : transitionsByPair)
 	{
 		const State from = pair.first.first;
 		const State to = pair.first.second;
-		const auto& symbols = pair.second;
+		const auto& symbols = pair.second.first;
+		const bool hasEpsilonTransition = pair.second.second;
 
 		std::string labelStr;
-		bool hasEpsilonTransition = false;
-
 		for (const Symbol symbol : symbols)
 		{
-			if (symbol == EPSILON)
-			{
-				hasEpsilonTransition = true;
-			}
-			else
-			{
-				labelStr += std::string(1, symbol) + ", ";
-			}
+			labelStr += SymbolFormat::ToLabel(symbol) + ", ";
 		}
 
 		if (hasEpsilonTransition && !labelStr.empty())
 		{
 			std::string warningLabels = labelStr;
 			warningLabels.resize(warningLabels.length() - 2);
-			std::cerr << "[Info - " << filename << "]" << std::endl;
+			std::cerr << "[Info - " << defaultTitle << "]" << std::endl;
 			std::cerr << "Transition " << from << " -> " << to << std::endl;
 			std::cerr << "has both ε and symbols {" << warningLabels << "}" << std::endl;
 		}
@@ -239,7 +245,7 @@ void AutomatonVisualizer::PrintMinimizationTable(
 	// Печать строк с данными
 	for (int i = 0; i < alphabet.size(); ++i)
 	{
-		std::cout << "| " << std::left << std::setw(ALPHABET_COL_WIDTH - 2) << alphabet[i] << "|";
+		std::cout << "| " << std::left << std::setw(ALPHABET_COL_WIDTH - 2) << SymbolFormat::ToLabel(alphabet[i]) << "|";
 		for (const auto& partition : partitions)
 		{
 			for (const State state : partition)
@@ -285,7 +291,7 @@ void AutomatonVisualizer::PrintDeterminizationTable(
 
 	for (Symbol s : alphabet)
 	{
-		columnWidths[s] = std::string(1, s).length();
+		columnWidths[s] = SymbolFormat::ToLabel(s).length();
 	}
 
 	for (const auto& row : dfaTransitions)
@@ -322,7 +328,7 @@ void AutomatonVisualizer::PrintDeterminizationTable(
 	std::cout << "|" << std::left << std::setw(firstColWidth - 1) << " State / Alph" << "|";
 	for (Symbol s : alphabet)
 	{
-		std::cout << std::left << std::setw(columnWidths.at(s) - 1) << (" " + std::string(1, s)) << "|";
+		std::cout << std::left << std::setw(columnWidths.at(s) - 1) << (" " + SymbolFormat::ToLabel(s)) << "|";
 	}
 	std::cout << "\n";
 	printLine();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Automaton.h"
+#include <ostream>
 #include <string>
 
 class AutomatonVisualizer
@@ -13,6 +14,7 @@ public:
 	static void TestStrings(const Automaton& automaton, const std::vector<std::string>& words, bool logSteps);
     static void Display(const Automaton& automaton);
     static void ExportToDot(const Automaton& automaton, const std::string& filename);
+	static void ExportToDot(const Automaton& automaton, std::ostream& output, const std::string& defaultTitle);
 	static void PrintMinimizationTable(
 		const std::vector<Symbol>& alphabet,
 		const std::vector<std::set<State>>& partitions,
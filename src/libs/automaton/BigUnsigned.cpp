@@ -0,0 +1,120 @@
+#include "BigUnsigned.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr std::uint64_t LIMB_BITS = 32;
+constexpr std::uint32_t DECIMAL_BASE = 1000000000;
+constexpr int DECIMAL_DIGITS = 9;
+} // namespace
+
+BigUnsigned::BigUnsigned(std::uint64_t value)
+{
+	while (value != 0)
+	{
+		m_limbs.push_back(static_cast<std::uint32_t>(value));
+		value >>= LIMB_BITS;
+	}
+}
+
+BigUnsigned& BigUnsigned::operator+=(const BigUnsigned& other)
+{
+	if (m_limbs.size() < other.m_limbs.size())
+	{
+		m_limbs.resize(other.m_limbs.size(), 0);
+	}
+
+	std::uint64_t carry = 0;
+	for (std::size_t i = 0; i < m_limbs.size() && (carry != 0 || i < other.m_limbs.size()); ++i)
+	{
+		carry += m_limbs[i];
+		if (i < other.m_limbs.size())
+		{
+			carry += other.m_limbs[i];
+		}
+		m_limbs[i] = static_cast<std::uint32_t>(carry);
+		carry >>= LIMB_BITS;
+	}
+	if (carry != 0)
+	{
+		m_limbs.push_back(static_cast<std::uint32_t>(carry));
+	}
+	return *this;
+}
+
+BigUnsigned& BigUnsigned::operator*=(std::uint32_t factor)
+{
+	std::uint64_t carry = 0;
+	for (auto& limb : m_limbs)
+	{
+		carry += static_cast<std::uint64_t>(limb) * factor;
+		limb = static_cast<std::uint32_t>(carry);
+		carry >>= LIMB_BITS;
+	}
+	if (carry != 0)
+	{
+		m_limbs.push_back(static_cast<std::uint32_t>(carry));
+	}
+	Normalize();
+	return *this;
+}
+
+bool BigUnsigned::IsZero() const
+{
+	return m_limbs.empty();
+}
+
+std::uint64_t BigUnsigned::ToUInt64() const
+{
+	std::uint64_t value = 0;
+	for (std::size_t i = std::min<std::size_t>(m_limbs.size(), 2); i > 0; --i)
+	{
+		value = (value << LIMB_BITS) | m_limbs[i - 1];
+	}
+	return value;
+}
+
+// Деление на 10^9 с остатком дает по девять десятичных цифр за проход
+std::string BigUnsigned::ToString() const
+{
+	if (IsZero())
+	{
+		return "0";
+	}
+
+	std::vector<std::uint32_t> limbs = m_limbs;
+	std::vector<std::uint32_t> chunks;
+	while (!limbs.empty())
+	{
+		std::uint64_t remainder = 0;
+		for (std::size_t i = limbs.size(); i > 0; --i)
+		{
+			const std::uint64_t current = (remainder << LIMB_BITS) | limbs[i - 1];
+			limbs[i - 1] = static_cast<std::uint32_t>(current / DECIMAL_BASE);
+			remainder = current % DECIMAL_BASE;
+		}
+		chunks.push_back(static_cast<std::uint32_t>(remainder));
+		while (!limbs.empty() && limbs.back() == 0)
+		{
+			limbs.pop_back();
+		}
+	}
+
+	std::string result = std::to_string(chunks.back());
+	for (std::size_t i = chunks.size() - 1; i > 0; --i)
+	{
+		const std::string chunk = std::to_string(chunks[i - 1]);
+		result.append(DECIMAL_DIGITS - chunk.size(), '0');
+		result += chunk;
+	}
+	return result;
+}
+
+void BigUnsigned::Normalize()
+{
+	while (!m_limbs.empty() && m_limbs.back() == 0)
+	{
+		m_limbs.pop_back();
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Неотрицательное целое произвольной длины для точного подсчета слов.
+// Поддерживает только операции, нужные динамике: сложение и умножение на машинное слово
+class BigUnsigned
+{
+public:
+	BigUnsigned(std::uint64_t value = 0);
+
+	BigUnsigned& operator+=(const BigUnsigned& other);
+	BigUnsigned& operator*=(std::uint32_t factor);
+
+	bool IsZero() const;
+	// Младшие 64 бита
+	std::uint64_t ToUInt64() const;
+	std::string ToString() const;
+
+	bool operator==(const BigUnsigned& other) const = default;
+
+private:
+	void Normalize();
+
+	// Разряды по основанию 2^32, младшие первыми, без ведущих нулей
+	std::vector<std::uint32_t> m_limbs;
+};
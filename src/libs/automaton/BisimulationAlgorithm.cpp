@@ -0,0 +1,188 @@
+#include "BisimulationAlgorithm.h"
+
+#include <algorithm>
+#include <map>
+
+namespace
+{
+const std::string REDUCED_SUFFIX = "Reduced";
+// Метка e-перехода в сигнатуре, за пределами байтовых символов
+constexpr std::size_t EPSILON_LABEL = 256;
+
+struct Edge
+{
+	std::size_t label;
+	std::size_t to;
+};
+
+// Ребра в плотной нумерации; для обратной бисимуляции - развернутые
+std::vector<std::vector<Edge>> BuildEdges(const Automaton& nfa, const std::vector<State>& states, bool reversed)
+{
+	auto indexOf = [&](State state) {
+		return static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	std::vector<std::vector<Edge>> edges(states.size());
+	auto addEdge = [&](State from, std::size_t label, State to) {
+		reversed ? edges[indexOf(to)].push_back({label, indexOf(from)}) : edges[indexOf(from)].push_back({label, indexOf(to)});
+	};
+
+	for (const auto& [from, transitions] : nfa.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				addEdge(from, symbol, to);
+			}
+		}
+	}
+	for (const auto& [from, toStates] : nfa.GetEpsilonTransitions())
+	{
+		for (const State to : toStates)
+		{
+			addEdge(from, EPSILON_LABEL, to);
+		}
+	}
+
+	return edges;
+}
+
+std::vector<std::size_t> InitialClasses(const Automaton& nfa, const std::vector<State>& states, BisimulationDirection direction)
+{
+	std::vector<std::size_t> classes(states.size());
+	for (std::size_t i = 0; i < states.size(); ++i)
+	{
+		classes[i] = direction == BisimulationDirection::FORWARD
+			? nfa.GetFinalStates().contains(states[i])
+			: states[i] == nfa.GetStartState();
+	}
+	return classes;
+}
+
+// Один проход: сигнатура - прежний класс и множество пар (метка, класс соседа)
+std::size_t Refine(const std::vector<std::vector<Edge>>& edges, std::vector<std::size_t>& classes)
+{
+	std::map<std::vector<std::size_t>, std::size_t> signatureToClass;
+	std::vector<std::size_t> refined(classes.size());
+	std::vector<std::size_t> signature;
+
+	for (std::size_t state = 0; state < classes.size(); ++state)
+	{
+		std::vector<std::pair<std::size_t, std::size_t>> pairs;
+		pairs.reserve(edges[state].size());
+		for (const auto& edge : edges[state])
+		{
+			pairs.emplace_back(edge.label, classes[edge.to]);
+		}
+		std::sort(pairs.begin(), pairs.end());
+		pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+		signature.assign(1, classes[state]);
+		for (const auto& [label, target] : pairs)
+		{
+			signature.push_back(label);
+			signature.push_back(target);
+		}
+
+		const auto [it, inserted] = signatureToClass.try_emplace(signature, signatureToClass.size());
+		refined[state] = it->second;
+	}
+
+	classes = std::move(refined);
+	return signatureToClass.size();
+}
+
+Automaton BuildQuotient(const Automaton& nfa, const std::vector<State>& states, const std::vector<std::size_t>& classes)
+{
+	auto classOf = [&](State state) {
+		return static_cast<State>(classes[std::lower_bound(states.begin(), states.end(), state) - states.begin()]);
+	};
+
+	Automaton quotient;
+	quotient.SetTitle(nfa.GetTitle() + REDUCED_SUFFIX);
+	quotient.SetStartState(classOf(nfa.GetStartState()));
+	for (const State state : states)
+	{
+		quotient.AddState(classOf(state));
+	}
+	for (const State state : nfa.GetFinalStates())
+	{
+		quotient.AddFinalState(classOf(state));
+	}
+	for (const auto& [from, transitions] : nfa.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				quotient.AddTransition(classOf(from), symbol, classOf(to));
+			}
+		}
+	}
+	for (const auto& [from, toStates] : nfa.GetEpsilonTransitions())
+	{
+		for (const State to : toStates)
+		{
+			// Петля по e в фактор-автомате языка не меняет
+			if (classOf(from) != classOf(to))
+			{
+				quotient.AddEpsilonTransition(classOf(from), classOf(to));
+			}
+		}
+	}
+
+	return quotient;
+}
+} // namespace
+
+std::vector<std::size_t> BisimulationAlgorithm::FindClasses(const Automaton& nfa, BisimulationDirection direction)
+{
+	const std::vector<State> states(nfa.GetStates().begin(), nfa.GetStates().end());
+	const auto edges = BuildEdges(nfa, states, direction == BisimulationDirection::BACKWARD);
+	auto classes = InitialClasses(nfa, states, direction);
+
+	std::size_t classCount = 0;
+	while (true)
+	{
+		const std::size_t refinedCount = Refine(edges, classes);
+		if (refinedCount == classCount)
+		{
+			break;
+		}
+		classCount = refinedCount;
+	}
+
+	return classes;
+}
+
+Automaton BisimulationAlgorithm::Reduce(const Automaton& nfa, BisimulationDirection direction)
+{
+	if (nfa.GetStates().empty())
+	{
+		return nfa;
+	}
+
+	const std::vector<State> states(nfa.GetStates().begin(), nfa.GetStates().end());
+	return BuildQuotient(nfa, states, FindClasses(nfa, direction));
+}
+
+Automaton BisimulationAlgorithm::Reduce(const Automaton& nfa)
+{
+	Automaton reduced = Reduce(nfa, BisimulationDirection::FORWARD);
+	auto direction = BisimulationDirection::BACKWARD;
+
+	// Останавливаемся, когда ни одно из направлений больше не сливает состояния
+	for (int idleRounds = 0; idleRounds < 2;)
+	{
+		auto next = Reduce(reduced, direction);
+		idleRounds = next.GetStates().size() < reduced.GetStates().size() ? 0 : idleRounds + 1;
+		reduced = std::move(next);
+		direction = direction == BisimulationDirection::FORWARD
+			? BisimulationDirection::BACKWARD
+			: BisimulationDirection::FORWARD;
+	}
+
+	reduced.SetTitle(nfa.GetTitle() + REDUCED_SUFFIX);
+	return reduced;
+}
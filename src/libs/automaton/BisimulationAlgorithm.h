@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <vector>
+
+enum class BisimulationDirection
+{
+	// Одинаковые продолжения: совпадают конечность и классы преемников по каждому символу
+	FORWARD,
+	// Одинаковые префиксы: совпадают стартовость и классы предшественников по каждому символу
+	BACKWARD
+};
+
+// Сокращение НКА без детерминизации: слияние состояний, эквивалентных по бисимуляции.
+// Классы находятся уточнением разбиения по сигнатурам, e-переходы считаются отдельной меткой
+class BisimulationAlgorithm
+{
+public:
+	static Automaton Reduce(const Automaton& nfa, BisimulationDirection direction);
+	// Прямая и обратная бисимуляция по очереди, пока число состояний уменьшается
+	static Automaton Reduce(const Automaton& nfa);
+
+	// Номер класса для каждого состояния в порядке GetStates()
+	static std::vector<std::size_t> FindClasses(const Automaton& nfa, BisimulationDirection direction);
+};
@@ -0,0 +1,97 @@
+#include "CompiledDfa.h"
+
+#include "TrimAlgorithm.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+void AssertIsDeterministic(const Automaton& automaton)
+{
+	if (!automaton.IsDeterministic())
+	{
+		throw std::logic_error("Only a DFA can be compiled into a table");
+	}
+}
+} // namespace
+
+CompiledDfa::CompiledDfa(const Automaton& dfa)
+{
+	AssertIsDeterministic(dfa);
+	if (dfa.GetStates().empty())
+	{
+		return;
+	}
+
+	const std::vector<State> states(dfa.GetStates().begin(), dfa.GetStates().end());
+	auto indexOf = [&](State state) {
+		return static_cast<State>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	m_table.assign(states.size() * SYMBOL_COUNT, DEAD_STATE);
+	m_final.assign(states.size(), false);
+	m_dead.assign(states.size(), true);
+	m_startState = indexOf(dfa.GetStartState());
+
+	for (const auto& [from, transitions] : dfa.GetTransitions())
+	{
+		const std::size_t row = indexOf(from) * SYMBOL_COUNT;
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			m_table[row + symbol] = indexOf(*toStates.begin());
+		}
+	}
+	for (const State state : dfa.GetFinalStates())
+	{
+		m_final[indexOf(state)] = true;
+	}
+	for (const State state : TrimAlgorithm::FindCoReachableStates(dfa))
+	{
+		m_dead[indexOf(state)] = false;
+	}
+}
+
+State CompiledDfa::GetStartState() const
+{
+	return m_startState;
+}
+
+std::size_t CompiledDfa::GetStateCount() const
+{
+	return m_final.size();
+}
+
+std::size_t CompiledDfa::GetDeadStateCount() const
+{
+	return static_cast<std::size_t>(std::count(m_dead.begin(), m_dead.end(), true));
+}
+
+State CompiledDfa::Step(State state, Symbol symbol) const
+{
+	return state == DEAD_STATE ? DEAD_STATE : m_table[state * SYMBOL_COUNT + symbol];
+}
+
+bool CompiledDfa::IsFinal(State state) const
+{
+	return state != DEAD_STATE && m_final[state];
+}
+
+bool CompiledDfa::IsDead(State state) const
+{
+	return state == DEAD_STATE || m_dead[state];
+}
+
+bool CompiledDfa::Recognize(std::string_view word) const
+{
+	State state = m_startState;
+	for (const char symbol : word)
+	{
+		if (IsDead(state))
+		{
+			return false;
+		}
+		state = m_table[state * SYMBOL_COUNT + static_cast<Symbol>(symbol)];
+	}
+	return IsFinal(state);
+}
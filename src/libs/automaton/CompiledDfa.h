@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <string_view>
+#include <vector>
+
+// Плотная таблица переходов ДКА: состояния перенумерованы подряд, строка на 256 символов.
+// Отсутствующий переход и состояния, из которых не достичь конечного, помечены как мертвые,
+// поэтому распознавание прекращается на первом таком состоянии
+class CompiledDfa
+{
+public:
+	static constexpr State DEAD_STATE = static_cast<State>(-1);
+	static constexpr std::size_t SYMBOL_COUNT = 256;
+
+	explicit CompiledDfa(const Automaton& dfa);
+
+	State GetStartState() const;
+	std::size_t GetStateCount() const;
+	std::size_t GetDeadStateCount() const;
+
+	State Step(State state, Symbol symbol) const;
+	bool IsFinal(State state) const;
+	bool IsDead(State state) const;
+
+	bool Recognize(std::string_view word) const;
+
+private:
+	std::vector<State> m_table;
+	std::vector<char> m_final;
+	std::vector<char> m_dead;
+	State m_startState = DEAD_STATE;
+};
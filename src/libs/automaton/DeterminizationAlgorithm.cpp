@@ -1,45 +1,198 @@
 #include "DeterminizationAlgorithm.h"
+#include "AutomatonArena.h"
 #include "AutomatonVisualizer.h"
+#include "EpsilonEliminationAlgorithm.h"
+#include "TrimAlgorithm.h"
 
+#include <algorithm>
 #include <iostream>
+#include <optional>
 #include <queue>
+#include <stack>
 
 namespace
 {
 const std::string DETERMINIZED_SUFFIX = "Determinized";
-} // namespace
+// Примерный размер узла красно-черного дерева без хранимого значения
+constexpr std::size_t TREE_NODE_OVERHEAD = 32;
+
+std::size_t EstimateSubsetBytes(const std::set<State>& subset)
+{
+	return subset.size() * (sizeof(State) + TREE_NODE_OVERHEAD) + sizeof(subset);
+}
+
+// Значение тега в конфигурации: регистр исходного состояния ДКА или свежая позиция текущего шага
+using TagValue = std::size_t;
+constexpr TagValue UNSET_VALUE = std::numeric_limits<TagValue>::max();
+constexpr TagValue FRESH_VALUE = TagValue{1} << 32;
+
+struct TaggedConfiguration
+{
+	State state;
+	std::vector<TagValue> values;
+};
+
+using TaggedConfigurations = std::vector<TaggedConfiguration>;
+
+// Обход в глубину в порядке приоритета переходов: первое посещение состояния побеждает (leftmost-greedy).
+// Остаются только конфигурации, которые могут читать символ или принять слово
+TaggedConfigurations TaggedClosure(const TaggedNfa& nfa, TaggedConfigurations&& seeds)
+{
+	TaggedConfigurations result;
+	std::vector<char> visited(nfa.GetStateCount(), false);
+	std::stack<TaggedConfiguration> stack;
+
+	for (auto& seed : seeds)
+	{
+		stack.push(std::move(seed));
+		while (!stack.empty())
+		{
+			auto configuration = std::move(stack.top());
+			stack.pop();
+			if (visited[configuration.state])
+			{
+				continue;
+			}
+			visited[configuration.state] = true;
+
+			const auto& epsilonTransitions = nfa.GetEpsilonTransitions(configuration.state);
+			for (auto it = epsilonTransitions.rbegin(); it != epsilonTransitions.rend(); ++it)
+			{
+				if (visited[it->first])
+				{
+					continue;
+				}
+				TaggedConfiguration next{it->first, configuration.values};
+				if (it->second != NO_TAG)
+				{
+					next.values[it->second] = FRESH_VALUE + it->second;
+				}
+				stack.push(std::move(next));
+			}
+
+			if (!nfa.GetTransitions(configuration.state).empty() || nfa.IsFinal(configuration.state))
+			{
+				result.push_back(std::move(configuration));
+			}
+		}
+	}
+
+	return result;
+}
+
+// Перенумерация значений в регистры 0, 1, ... по первому появлению.
+// Возвращает операции, переводящие значения в новые регистры (тождественные копии опускаются)
+std::vector<RegisterOperation> CanonicalizeRegisters(TaggedConfigurations& configurations)
+{
+	std::map<TagValue, Register> renaming;
+	std::vector<RegisterOperation> operations;
+	for (auto& configuration : configurations)
+	{
+		for (auto& value : configuration.values)
+		{
+			if (value == UNSET_VALUE)
+			{
+				continue;
+			}
+			const auto [it, inserted] = renaming.try_emplace(value, static_cast<Register>(renaming.size()));
+			if (inserted && value != it->second)
+			{
+				const Register source = value >= FRESH_VALUE
+					? RegisterOperation::POSITION
+					: static_cast<Register>(value);
+				operations.push_back({it->second, source});
+			}
+			value = it->second;
+		}
+	}
+	return operations;
+}
 
-Automaton DeterminizationAlgorithm::Determine(const Automaton& nfa, bool logSteps)
+std::vector<TagValue> MakeTaggedKey(const TaggedConfigurations& configurations)
 {
-	Automaton dfa;
+	std::vector<TagValue> key;
+	for (const auto& configuration : configurations)
+	{
+		key.push_back(configuration.state);
+		key.insert(key.end(), configuration.values.begin(), configuration.values.end());
+	}
+	return key;
+}
+// Построение подмножеств для подрезанного НКА. Реестр подмножеств освобождается при выходе,
+// до того как из накопленных переходов строятся деревья ДКА
+void DetermineInto(const Automaton& nfa, bool logSteps, DeterminizationStats* stats, AutomatonArena& dfa)
+{
+	std::size_t registryBytes = 0;
+	std::size_t frontierBytes = 0;
+	auto trackPeakBytes = [&]() {
+		if (stats)
+		{
+			stats->peakBytes = std::max(stats->peakBytes, registryBytes + frontierBytes);
+		}
+	};
+
 	dfa.SetTitle(nfa.GetTitle() + DETERMINIZED_SUFFIX);
 	if (nfa.GetStates().empty())
 	{
-		return dfa;
+		return;
 	}
 
 	std::map<std::set<State>, State> dfaStateRegister;
 	std::queue<std::set<State>> unprocessedStates;
 	AutomatonVisualizer::DfaTransitionTable dfaTransitionsForPrint;
 
-	auto startStateKey = EpsilonClosure(nfa, nfa.GetStartState());
+	// Замыкания считаются один раз для всех состояний, а не обходом в ширину на каждом шаге
+	std::optional<EpsilonClosureTable> closureTable;
+	if (nfa.HasEpsilonTransitions())
+	{
+		PhaseTimer timer(stats ? &stats->closureTime : nullptr);
+		closureTable.emplace(nfa);
+	}
+
+	auto closure = [&](std::set<State>&& states) {
+		PhaseTimer timer(stats ? &stats->closureTime : nullptr);
+		if (stats) stats->closureCalls++;
+		return closureTable ? closureTable->Close(states) : std::move(states);
+	};
+	auto move = [&](const std::set<State>& states, Symbol symbol) {
+		PhaseTimer timer(stats ? &stats->moveTime : nullptr);
+		if (stats) stats->moveCalls++;
+		return DeterminizationAlgorithm::Move(nfa, states, symbol);
+	};
+
+	auto startStateKey = closure({nfa.GetStartState()});
 
 	State nextDfaStateId = 0;
 	dfaStateRegister[startStateKey] = nextDfaStateId;
 	unprocessedStates.push(startStateKey);
 	dfa.SetStartState(nextDfaStateId);
+	if (stats)
+	{
+		stats->registryMisses++;
+		stats->peakFrontierSize = std::max<std::size_t>(stats->peakFrontierSize, 1);
+		registryBytes += EstimateSubsetBytes(startStateKey) + TREE_NODE_OVERHEAD;
+		frontierBytes += EstimateSubsetBytes(startStateKey);
+		trackPeakBytes();
+	}
 
 	while (!unprocessedStates.empty())
 	{
 		auto currentStateKey = unprocessedStates.front();
 		unprocessedStates.pop();
 		const auto dfaState = dfaStateRegister.at(currentStateKey);
+		if (stats)
+		{
+			frontierBytes -= EstimateSubsetBytes(currentStateKey);
+		}
 
 		// Обходим алфавит и ищем новые объединенные состояния
 		for (const Symbol symbol : nfa.GetAlphabet())
 		{
-			auto nextStateKey = EpsilonClosure(nfa, Move(nfa, currentStateKey, symbol));
-			dfaTransitionsForPrint[currentStateKey][symbol] = nextStateKey;
+			auto nextStateKey = closure(move(currentStateKey, symbol));
+			if (logSteps)
+			{
+				dfaTransitionsForPrint[currentStateKey][symbol] = nextStateKey;
+			}
 
 			if (nextStateKey.empty())
 			{
@@ -47,16 +200,33 @@ Automaton DeterminizationAlgorithm::Determine(const Automaton& nfa, bool logStep
 			}
 
 			// Если нашли, то проверим, вдруг уже такое состояние есть
-			if (!dfaStateRegister.contains(nextStateKey))
+			std::map<std::set<State>, State>::iterator it;
+			bool inserted = false;
 			{
-				nextDfaStateId++;
-				dfaStateRegister[nextStateKey] = nextDfaStateId;
-				unprocessedStates.push(nextStateKey);
+				PhaseTimer registryTimer(stats ? &stats->registryTime : nullptr);
+				std::tie(it, inserted) = dfaStateRegister.try_emplace(nextStateKey, nextDfaStateId + 1);
+				if (inserted)
+				{
+					nextDfaStateId++;
+					unprocessedStates.push(nextStateKey);
+				}
+			}
+
+			if (stats)
+			{
+				(inserted ? stats->registryMisses : stats->registryHits)++;
+				if (inserted)
+				{
+					registryBytes += EstimateSubsetBytes(nextStateKey) + TREE_NODE_OVERHEAD;
+					frontierBytes += EstimateSubsetBytes(nextStateKey);
+					stats->peakFrontierSize = std::max(stats->peakFrontierSize, unprocessedStates.size());
+					trackPeakBytes();
+				}
 			}
 
 			// Добавляем переход в новый ДКА
-			const auto destinationDfaStateId = dfaStateRegister.at(nextStateKey);
-			dfa.AddTransition(dfaState, symbol, destinationDfaStateId);
+			dfa.AddTransition(dfaState, symbol, it->second);
+			if (stats) stats->dfaTransitions++;
 		}
 	}
 
@@ -72,6 +242,7 @@ Automaton DeterminizationAlgorithm::Determine(const Automaton& nfa, bool logStep
 	}
 
 	// Определение конечных состояний
+	PhaseTimer finalStatesTimer(stats ? &stats->finalStatesTime : nullptr);
 	const auto& nfaFinalStates = nfa.GetFinalStates();
 	for (const auto& pair : dfaStateRegister)
 	{
@@ -88,7 +259,48 @@ Automaton DeterminizationAlgorithm::Determine(const Automaton& nfa, bool logStep
 		}
 	}
 
-	return dfa;
+	if (stats)
+	{
+		stats->dfaStates = dfaStateRegister.size();
+	}
+}
+} // namespace
+
+Automaton DeterminizationAlgorithm::Determine(const Automaton& nfa, bool logSteps, DeterminizationStats* stats)
+{
+	// Бесполезные состояния НКА только раздувают подмножества и порождают мертвые состояния ДКА.
+	// Полезные состояния ищутся один раз и для проверки, и для подрезки
+	const auto useful = TrimAlgorithm::FindUsefulStates(nfa);
+	std::optional<Automaton> trimmed;
+	if (!TrimAlgorithm::IsTrim(nfa, useful))
+	{
+		trimmed = TrimAlgorithm::Trim(nfa, useful);
+	}
+
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AutomatonArena dfa;
+	DetermineInto(trimmed ? *trimmed : nfa, logSteps, stats, dfa);
+	return dfa.Freeze();
+}
+
+// Бесполезные состояния удаляются прямо во входе, без второй копии НКА, а сам вход
+// очищается до построения деревьев ДКА
+Automaton DeterminizationAlgorithm::Determine(Automaton&& nfa, bool logSteps, DeterminizationStats* stats)
+{
+	Automaton input = std::move(nfa);
+	nfa.Clear();
+	TrimAlgorithm::TrimInPlace(input, TrimAlgorithm::FindUsefulStates(input));
+
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AutomatonArena dfa;
+	DetermineInto(input, logSteps, stats, dfa);
+	input.Clear();
+	return dfa.Freeze();
+}
+
+void DeterminizationAlgorithm::DetermineInPlace(Automaton& automaton, bool logSteps, DeterminizationStats* stats)
+{
+	automaton = Determine(std::move(automaton), logSteps, stats);
 }
 
 std::set<State> DeterminizationAlgorithm::EpsilonClosure(const Automaton& nfa, State state)
@@ -99,18 +311,18 @@ std::set<State> DeterminizationAlgorithm::EpsilonClosure(const Automaton& nfa, S
 	closure.insert(state);
 	queue.push(state);
 
-	const auto& transitions = nfa.GetTransitions();
+	const auto& epsilonTransitions = nfa.GetEpsilonTransitions();
 	while (!queue.empty())
 	{
 		State currentState = queue.front();
 		queue.pop();
 
-		if (!transitions.contains(currentState) || !transitions.at(currentState).contains(EPSILON))
+		if (!epsilonTransitions.contains(currentState))
 		{
 			continue;
 		}
 
-		for (const State targetState : transitions.at(currentState).at(EPSILON))
+		for (const State targetState : epsilonTransitions.at(currentState))
 		{
 			if (!closure.contains(targetState))
 			{
@@ -150,4 +362,71 @@ std::set<State> DeterminizationAlgorithm::Move(const Automaton& nfa, const std::
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+
+TaggedDfa DeterminizationAlgorithm::Determine(const TaggedNfa& nfa)
+{
+	const std::size_t tagCount = nfa.GetTagCount();
+	TaggedDfa dfa(tagCount);
+	if (nfa.GetStateCount() == 0)
+	{
+		return dfa;
+	}
+
+	std::map<std::vector<TagValue>, State> dfaStateRegister;
+	std::vector<TaggedConfigurations> dfaStates;
+	auto registerState = [&](TaggedConfigurations&& configurations) {
+		auto [it, inserted] = dfaStateRegister.try_emplace(MakeTaggedKey(configurations), 0);
+		if (inserted)
+		{
+			it->second = dfa.AddState();
+			for (const auto& configuration : configurations)
+			{
+				if (nfa.IsFinal(configuration.state))
+				{
+					std::vector<Register> tagRegisters(tagCount, NO_REGISTER);
+					for (std::size_t tag = 0; tag < tagCount; ++tag)
+					{
+						if (configuration.values[tag] != UNSET_VALUE)
+						{
+							tagRegisters[tag] = static_cast<Register>(configuration.values[tag]);
+						}
+					}
+					dfa.SetFinal(it->second, std::move(tagRegisters));
+					break;
+				}
+			}
+			dfaStates.push_back(std::move(configurations));
+		}
+		return it->second;
+	};
+
+	TaggedConfigurations start;
+	start.push_back({nfa.GetStartState(), std::vector<TagValue>(tagCount, UNSET_VALUE)});
+	start = TaggedClosure(nfa, std::move(start));
+	dfa.SetStartOperations(CanonicalizeRegisters(start));
+	registerState(std::move(start));
+
+	// dfaStates растет по ходу обхода, поэтому обращаемся по индексу
+	for (State dfaState = 0; dfaState < dfaStates.size(); ++dfaState)
+	{
+		std::map<Symbol, TaggedConfigurations> moves;
+		for (const auto& configuration : dfaStates[dfaState])
+		{
+			for (const auto& [symbol, target] : nfa.GetTransitions(configuration.state))
+			{
+				moves[symbol].push_back({target, configuration.values});
+			}
+		}
+
+		for (auto& [symbol, seeds] : moves)
+		{
+			auto next = TaggedClosure(nfa, std::move(seeds));
+			auto operations = CanonicalizeRegisters(next);
+			const State target = registerState(std::move(next));
+			dfa.SetTransition(dfaState, symbol, target, std::move(operations));
+		}
+	}
+
+	return dfa;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "AlgorithmStats.h"
 #include "Automaton.h"
+#include "TaggedAutomaton.h"
 #include <set>
 
 class DeterminizationAlgorithm
@@ -9,7 +11,14 @@ public:
 	DeterminizationAlgorithm() = default;
 	~DeterminizationAlgorithm() = default;
 
-	static Automaton Determine(const Automaton& nfa, bool logSteps = false);
+	static Automaton Determine(const Automaton& nfa, bool logSteps = false, DeterminizationStats* stats = nullptr);
+	// Вход подрезается на месте и освобождается до сборки деревьев результата
+	static Automaton Determine(Automaton&& nfa, bool logSteps = false, DeterminizationStats* stats = nullptr);
+	// Буферы входа не переиспользуются: вход только освобождается раньше, чем при automaton = Determine(automaton)
+	static void DetermineInPlace(Automaton& automaton, bool logSteps = false, DeterminizationStats* stats = nullptr);
+	// Теговая детерминизация (Laurikari): состояние ДКА - упорядоченный список конфигураций
+	// (состояние НКА, регистры тегов), регистры канонически перенумерованы
+	static TaggedDfa Determine(const TaggedNfa& nfa);
 	static std::set<State> EpsilonClosure(const Automaton& nfa, State state);
 	static std::set<State> EpsilonClosure(const Automaton& nfa, const std::set<State>& states);
 	static std::set<State> Move(const Automaton& nfa, const std::set<State>& states, Symbol symbol);
@@ -0,0 +1,205 @@
+#include "DictionaryBuilder.h"
+#include "AutomatonArena.h"
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::size_t ROOT = 0;
+constexpr std::size_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+void AssertIsSorted(std::string_view previous, std::string_view word)
+{
+	if (word < previous)
+	{
+		throw std::invalid_argument("Words must be added in sorted order: '" + std::string(word)
+			+ "' after '" + std::string(previous) + "'");
+	}
+}
+
+std::size_t CommonPrefixLength(std::string_view left, std::string_view right)
+{
+	const auto [leftEnd, rightEnd] = std::mismatch(left.begin(), left.end(), right.begin(), right.end());
+	return static_cast<std::size_t>(leftEnd - left.begin());
+}
+} // namespace
+
+std::size_t DictionaryBuilder::NodeHash::operator()(NodeId id) const
+{
+	const Node& node = (*nodes)[id];
+	std::size_t hash = node.final;
+	for (const auto& [symbol, target] : node.edges)
+	{
+		hash = (hash ^ symbol) * HASH_MULTIPLIER;
+		hash = (hash ^ target) * HASH_MULTIPLIER;
+	}
+	return hash;
+}
+
+bool DictionaryBuilder::NodeEqual::operator()(NodeId left, NodeId right) const
+{
+	const Node& leftNode = (*nodes)[left];
+	const Node& rightNode = (*nodes)[right];
+	return leftNode.final == rightNode.final && leftNode.edges == rightNode.edges;
+}
+
+DictionaryBuilder::DictionaryBuilder()
+	: m_register(0, NodeHash{&m_nodes}, NodeEqual{&m_nodes})
+{
+	Reset();
+}
+
+void DictionaryBuilder::Add(std::string_view word)
+{
+	if (m_hasWords)
+	{
+		AssertIsSorted(m_previousWord, word);
+		if (word == m_previousWord)
+		{
+			return;
+		}
+	}
+
+	const std::size_t prefix = CommonPrefixLength(m_previousWord, word);
+	ReplaceOrRegister(prefix);
+
+	for (std::size_t i = prefix; i < word.size(); ++i)
+	{
+		const NodeId next = CreateNode();
+		m_nodes[m_path.back()].edges.emplace_back(static_cast<Symbol>(word[i]), next);
+		m_path.push_back(next);
+	}
+	m_nodes[m_path.back()].final = true;
+
+	m_previousWord.assign(word);
+	m_hasWords = true;
+}
+
+Automaton DictionaryBuilder::Build(const std::string& title)
+{
+	ReplaceOrRegister(0);
+
+	// Размер известен заранее с точностью до освобожденных узлов
+	std::size_t edgeCount = 0;
+	for (const auto& node : m_nodes)
+	{
+		edgeCount += node.edges.size();
+	}
+	AutomatonArena automaton;
+	automaton.Reserve(m_nodes.size(), edgeCount);
+	automaton.SetTitle(title);
+	automaton.SetStartState(0);
+
+	// Нумерация в порядке обхода в ширину от корня
+	std::vector<State> numbers(m_nodes.size(), 0);
+	std::vector<bool> visited(m_nodes.size(), false);
+	std::queue<NodeId> queue;
+	visited[ROOT] = true;
+	queue.push(ROOT);
+	State nextNumber = 1;
+
+	while (!queue.empty())
+	{
+		const NodeId current = queue.front();
+		queue.pop();
+		if (m_nodes[current].final)
+		{
+			automaton.AddFinalState(numbers[current]);
+		}
+
+		for (const auto& [symbol, target] : m_nodes[current].edges)
+		{
+			if (!visited[target])
+			{
+				visited[target] = true;
+				numbers[target] = nextNumber++;
+				queue.push(target);
+			}
+			automaton.AddTransition(numbers[current], symbol, numbers[target]);
+		}
+	}
+
+	Reset();
+	return automaton.Freeze();
+}
+
+std::size_t DictionaryBuilder::GetStateCount() const
+{
+	return m_nodes.size() - m_freeNodes.size();
+}
+
+Automaton DictionaryBuilder::FromSortedWords(const std::vector<std::string>& words)
+{
+	DictionaryBuilder builder;
+	for (const auto& word : words)
+	{
+		builder.Add(word);
+	}
+	return builder.Build();
+}
+
+Automaton DictionaryBuilder::FromWords(std::vector<std::string> words)
+{
+	std::sort(words.begin(), words.end());
+	return FromSortedWords(words);
+}
+
+Automaton DictionaryBuilder::FromStream(std::istream& words, bool sorted)
+{
+	std::vector<std::string> unsortedWords;
+	DictionaryBuilder builder;
+	std::string line;
+	while (std::getline(words, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		sorted ? builder.Add(line) : unsortedWords.push_back(std::move(line));
+	}
+
+	return sorted ? builder.Build() : FromWords(std::move(unsortedWords));
+}
+
+DictionaryBuilder::NodeId DictionaryBuilder::CreateNode()
+{
+	if (!m_freeNodes.empty())
+	{
+		const NodeId id = m_freeNodes.back();
+		m_freeNodes.pop_back();
+		return id;
+	}
+
+	m_nodes.emplace_back();
+	return m_nodes.size() - 1;
+}
+
+void DictionaryBuilder::Reset()
+{
+	m_register.clear();
+	m_nodes.clear();
+	m_freeNodes.clear();
+	m_path.assign(1, CreateNode());
+	m_previousWord.clear();
+	m_hasWords = false;
+}
+
+// Ветка глубже depth больше не изменится: заменяем ее состояния эквивалентными из реестра снизу вверх
+void DictionaryBuilder::ReplaceOrRegister(std::size_t depth)
+{
+	while (m_path.size() > depth + 1)
+	{
+		const NodeId child = m_path.back();
+		m_path.pop_back();
+
+		const auto [it, inserted] = m_register.insert(child);
+		if (!inserted)
+		{
+			m_nodes[m_path.back()].edges.back().second = *it;
+			m_nodes[child] = Node{};
+			m_freeNodes.push_back(child);
+		}
+	}
+}
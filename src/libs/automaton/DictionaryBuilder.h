@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Построение минимального ациклического ДКА словаря по Дацюку (Daciuk et al., 2000).
+// Слова добавляются в возрастающем порядке: после каждого слова ветка предыдущего
+// за общим префиксом уже не изменится, и ее состояния сливаются с эквивалентными из реестра.
+// В памяти живут только реестр и текущая ветка, то есть примерно итоговый автомат
+class DictionaryBuilder
+{
+public:
+	DictionaryBuilder();
+	// Реестр ссылается на вектор состояний этого объекта
+	DictionaryBuilder(const DictionaryBuilder&) = delete;
+	DictionaryBuilder& operator=(const DictionaryBuilder&) = delete;
+
+	// Слово не меньше предыдущего (побайтово), повтор игнорируется
+	void Add(std::string_view word);
+	// Возвращает автомат и очищает построитель для следующего словаря
+	Automaton Build(const std::string& title = "Dictionary");
+
+	// Число живых состояний, включая еще не зарегистрированную ветку
+	std::size_t GetStateCount() const;
+
+	static Automaton FromSortedWords(const std::vector<std::string>& words);
+	// Неотсортированный список сортируется целиком, поэтому требует памяти под сами слова
+	static Automaton FromWords(std::vector<std::string> words);
+	// Слова построчно
+	static Automaton FromStream(std::istream& words, bool sorted = true);
+
+private:
+	using NodeId = std::size_t;
+
+	struct Node
+	{
+		bool final = false;
+		// Переходы в порядке возрастания символа
+		std::vector<std::pair<Symbol, NodeId>> edges;
+	};
+
+	struct NodeHash
+	{
+		const std::vector<Node>* nodes;
+		std::size_t operator()(NodeId id) const;
+	};
+
+	struct NodeEqual
+	{
+		const std::vector<Node>* nodes;
+		bool operator()(NodeId left, NodeId right) const;
+	};
+
+	NodeId CreateNode();
+	void Reset();
+	void ReplaceOrRegister(std::size_t depth);
+
+	std::vector<Node> m_nodes;
+	std::vector<NodeId> m_freeNodes;
+	std::unordered_set<NodeId, NodeHash, NodeEqual> m_register;
+	// Состояния вдоль последнего слова, m_path[0] - корень
+	std::vector<NodeId> m_path;
+	std::string m_previousWord;
+	bool m_hasWords = false;
+};
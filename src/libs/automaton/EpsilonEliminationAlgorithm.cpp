@@ -0,0 +1,221 @@
+#include "EpsilonEliminationAlgorithm.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr std::size_t UNVISITED = std::numeric_limits<std::size_t>::max();
+const std::string EPSILON_FREE_SUFFIX = "EpsilonFree";
+
+// Граф e-переходов в плотных индексах
+std::vector<std::vector<std::size_t>> BuildEpsilonGraph(const Automaton& nfa, const std::vector<State>& states)
+{
+	auto indexOf = [&states](State state) {
+		return static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	std::vector<std::vector<std::size_t>> graph(states.size());
+	for (const auto& [from, toStates] : nfa.GetEpsilonTransitions())
+	{
+		auto& successors = graph[indexOf(from)];
+		for (const State to : toStates)
+		{
+			successors.push_back(indexOf(to));
+		}
+	}
+
+	return graph;
+}
+
+// Итеративный алгоритм Тарьяна. Компоненты нумеруются в порядке завершения,
+// то есть каждая компонента получает номер позже всех достижимых из нее
+std::vector<std::size_t> FindComponents(const std::vector<std::vector<std::size_t>>& graph, std::size_t& componentCount)
+{
+	const std::size_t n = graph.size();
+	std::vector<std::size_t> index(n, UNVISITED);
+	std::vector<std::size_t> lowLink(n, 0);
+	std::vector<std::size_t> componentOf(n, UNVISITED);
+	std::vector<std::size_t> stack;
+	std::vector<std::pair<std::size_t, std::size_t>> callStack;
+	std::size_t nextIndex = 0;
+	componentCount = 0;
+
+	for (std::size_t root = 0; root < n; ++root)
+	{
+		if (index[root] != UNVISITED)
+		{
+			continue;
+		}
+
+		callStack.emplace_back(root, 0);
+		while (!callStack.empty())
+		{
+			auto& [vertex, edge] = callStack.back();
+			if (edge == 0)
+			{
+				index[vertex] = lowLink[vertex] = nextIndex++;
+				stack.push_back(vertex);
+			}
+
+			if (edge < graph[vertex].size())
+			{
+				const std::size_t next = graph[vertex][edge++];
+				if (index[next] == UNVISITED)
+				{
+					callStack.emplace_back(next, 0);
+				}
+				else if (componentOf[next] == UNVISITED)
+				{
+					lowLink[vertex] = std::min(lowLink[vertex], index[next]);
+				}
+				continue;
+			}
+
+			const std::size_t finished = vertex;
+			callStack.pop_back();
+			if (!callStack.empty())
+			{
+				const std::size_t parent = callStack.back().first;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[finished]);
+			}
+
+			if (lowLink[finished] == index[finished])
+			{
+				std::size_t member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					componentOf[member] = componentCount;
+				} while (member != finished);
+				componentCount++;
+			}
+		}
+	}
+
+	return componentOf;
+}
+} // namespace
+
+EpsilonClosureTable::EpsilonClosureTable(const Automaton& nfa)
+	: m_states(nfa.GetStates().begin(), nfa.GetStates().end())
+{
+	const auto graph = BuildEpsilonGraph(nfa, m_states);
+	std::size_t componentCount = 0;
+	m_componentOf = FindComponents(graph, componentCount);
+
+	std::vector<std::vector<std::size_t>> members(componentCount);
+	for (std::size_t vertex = 0; vertex < m_states.size(); ++vertex)
+	{
+		members[m_componentOf[vertex]].push_back(vertex);
+	}
+
+	// Компоненты-наследники имеют меньшие номера, поэтому их замыкания уже готовы
+	m_componentClosures.resize(componentCount);
+	std::vector<std::size_t> seenInComponent(m_states.size(), UNVISITED);
+	for (std::size_t component = 0; component < componentCount; ++component)
+	{
+		auto& closure = m_componentClosures[component];
+		auto append = [&](std::size_t vertex) {
+			if (seenInComponent[vertex] != component)
+			{
+				seenInComponent[vertex] = component;
+				closure.push_back(m_states[vertex]);
+			}
+		};
+
+		for (const std::size_t vertex : members[component])
+		{
+			append(vertex);
+		}
+		for (const std::size_t vertex : members[component])
+		{
+			for (const std::size_t next : graph[vertex])
+			{
+				const std::size_t nextComponent = m_componentOf[next];
+				if (nextComponent == component)
+				{
+					continue;
+				}
+				for (const State state : m_componentClosures[nextComponent])
+				{
+					append(static_cast<std::size_t>(std::lower_bound(m_states.begin(), m_states.end(), state) - m_states.begin()));
+				}
+			}
+		}
+
+		std::sort(closure.begin(), closure.end());
+	}
+}
+
+const std::vector<State>& EpsilonClosureTable::Get(const State state) const
+{
+	static const std::vector<State> empty;
+
+	const auto it = std::lower_bound(m_states.begin(), m_states.end(), state);
+	if (it == m_states.end() || *it != state)
+	{
+		return empty;
+	}
+	return m_componentClosures[m_componentOf[it - m_states.begin()]];
+}
+
+std::set<State> EpsilonClosureTable::Close(const std::set<State>& states) const
+{
+	std::set<State> closure;
+	for (const State state : states)
+	{
+		const auto& stateClosure = Get(state);
+		closure.insert(stateClosure.begin(), stateClosure.end());
+	}
+	return closure;
+}
+
+std::size_t EpsilonClosureTable::GetComponentCount() const
+{
+	return m_componentClosures.size();
+}
+
+Automaton EpsilonEliminationAlgorithm::RemoveEpsilon(const Automaton& nfa)
+{
+	Automaton result;
+	result.SetTitle(nfa.GetTitle() + EPSILON_FREE_SUFFIX);
+	if (nfa.GetStates().empty())
+	{
+		return result;
+	}
+
+	const EpsilonClosureTable closures(nfa);
+	const auto& transitions = nfa.GetTransitions();
+	const auto& finalStates = nfa.GetFinalStates();
+
+	result.SetStartState(nfa.GetStartState());
+	for (const State state : nfa.GetStates())
+	{
+		result.AddState(state);
+		for (const State reachable : closures.Get(state))
+		{
+			if (finalStates.contains(reachable))
+			{
+				result.AddFinalState(state);
+			}
+
+			const auto fromIt = transitions.find(reachable);
+			if (fromIt == transitions.end())
+			{
+				continue;
+			}
+
+			for (const auto& [symbol, toStates] : fromIt->second)
+			{
+				for (const State to : toStates)
+				{
+					result.AddTransition(state, symbol, to);
+				}
+			}
+		}
+	}
+
+	return result;
+}
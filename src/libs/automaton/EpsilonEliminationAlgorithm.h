@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <set>
+#include <vector>
+
+// e-замыкания всех состояний, вычисленные один раз.
+// Граф e-переходов сжимается в компоненты сильной связности: у всех состояний компоненты
+// одно замыкание, а замыкания компонент собираются в обратном топологическом порядке
+class EpsilonClosureTable
+{
+public:
+	explicit EpsilonClosureTable(const Automaton& nfa);
+
+	// Отсортированное замыкание состояния (для неизвестного состояния - пустое)
+	const std::vector<State>& Get(State state) const;
+	std::set<State> Close(const std::set<State>& states) const;
+
+	std::size_t GetComponentCount() const;
+
+private:
+	std::vector<State> m_states;
+	std::vector<std::size_t> m_componentOf;
+	std::vector<std::vector<State>> m_componentClosures;
+};
+
+class EpsilonEliminationAlgorithm
+{
+public:
+	// Эквивалентный НКА без e-переходов: q -a-> r, если r ∈ δ(p, a) для некоторого p из замыкания q
+	static Automaton RemoveEpsilon(const Automaton& nfa);
+};
@@ -0,0 +1,373 @@
+#include "EquivalenceAlgorithm.h"
+
+#include "EpsilonEliminationAlgorithm.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using Subset = std::vector<std::size_t>;
+
+void AssertIsDeterministic(const Automaton& automaton)
+{
+	if (!automaton.IsDeterministic())
+	{
+		throw std::logic_error("Hopcroft-Karp equivalence is only possible for a DFA");
+	}
+}
+
+// Пара в очереди обхода и ссылка на пару, из которой в нее пришли
+struct Visit
+{
+	std::size_t left;
+	std::size_t right;
+	std::size_t parent;
+	Symbol symbol;
+};
+
+constexpr std::size_t NO_PARENT = static_cast<std::size_t>(-1);
+constexpr std::size_t MAX_CONGRUENCE_RELATION = 256;
+
+std::string RestoreWord(const std::vector<Visit>& visits, std::size_t index)
+{
+	std::string word;
+	while (visits[index].parent != NO_PARENT)
+	{
+		word.push_back(static_cast<char>(visits[index].symbol));
+		index = visits[index].parent;
+	}
+	std::reverse(word.begin(), word.end());
+	return word;
+}
+
+class DisjointSets
+{
+public:
+	explicit DisjointSets(std::size_t size)
+		: m_parent(size)
+		, m_rank(size, 0)
+	{
+		std::iota(m_parent.begin(), m_parent.end(), 0);
+	}
+
+	std::size_t Add()
+	{
+		m_parent.push_back(m_parent.size());
+		m_rank.push_back(0);
+		return m_parent.size() - 1;
+	}
+
+	std::size_t Find(std::size_t element)
+	{
+		while (m_parent[element] != element)
+		{
+			m_parent[element] = m_parent[m_parent[element]];
+			element = m_parent[element];
+		}
+		return element;
+	}
+
+	// false, если элементы уже в одном множестве
+	bool Unite(std::size_t left, std::size_t right)
+	{
+		left = Find(left);
+		right = Find(right);
+		if (left == right)
+		{
+			return false;
+		}
+		if (m_rank[left] < m_rank[right])
+		{
+			std::swap(left, right);
+		}
+		m_parent[right] = left;
+		if (m_rank[left] == m_rank[right])
+		{
+			m_rank[left]++;
+		}
+		return true;
+	}
+
+private:
+	std::vector<std::size_t> m_parent;
+	std::vector<unsigned char> m_rank;
+};
+
+// Два автомата в общей плотной нумерации: состояния left, затем состояния right
+class DisjointUnion
+{
+public:
+	DisjointUnion(const Automaton& left, const Automaton& right)
+	{
+		m_alphabet.insert(left.GetAlphabet().begin(), left.GetAlphabet().end());
+		m_alphabet.insert(right.GetAlphabet().begin(), right.GetAlphabet().end());
+		m_leftStart = Append(left);
+		m_rightStart = Append(right);
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_final.size();
+	}
+
+	bool IsFinal(std::size_t state) const
+	{
+		return m_final[state];
+	}
+
+	const std::vector<std::size_t>& Next(std::size_t state, Symbol symbol) const
+	{
+		static const std::vector<std::size_t> empty;
+		const auto it = m_transitions[state].find(symbol);
+		return it == m_transitions[state].end() ? empty : it->second;
+	}
+
+	const std::set<Symbol>& GetAlphabet() const
+	{
+		return m_alphabet;
+	}
+
+	Subset GetLeftStart() const
+	{
+		return m_leftStart;
+	}
+
+	Subset GetRightStart() const
+	{
+		return m_rightStart;
+	}
+
+private:
+	Subset Append(const Automaton& automaton)
+	{
+		if (automaton.GetStates().empty())
+		{
+			return {};
+		}
+
+		const std::size_t offset = m_final.size();
+		const std::vector<State> states(automaton.GetStates().begin(), automaton.GetStates().end());
+		auto indexOf = [&](State state) {
+			return offset + static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+		};
+
+		m_final.resize(offset + states.size(), false);
+		m_transitions.resize(offset + states.size());
+		for (const State state : automaton.GetFinalStates())
+		{
+			m_final[indexOf(state)] = true;
+		}
+		for (const auto& [from, transitions] : automaton.GetTransitions())
+		{
+			for (const auto& [symbol, toStates] : transitions)
+			{
+				auto& targets = m_transitions[indexOf(from)][symbol];
+				for (const State to : toStates)
+				{
+					targets.push_back(indexOf(to));
+				}
+			}
+		}
+
+		return {indexOf(automaton.GetStartState())};
+	}
+
+	std::set<Symbol> m_alphabet;
+	std::vector<bool> m_final;
+	std::vector<std::map<Symbol, std::vector<std::size_t>>> m_transitions;
+	Subset m_leftStart;
+	Subset m_rightStart;
+};
+
+Subset Step(const DisjointUnion& automaton, const Subset& subset, Symbol symbol)
+{
+	Subset result;
+	for (const std::size_t state : subset)
+	{
+		const auto& targets = automaton.Next(state, symbol);
+		result.insert(result.end(), targets.begin(), targets.end());
+	}
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+bool IsAccepting(const DisjointUnion& automaton, const Subset& subset)
+{
+	return std::any_of(subset.begin(), subset.end(), [&](std::size_t state) {
+		return automaton.IsFinal(state);
+	});
+}
+
+bool Includes(const Subset& set, const Subset& subset)
+{
+	return std::includes(set.begin(), set.end(), subset.begin(), subset.end());
+}
+
+Subset Merge(const Subset& left, const Subset& right)
+{
+	Subset result;
+	result.reserve(left.size() + right.size());
+	std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(result));
+	return result;
+}
+
+// Нормальная форма множества относительно конгруэнтного замыкания отношения:
+// пока есть пара (U, V) с U ⊆ Z, добавляем V в Z (и симметрично)
+Subset Saturate(Subset subset, const std::vector<std::pair<Subset, Subset>>& relation)
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (const auto& [u, v] : relation)
+		{
+			const bool hasU = Includes(subset, u);
+			const bool hasV = Includes(subset, v);
+			if (hasU != hasV)
+			{
+				subset = Merge(subset, hasU ? v : u);
+				changed = true;
+			}
+		}
+	}
+	return subset;
+}
+
+Automaton WithoutEpsilon(const Automaton& automaton)
+{
+	return automaton.HasEpsilonTransitions() ? EpsilonEliminationAlgorithm::RemoveEpsilon(automaton) : automaton;
+}
+} // namespace
+
+bool EquivalenceAlgorithm::AreEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample)
+{
+	if (left.IsDeterministic() && right.IsDeterministic())
+	{
+		return AreDfaEquivalent(left, right, counterexample);
+	}
+	return AreNfaEquivalent(left, right, counterexample);
+}
+
+bool EquivalenceAlgorithm::AreDfaEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample)
+{
+	AssertIsDeterministic(left);
+	AssertIsDeterministic(right);
+
+	const DisjointUnion automaton(left, right);
+	// Последний элемент - общее тупиковое состояние для отсутствующих переходов
+	const std::size_t sink = automaton.GetSize();
+	DisjointSets sets(sink + 1);
+
+	auto single = [sink](const Subset& subset) {
+		return subset.empty() ? sink : subset.front();
+	};
+	auto isFinal = [&](std::size_t state) {
+		return state != sink && automaton.IsFinal(state);
+	};
+	auto next = [&](std::size_t state, Symbol symbol) {
+		if (state == sink)
+		{
+			return sink;
+		}
+		const auto& targets = automaton.Next(state, symbol);
+		return targets.empty() ? sink : targets.front();
+	};
+
+	std::vector<Visit> visits;
+	visits.push_back({single(automaton.GetLeftStart()), single(automaton.GetRightStart()), NO_PARENT, 0});
+	sets.Unite(visits[0].left, visits[0].right);
+
+	for (std::size_t current = 0; current < visits.size(); ++current)
+	{
+		const auto [p, q, parent, via] = visits[current];
+		if (isFinal(p) != isFinal(q))
+		{
+			if (counterexample)
+			{
+				*counterexample = RestoreWord(visits, current);
+			}
+			return false;
+		}
+
+		for (const Symbol symbol : automaton.GetAlphabet())
+		{
+			const std::size_t nextP = next(p, symbol);
+			const std::size_t nextQ = next(q, symbol);
+			if (sets.Unite(nextP, nextQ))
+			{
+				visits.push_back({nextP, nextQ, current, symbol});
+			}
+		}
+	}
+
+	return true;
+}
+
+bool EquivalenceAlgorithm::AreNfaEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample)
+{
+	const DisjointUnion automaton(WithoutEpsilon(left), WithoutEpsilon(right));
+
+	// Подмножества хранятся один раз, пары ссылаются на них по номеру
+	std::map<Subset, std::size_t> subsetIds;
+	std::vector<Subset> subsets;
+	DisjointSets sets(0);
+	auto idOf = [&](Subset&& subset) {
+		const auto [it, inserted] = subsetIds.try_emplace(subset, subsets.size());
+		if (inserted)
+		{
+			subsets.push_back(std::move(subset));
+			sets.Add();
+		}
+		return it->second;
+	};
+
+	std::vector<Visit> visits;
+	visits.push_back({idOf(automaton.GetLeftStart()), idOf(automaton.GetRightStart()), NO_PARENT, 0});
+
+	std::vector<std::pair<Subset, Subset>> relation;
+	for (std::size_t current = 0; current < visits.size(); ++current)
+	{
+		const auto [leftId, rightId, parent, via] = visits[current];
+		// Копии: idOf ниже может переложить вектор подмножеств
+		const Subset x = subsets[leftId];
+		const Subset y = subsets[rightId];
+
+		// Пара уже следует из проверенных: сначала дешевая проверка по классам эквивалентности (HK),
+		// затем по конгруэнтному замыканию. Последняя квадратична по размеру отношения,
+		// поэтому на больших отношениях остается только объединение классов
+		if (sets.Find(leftId) == sets.Find(rightId))
+		{
+			continue;
+		}
+		if (relation.size() <= MAX_CONGRUENCE_RELATION && Saturate(x, relation) == Saturate(y, relation))
+		{
+			continue;
+		}
+
+		if (IsAccepting(automaton, x) != IsAccepting(automaton, y))
+		{
+			if (counterexample)
+			{
+				*counterexample = RestoreWord(visits, current);
+			}
+			return false;
+		}
+
+		relation.emplace_back(x, y);
+		sets.Unite(leftId, rightId);
+		for (const Symbol symbol : automaton.GetAlphabet())
+		{
+			const std::size_t nextLeft = idOf(Step(automaton, x, symbol));
+			const std::size_t nextRight = idOf(Step(automaton, y, symbol));
+			visits.push_back({nextLeft, nextRight, current, symbol});
+		}
+	}
+
+	return true;
+}
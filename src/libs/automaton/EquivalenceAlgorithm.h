@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <string>
+
+class EquivalenceAlgorithm
+{
+public:
+	// Проверка L(left) == L(right) без минимизации.
+	// Для ДКА - алгоритм Хопкрофта-Карпа с системой непересекающихся множеств,
+	// для НКА - ленивая детерминизация с отсечением пар по конгруэнции (HKC, Bonchi-Pous).
+	// При неэквивалентности в counterexample записывается различающее слово
+	static bool AreEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample = nullptr);
+
+	static bool AreDfaEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample = nullptr);
+	static bool AreNfaEquivalent(const Automaton& left, const Automaton& right, std::string* counterexample = nullptr);
+};
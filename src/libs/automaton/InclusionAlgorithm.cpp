@@ -0,0 +1,300 @@
+#include "InclusionAlgorithm.h"
+
+#include "EpsilonEliminationAlgorithm.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace
+{
+using Subset = std::vector<std::size_t>;
+
+constexpr std::size_t NO_PARENT = static_cast<std::size_t>(-1);
+
+// НКА без e-переходов в плотной нумерации состояний
+class DenseNfa
+{
+public:
+	explicit DenseNfa(const Automaton& automaton)
+	{
+		const Automaton epsilonFree = automaton.HasEpsilonTransitions()
+			? EpsilonEliminationAlgorithm::RemoveEpsilon(automaton)
+			: automaton;
+		const std::vector<State> states(epsilonFree.GetStates().begin(), epsilonFree.GetStates().end());
+		auto indexOf = [&](State state) {
+			return static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+		};
+
+		m_final.resize(states.size(), false);
+		m_transitions.resize(states.size());
+		for (const State state : epsilonFree.GetFinalStates())
+		{
+			m_final[indexOf(state)] = true;
+		}
+		for (const auto& [from, transitions] : epsilonFree.GetTransitions())
+		{
+			for (const auto& [symbol, toStates] : transitions)
+			{
+				auto& targets = m_transitions[indexOf(from)][symbol];
+				for (const State to : toStates)
+				{
+					targets.push_back(indexOf(to));
+				}
+			}
+		}
+		if (!states.empty())
+		{
+			m_start = {indexOf(epsilonFree.GetStartState())};
+		}
+	}
+
+	std::size_t GetStateCount() const
+	{
+		return m_final.size();
+	}
+
+	const Subset& GetStart() const
+	{
+		return m_start;
+	}
+
+	bool IsFinal(std::size_t state) const
+	{
+		return m_final[state];
+	}
+
+	bool IsAccepting(const Subset& subset) const
+	{
+		return std::any_of(subset.begin(), subset.end(), [this](std::size_t state) {
+			return m_final[state];
+		});
+	}
+
+	const std::vector<std::size_t>& Next(std::size_t state, Symbol symbol) const
+	{
+		static const std::vector<std::size_t> empty;
+		const auto it = m_transitions[state].find(symbol);
+		return it == m_transitions[state].end() ? empty : it->second;
+	}
+
+	Subset Next(const Subset& subset, Symbol symbol) const
+	{
+		Subset result;
+		for (const std::size_t state : subset)
+		{
+			const auto& targets = Next(state, symbol);
+			result.insert(result.end(), targets.begin(), targets.end());
+		}
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+		return result;
+	}
+
+private:
+	std::vector<bool> m_final;
+	std::vector<std::map<Symbol, std::vector<std::size_t>>> m_transitions;
+	Subset m_start;
+};
+
+// Вершина обхода: состояние левого автомата (для включения), подмножество правого и путь
+struct Node
+{
+	std::size_t state;
+	Subset subset;
+	std::size_t parent;
+	Symbol symbol;
+	bool alive;
+};
+
+std::string RestoreWord(const std::vector<Node>& nodes, std::size_t index)
+{
+	std::string word;
+	while (nodes[index].parent != NO_PARENT)
+	{
+		word.push_back(static_cast<char>(nodes[index].symbol));
+		index = nodes[index].parent;
+	}
+	std::reverse(word.begin(), word.end());
+	return word;
+}
+
+bool Includes(const Subset& set, const Subset& subset)
+{
+	return std::includes(set.begin(), set.end(), subset.begin(), subset.end());
+}
+
+// Антицепь минимальных подмножеств, сгруппированных по состоянию левого автомата.
+// Новое подмножество отбрасывается, если уже есть его подмножество;
+// иначе вытесняет все свои надмножества
+class Antichain
+{
+public:
+	bool Insert(std::vector<Node>& nodes, std::size_t index)
+	{
+		auto& chain = m_chains[nodes[index].state];
+		const Subset& subset = nodes[index].subset;
+		for (const std::size_t other : chain)
+		{
+			if (Includes(subset, nodes[other].subset))
+			{
+				nodes[index].alive = false;
+				return false;
+			}
+		}
+
+		std::erase_if(chain, [&](std::size_t other) {
+			if (Includes(nodes[other].subset, subset))
+			{
+				nodes[other].alive = false;
+				return true;
+			}
+			return false;
+		});
+		chain.push_back(index);
+		return true;
+	}
+
+private:
+	std::map<std::size_t, std::vector<std::size_t>> m_chains;
+};
+
+std::set<Symbol> UnitedAlphabet(const Automaton& left, const Automaton& right)
+{
+	std::set<Symbol> alphabet = left.GetAlphabet();
+	alphabet.insert(right.GetAlphabet().begin(), right.GetAlphabet().end());
+	return alphabet;
+}
+} // namespace
+
+bool InclusionAlgorithm::IsEmpty(const Automaton& automaton, std::string* witness)
+{
+	const DenseNfa nfa(automaton);
+	if (nfa.GetStart().empty())
+	{
+		return true;
+	}
+
+	// Обычный обход в ширину: кратчайшее принимаемое слово
+	std::vector<Node> nodes = {{nfa.GetStart().front(), {}, NO_PARENT, 0, true}};
+	std::vector<bool> visited(nfa.GetStateCount(), false);
+	visited[nodes[0].state] = true;
+
+	for (std::size_t current = 0; current < nodes.size(); ++current)
+	{
+		const std::size_t state = nodes[current].state;
+		if (nfa.IsFinal(state))
+		{
+			if (witness)
+			{
+				*witness = RestoreWord(nodes, current);
+			}
+			return false;
+		}
+
+		for (const Symbol symbol : automaton.GetAlphabet())
+		{
+			for (const std::size_t next : nfa.Next(state, symbol))
+			{
+				if (!visited[next])
+				{
+					visited[next] = true;
+					nodes.push_back({next, {}, current, symbol, true});
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool InclusionAlgorithm::IsUniversal(const Automaton& automaton, std::string* witness)
+{
+	return IsUniversal(automaton, automaton.GetAlphabet(), witness);
+}
+
+bool InclusionAlgorithm::IsUniversal(const Automaton& automaton, const std::set<Symbol>& alphabet, std::string* witness)
+{
+	const DenseNfa nfa(automaton);
+
+	// Универсальность - частный случай включения с единственным состоянием слева
+	std::vector<Node> nodes = {{0, nfa.GetStart(), NO_PARENT, 0, true}};
+	Antichain antichain;
+	antichain.Insert(nodes, 0);
+
+	for (std::size_t current = 0; current < nodes.size(); ++current)
+	{
+		if (!nodes[current].alive)
+		{
+			continue;
+		}
+
+		if (!nfa.IsAccepting(nodes[current].subset))
+		{
+			if (witness)
+			{
+				*witness = RestoreWord(nodes, current);
+			}
+			return false;
+		}
+
+		for (const Symbol symbol : alphabet)
+		{
+			nodes.push_back({0, nfa.Next(nodes[current].subset, symbol), current, symbol, true});
+			antichain.Insert(nodes, nodes.size() - 1);
+		}
+	}
+
+	return true;
+}
+
+bool InclusionAlgorithm::IsIncluded(const Automaton& left, const Automaton& right, std::string* witness)
+{
+	const DenseNfa leftNfa(left);
+	const DenseNfa rightNfa(right);
+	if (leftNfa.GetStart().empty())
+	{
+		return true;
+	}
+
+	const auto alphabet = UnitedAlphabet(left, right);
+	std::vector<Node> nodes = {{leftNfa.GetStart().front(), rightNfa.GetStart(), NO_PARENT, 0, true}};
+	Antichain antichain;
+	antichain.Insert(nodes, 0);
+
+	for (std::size_t current = 0; current < nodes.size(); ++current)
+	{
+		if (!nodes[current].alive)
+		{
+			continue;
+		}
+
+		const std::size_t state = nodes[current].state;
+		if (leftNfa.IsFinal(state) && !rightNfa.IsAccepting(nodes[current].subset))
+		{
+			if (witness)
+			{
+				*witness = RestoreWord(nodes, current);
+			}
+			return false;
+		}
+
+		for (const Symbol symbol : alphabet)
+		{
+			const auto& targets = leftNfa.Next(state, symbol);
+			if (targets.empty())
+			{
+				continue;
+			}
+
+			const Subset nextSubset = rightNfa.Next(nodes[current].subset, symbol);
+			for (const std::size_t next : targets)
+			{
+				nodes.push_back({next, nextSubset, current, symbol, true});
+				antichain.Insert(nodes, nodes.size() - 1);
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <set>
+#include <string>
+
+// Проверки языков НКА без детерминизации: обход подмножеств с отсечением по антицепи
+// (De Wulf, Doyen, Henzinger, Raskin). Подмножество, содержащее уже встреченное, не может
+// привести к более короткому контрпримеру, поэтому дальше не исследуется.
+// При отрицательном ответе в witness записывается слово, на котором проверка нарушается
+class InclusionAlgorithm
+{
+public:
+	// L(automaton) = ∅; witness - принимаемое слово
+	static bool IsEmpty(const Automaton& automaton, std::string* witness = nullptr);
+
+	// L(automaton) = alphabet* (по умолчанию - алфавит автомата); witness - непринимаемое слово
+	static bool IsUniversal(const Automaton& automaton, std::string* witness = nullptr);
+	static bool IsUniversal(const Automaton& automaton, const std::set<Symbol>& alphabet, std::string* witness = nullptr);
+
+	// L(left) ⊆ L(right); witness - слово из L(left) \ L(right)
+	static bool IsIncluded(const Automaton& left, const Automaton& right, std::string* witness = nullptr);
+};
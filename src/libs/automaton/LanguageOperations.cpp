@@ -0,0 +1,124 @@
+#include "LanguageOperations.h"
+
+namespace
+{
+const std::string INTERSECTION_TITLE = "Intersection";
+const std::string UNION_TITLE = "Union";
+const std::string DIFFERENCE_TITLE = "Difference";
+const std::string COMPLEMENT_TITLE = "Complement";
+const std::string REVERSE_TITLE = "Reversed";
+} // namespace
+
+Automaton LanguageOperations::Intersect(const Automaton& left, const Automaton& right)
+{
+	return LazyIntersect({left, right}).Materialize(left.GetTitle() + INTERSECTION_TITLE);
+}
+
+Automaton LanguageOperations::Intersect(const std::vector<Automaton>& automata)
+{
+	return LazyIntersect(automata).Materialize(INTERSECTION_TITLE);
+}
+
+Automaton LanguageOperations::Unite(const Automaton& left, const Automaton& right)
+{
+	return LazyUnite({left, right}).Materialize(left.GetTitle() + UNION_TITLE);
+}
+
+Automaton LanguageOperations::Subtract(const Automaton& left, const Automaton& right)
+{
+	return LazySubtract(left, right).Materialize(left.GetTitle() + DIFFERENCE_TITLE);
+}
+
+Automaton LanguageOperations::Complement(const Automaton& automaton)
+{
+	return Complement(automaton, automaton.GetAlphabet());
+}
+
+Automaton LanguageOperations::Complement(const Automaton& automaton, const std::set<Symbol>& alphabet)
+{
+	return LazyComplement(automaton, alphabet).Materialize(automaton.GetTitle() + COMPLEMENT_TITLE);
+}
+
+Automaton LanguageOperations::Reverse(const Automaton& automaton)
+{
+	Automaton reversed;
+	reversed.SetTitle(automaton.GetTitle() + REVERSE_TITLE);
+	if (automaton.GetStates().empty())
+	{
+		return reversed;
+	}
+
+	for (const State state : automaton.GetStates())
+	{
+		reversed.AddState(state);
+	}
+	for (const auto& [from, transitions] : automaton.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				reversed.AddTransition(to, symbol, from);
+			}
+		}
+	}
+	for (const auto& [from, toStates] : automaton.GetEpsilonTransitions())
+	{
+		for (const State to : toStates)
+		{
+			reversed.AddEpsilonTransition(to, from);
+		}
+	}
+
+	const auto& finalStates = automaton.GetFinalStates();
+	if (finalStates.size() == 1)
+	{
+		reversed.SetStartState(*finalStates.begin());
+	}
+	else
+	{
+		const State start = *automaton.GetStates().rbegin() + 1;
+		reversed.SetStartState(start);
+		for (const State state : finalStates)
+		{
+			reversed.AddEpsilonTransition(start, state);
+		}
+	}
+	reversed.AddFinalState(automaton.GetStartState());
+
+	return reversed;
+}
+
+ProductAutomaton LanguageOperations::LazyIntersect(const std::vector<Automaton>& automata)
+{
+	return ProductAutomaton(automata, ProductOperation::INTERSECTION);
+}
+
+ProductAutomaton LanguageOperations::LazyUnite(const std::vector<Automaton>& automata)
+{
+	return ProductAutomaton(automata, ProductOperation::UNION);
+}
+
+ProductAutomaton LanguageOperations::LazySubtract(const Automaton& left, const Automaton& right)
+{
+	return ProductAutomaton({left, right}, ProductOperation::DIFFERENCE);
+}
+
+// Дополнение - разность с универсальным языком: недостающие переходы не нужно достраивать в стоковое состояние
+ProductAutomaton LanguageOperations::LazyComplement(const Automaton& automaton, const std::set<Symbol>& alphabet)
+{
+	return ProductAutomaton({Universal(alphabet), automaton}, ProductOperation::DIFFERENCE);
+}
+
+Automaton LanguageOperations::Universal(const std::set<Symbol>& alphabet)
+{
+	Automaton universal;
+	universal.SetTitle("Universal");
+	universal.SetStartState(0);
+	universal.AddFinalState(0);
+	for (const Symbol symbol : alphabet)
+	{
+		universal.AddTransition(0, symbol, 0);
+	}
+	return universal;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Automaton.h"
+#include "ProductAutomaton.h"
+
+#include <set>
+#include <vector>
+
+// Операции над языками. Результат - ДКА только из достижимых кортежей произведения;
+// для распознавания без построения результата используется ProductAutomaton напрямую
+class LanguageOperations
+{
+public:
+	static Automaton Intersect(const Automaton& left, const Automaton& right);
+	static Automaton Intersect(const std::vector<Automaton>& automata);
+	static Automaton Unite(const Automaton& left, const Automaton& right);
+	static Automaton Subtract(const Automaton& left, const Automaton& right);
+
+	// Дополнение до alphabet* (по умолчанию - до алфавита автомата)
+	static Automaton Complement(const Automaton& automaton);
+	static Automaton Complement(const Automaton& automaton, const std::set<Symbol>& alphabet);
+
+	static ProductAutomaton LazyIntersect(const std::vector<Automaton>& automata);
+	static ProductAutomaton LazyUnite(const std::vector<Automaton>& automata);
+	static ProductAutomaton LazySubtract(const Automaton& left, const Automaton& right);
+	static ProductAutomaton LazyComplement(const Automaton& automaton, const std::set<Symbol>& alphabet);
+
+	// Зеркальный язык. Результат - НКА: при нескольких конечных состояниях
+	// добавляется новый старт с e-переходами в них
+	static Automaton Reverse(const Automaton& automaton);
+
+	// ДКА, принимающий все слова над alphabet
+	static Automaton Universal(const std::set<Symbol>& alphabet);
+};
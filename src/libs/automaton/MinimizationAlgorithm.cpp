@@ -1,49 +1,44 @@
 #include "MinimizationAlgorithm.h"
 
 #include "AutomatonVisualizer.h"
+#include "DeterminizationAlgorithm.h"
+#include "EpsilonEliminationAlgorithm.h"
+#include "LanguageOperations.h"
+#include "TrimAlgorithm.h"
 
+#include <algorithm>
+#include <bit>
 #include <iostream>
+#include <optional>
 #include <queue>
 
 namespace
 {
 constexpr int EMPTY_PARTITION = -1;
-
-std::set<State> FindReachableStates(const Automaton& automaton)
+const std::string MINIMIZED_SUFFIX = "Minimized";
+// Нижняя граница суммарного размера подмножеств, которые перебирает выбор стратегии
+constexpr std::size_t MIN_SUBSET_BUDGET = 4096;
+constexpr std::size_t SUBSET_BUDGET_PER_STATE = 16;
+// Брзозовский детерминизирует дважды, второй проход не больше первого для минимального ДКА
+constexpr std::size_t BRZOZOWSKI_PASSES = 2;
+// Примерный размер узла красно-черного дерева без хранимого значения
+constexpr std::size_t TREE_NODE_OVERHEAD = 32;
+
+void AssertIsAutomatonDeterministic(const Automaton& automaton)
 {
-	std::set<State> reachable;
-	if (automaton.GetStates().empty())
+	if (!automaton.IsDeterministic())
 	{
-		return reachable;
+		throw std::logic_error("Minimization is only possible for a DFA");
 	}
+}
 
-	std::queue<State> queue;
-	const State startState = automaton.GetStartState();
-
-	reachable.insert(startState);
-	queue.push(startState);
-
-	while (!queue.empty())
-	{
-		State currentState = queue.front();
-		queue.pop();
-
-		if (automaton.GetTransitions().contains(currentState))
-		{
-			for (const auto& onPair : automaton.GetTransitions().at(currentState))
-			{
-				for (State toState : onPair.second)
-				{
-					if (!reachable.contains(toState))
-					{
-						reachable.insert(toState);
-						queue.push(toState);
-					}
-				}
-			}
-		}
-	}
-	return reachable;
+// Разбиение, карта состояние -> класс и сигнатуры всех состояний одного прохода
+std::size_t EstimateRefinementBytes(const Automaton& automaton, std::size_t partitionCount)
+{
+	const std::size_t stateCount = automaton.GetStates().size();
+	const std::size_t signatureBytes = automaton.GetAlphabet().size() * sizeof(int) + sizeof(std::vector<int>);
+	const std::size_t perState = 3 * TREE_NODE_OVERHEAD + sizeof(State) * 3 + sizeof(int) + 2 * signatureBytes;
+	return stateCount * perState + partitionCount * sizeof(std::set<State>) * 2;
 }
 
 std::vector<std::set<State>> InitialPartition(const Automaton& automaton, const std::set<State>& reachableStates)
@@ -79,7 +74,7 @@ std::vector<std::set<State>> InitialPartition(const Automaton& automaton, const
 Automaton BuildMinimizedAutomaton(const Automaton& original, const std::vector<std::set<State>>& partitions)
 {
 	Automaton minimized;
-	minimized.SetTitle(original.GetTitle() + "Minimized");
+	minimized.SetTitle(original.GetTitle() + MINIMIZED_SUFFIX);
 	if (partitions.empty())
 	{
 		return minimized;
@@ -124,40 +119,608 @@ Automaton BuildMinimizedAutomaton(const Automaton& original, const std::vector<s
 
 	return minimized;
 }
+
+// Разбиение для алгоритма Хопкрофта над плотными номерами состояний.
+// Блок - отрезок массива elements; отмеченные состояния переставляются в начало своего блока,
+// поэтому расщепление не копирует состояния, а только сдвигает границу
+class RefinablePartition
+{
+public:
+	explicit RefinablePartition(std::size_t size)
+		: m_elements(size)
+		, m_location(size)
+		, m_blockOf(size)
+	{
+	}
+
+	// Начальные блоки задаются подряд идущими отрезками elements
+	void Assign(std::size_t position, std::size_t element, std::size_t block)
+	{
+		m_elements[position] = element;
+		m_location[element] = position;
+		m_blockOf[element] = block;
+	}
+
+	std::size_t AddBlock(std::size_t first, std::size_t end)
+	{
+		m_first.push_back(first);
+		m_end.push_back(end);
+		m_marked.push_back(0);
+		return m_first.size() - 1;
+	}
+
+	std::size_t GetBlockCount() const
+	{
+		return m_first.size();
+	}
+
+	std::size_t GetBlockSize(std::size_t block) const
+	{
+		return m_end[block] - m_first[block];
+	}
+
+	std::size_t GetBlockOf(std::size_t element) const
+	{
+		return m_blockOf[element];
+	}
+
+	std::vector<std::size_t> GetMembers(std::size_t block) const
+	{
+		return {m_elements.begin() + m_first[block], m_elements.begin() + m_end[block]};
+	}
+
+	void Mark(std::size_t element, std::vector<std::size_t>& touched)
+	{
+		const std::size_t block = m_blockOf[element];
+		const std::size_t target = m_first[block] + m_marked[block];
+		const std::size_t position = m_location[element];
+		if (position < target)
+		{
+			return;
+		}
+
+		const std::size_t displaced = m_elements[target];
+		m_elements[target] = element;
+		m_location[element] = target;
+		m_elements[position] = displaced;
+		m_location[displaced] = position;
+		if (m_marked[block]++ == 0)
+		{
+			touched.push_back(block);
+		}
+	}
+
+	// Отмеченная часть становится новым блоком, возвращает его номер или block, если блок не разделился
+	std::size_t SplitMarked(std::size_t block)
+	{
+		const std::size_t marked = m_marked[block];
+		m_marked[block] = 0;
+		if (marked == GetBlockSize(block))
+		{
+			return block;
+		}
+
+		const std::size_t created = AddBlock(m_first[block], m_first[block] + marked);
+		m_first[block] += marked;
+		for (std::size_t i = m_first[created]; i < m_end[created]; ++i)
+		{
+			m_blockOf[m_elements[i]] = created;
+		}
+		return created;
+	}
+
+	std::size_t EstimateBytes() const
+	{
+		return (m_elements.size() * 3 + m_first.size() * 3) * sizeof(std::size_t);
+	}
+
+private:
+	std::vector<std::size_t> m_elements;
+	std::vector<std::size_t> m_location;
+	std::vector<std::size_t> m_blockOf;
+	std::vector<std::size_t> m_first;
+	std::vector<std::size_t> m_end;
+	std::vector<std::size_t> m_marked;
+};
+
+// Алгоритм Хопкрофта: очередь блоков-разделителей, из двух половин расщепленного блока
+// в очередь попадает меньшая, поэтому каждое состояние обрабатывается O(log n) раз.
+// Частичный ДКА дополняется неявным стоком с номером states.size()
+std::vector<std::set<State>> HopcroftPartition(const Automaton& dfa, MinimizationStats* stats)
+{
+	const std::vector<State> states(dfa.GetStates().begin(), dfa.GetStates().end());
+	const std::vector<Symbol> alphabet(dfa.GetAlphabet().begin(), dfa.GetAlphabet().end());
+	const std::size_t sink = states.size();
+	const std::size_t count = states.size() + 1;
+	auto indexOf = [&](State state) {
+		return static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	// Обратные переходы по каждому символу в виде смещений и общего массива предшественников
+	std::vector<std::vector<std::size_t>> inverseStart(alphabet.size(), std::vector<std::size_t>(count + 1, 0));
+	std::vector<std::vector<std::size_t>> inverse(alphabet.size(), std::vector<std::size_t>(count));
+	std::vector<std::size_t> targets(count);
+	for (std::size_t symbolIndex = 0; symbolIndex < alphabet.size(); ++symbolIndex)
+	{
+		std::fill(targets.begin(), targets.end(), sink);
+		for (const auto& [from, transitions] : dfa.GetTransitions())
+		{
+			const auto it = transitions.find(alphabet[symbolIndex]);
+			if (it != transitions.end())
+			{
+				targets[indexOf(from)] = indexOf(*it->second.begin());
+			}
+		}
+
+		auto& start = inverseStart[symbolIndex];
+		for (const std::size_t target : targets)
+		{
+			start[target + 1]++;
+		}
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			start[i + 1] += start[i];
+		}
+		std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+		for (std::size_t from = 0; from < count; ++from)
+		{
+			inverse[symbolIndex][fill[targets[from]]++] = from;
+		}
+	}
+
+	RefinablePartition partition(count);
+	std::size_t position = 0;
+	for (const State state : dfa.GetFinalStates())
+	{
+		partition.Assign(position++, indexOf(state), 0);
+	}
+	const std::size_t finalCount = position;
+	const std::size_t finalBlock = finalCount == 0 ? 0 : partition.AddBlock(0, finalCount);
+	const std::size_t otherBlock = finalCount == 0 ? 0 : 1;
+	for (std::size_t element = 0; element < count; ++element)
+	{
+		if (element == sink || !dfa.GetFinalStates().contains(states[element]))
+		{
+			partition.Assign(position++, element, otherBlock);
+		}
+	}
+	partition.AddBlock(finalCount, count);
+
+	// Блоки непусты, поэтому их не больше числа состояний
+	std::vector<std::size_t> worklist;
+	std::vector<bool> inWorklist(count, false);
+	auto enqueue = [&](std::size_t block) {
+		worklist.push_back(block);
+		inWorklist[block] = true;
+	};
+	if (partition.GetBlockCount() == 2)
+	{
+		enqueue(partition.GetBlockSize(finalBlock) <= partition.GetBlockSize(otherBlock) ? finalBlock : otherBlock);
+	}
+
+	std::size_t splitters = 0;
+	std::vector<std::size_t> touched;
+	while (!worklist.empty())
+	{
+		const std::size_t splitter = worklist.back();
+		worklist.pop_back();
+		inWorklist[splitter] = false;
+		++splitters;
+
+		// Сам разделитель может расщепиться по первому символу, поэтому состав берется заранее
+		const auto members = partition.GetMembers(splitter);
+		for (std::size_t symbolIndex = 0; symbolIndex < alphabet.size(); ++symbolIndex)
+		{
+			const auto& start = inverseStart[symbolIndex];
+			for (const std::size_t target : members)
+			{
+				for (std::size_t i = start[target]; i < start[target + 1]; ++i)
+				{
+					partition.Mark(inverse[symbolIndex][i], touched);
+				}
+			}
+
+			for (const std::size_t block : touched)
+			{
+				const std::size_t created = partition.SplitMarked(block);
+				if (created == block)
+				{
+					continue;
+				}
+				if (inWorklist[block])
+				{
+					enqueue(created);
+				}
+				else
+				{
+					enqueue(partition.GetBlockSize(created) <= partition.GetBlockSize(block) ? created : block);
+				}
+			}
+			touched.clear();
+		}
+	}
+
+	// Классы упорядочены по наименьшему состоянию, сток в результат не попадает
+	std::vector<std::set<State>> partitions;
+	for (std::size_t block = 0; block < partition.GetBlockCount(); ++block)
+	{
+		std::set<State> members;
+		for (const std::size_t element : partition.GetMembers(block))
+		{
+			if (element != sink)
+			{
+				members.insert(states[element]);
+			}
+		}
+		if (!members.empty())
+		{
+			partitions.push_back(std::move(members));
+		}
+	}
+	std::sort(partitions.begin(), partitions.end(), [](const auto& lhs, const auto& rhs) {
+		return *lhs.begin() < *rhs.begin();
+	});
+
+	if (stats)
+	{
+		stats->refinementIterations = splitters;
+		std::size_t inverseBytes = 0;
+		for (std::size_t symbolIndex = 0; symbolIndex < alphabet.size(); ++symbolIndex)
+		{
+			inverseBytes += (inverseStart[symbolIndex].size() + inverse[symbolIndex].size()) * sizeof(std::size_t);
+		}
+		stats->peakBytes = std::max(stats->peakBytes, partition.EstimateBytes() + inverseBytes);
+	}
+	return partitions;
+}
+
+// Подрезанная копия создается, только если в автомате есть бесполезные состояния
+std::optional<Automaton> TrimIfNeeded(const Automaton& automaton, MinimizationStats* stats)
+{
+	PhaseTimer timer(stats ? &stats->reachabilityTime : nullptr);
+	const auto useful = TrimAlgorithm::FindUsefulStates(automaton);
+	if (TrimAlgorithm::IsTrim(automaton, useful))
+	{
+		return std::nullopt;
+	}
+	return TrimAlgorithm::Trim(automaton, useful);
+}
+
+void TrimInput(Automaton& input, MinimizationStats* stats)
+{
+	PhaseTimer timer(stats ? &stats->reachabilityTime : nullptr);
+	const auto useful = TrimAlgorithm::FindUsefulStates(input);
+	TrimAlgorithm::TrimInPlace(input, useful);
+}
+
+// Оценка детерминизации: число подмножеств и их суммарный размер (работа над каждым
+// подмножеством пропорциональна числу его состояний). Перебор останавливается, когда работа достигает limit
+struct SubsetEstimate
+{
+	std::size_t subsets = 0;
+	std::size_t work = 0;
+};
+
+SubsetEstimate EstimateSubsets(const Automaton& nfa, std::size_t limit)
+{
+	if (nfa.GetStates().empty())
+	{
+		return {};
+	}
+
+	std::optional<EpsilonClosureTable> closureTable;
+	if (nfa.HasEpsilonTransitions())
+	{
+		closureTable.emplace(nfa);
+	}
+	auto closure = [&](std::set<State>&& states) {
+		return closureTable ? closureTable->Close(states) : std::move(states);
+	};
+
+	std::set<std::set<State>> visited = {closure({nfa.GetStartState()})};
+	std::queue<std::set<State>> queue;
+	queue.push(*visited.begin());
+	std::size_t work = visited.begin()->size();
+
+	while (!queue.empty() && work < limit)
+	{
+		const auto current = queue.front();
+		queue.pop();
+		for (const Symbol symbol : nfa.GetAlphabet())
+		{
+			auto next = closure(DeterminizationAlgorithm::Move(nfa, current, symbol));
+			const std::size_t size = next.size();
+			if (size != 0 && visited.insert(next).second)
+			{
+				work += size;
+				queue.push(std::move(next));
+			}
+		}
+	}
+
+	return {visited.size(), std::min(work, limit)};
+}
+
+// Детерминизация обращенного автомата. Подмножества строятся сразу от множества конечных состояний:
+// отдельный стартовый узел обращения отличал бы начальное подмножество от совпадающих с ним
+Automaton DetermineReversed(const Automaton& automaton)
+{
+	const Automaton source = automaton.HasEpsilonTransitions()
+		? EpsilonEliminationAlgorithm::RemoveEpsilon(automaton)
+		: automaton;
+
+	std::map<State, std::map<Symbol, std::vector<State>>> reversed;
+	for (const auto& [from, transitions] : source.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				reversed[to][symbol].push_back(from);
+			}
+		}
+	}
+
+	Automaton dfa;
+	if (source.GetFinalStates().empty())
+	{
+		dfa.SetStartState(0);
+		return dfa;
+	}
+
+	std::map<std::set<State>, State> registry = {{source.GetFinalStates(), 0}};
+	std::queue<std::set<State>> queue;
+	queue.push(source.GetFinalStates());
+	dfa.SetStartState(0);
+
+	while (!queue.empty())
+	{
+		const auto current = queue.front();
+		queue.pop();
+		const State from = registry.at(current);
+		if (current.contains(source.GetStartState()))
+		{
+			dfa.AddFinalState(from);
+		}
+
+		std::map<Symbol, std::set<State>> moves;
+		for (const State state : current)
+		{
+			const auto it = reversed.find(state);
+			if (it == reversed.end())
+			{
+				continue;
+			}
+			for (const auto& [symbol, targets] : it->second)
+			{
+				moves[symbol].insert(targets.begin(), targets.end());
+			}
+		}
+
+		for (auto& [symbol, next] : moves)
+		{
+			const auto [it, inserted] = registry.try_emplace(std::move(next), static_cast<State>(registry.size()));
+			if (inserted)
+			{
+				queue.push(it->first);
+			}
+			dfa.AddTransition(from, symbol, it->second);
+		}
+	}
+
+	return dfa;
+}
 } // namespace
 
-Automaton MinimizationAlgorithm::Minimize(const Automaton& automaton, bool logSteps)
+Automaton MinimizationAlgorithm::MinimizeNfa(const Automaton& automaton, MinimizationStrategy strategy)
 {
-	if (!automaton.IsDeterministic())
+	if (strategy == MinimizationStrategy::AUTO)
 	{
-		throw std::logic_error("Minimization is only possible for a DFA");
+		strategy = ChooseStrategy(automaton);
 	}
 
-	if (automaton.GetStates().empty())
+	if (strategy == MinimizationStrategy::BRZOZOWSKI)
 	{
-		return automaton;
+		return MinimizeBrzozowski(automaton);
+	}
+	if (automaton.IsDeterministic())
+	{
+		return MinimizeHopcroft(automaton);
 	}
 
-	const auto reachableStates = FindReachableStates(automaton);
-	auto partitions = InitialPartition(automaton, reachableStates);
+	auto minimized = MinimizeHopcroft(DeterminizationAlgorithm::Determine(automaton));
+	minimized.SetTitle(automaton.GetTitle() + MINIMIZED_SUFFIX);
+	return minimized;
+}
 
-	int iteration = 0;
-	while (true)
+// Детерминизация обращенного автомата дает ДКА, у которого все состояния различимы по префиксам,
+// поэтому второе обращение и детерминизация сразу дают минимальный ДКА
+Automaton MinimizationAlgorithm::MinimizeBrzozowski(const Automaton& automaton, MinimizationStats* stats)
+{
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	if (automaton.GetStates().empty())
 	{
-		iteration++;
-		if (logSteps)
+		return BuildMinimizedAutomaton(automaton, {});
+	}
+
+	auto reverse = [&](const Automaton& source) {
+		auto dfa = DetermineReversed(source);
+		if (stats)
 		{
-			std::cout << "\nIteration " << iteration << std::endl;
+			stats->refinementIterations++;
+			stats->partitionsPerIteration.push_back(dfa.GetStates().size());
 		}
+		return dfa;
+	};
+	Automaton minimized;
+	{
+		PhaseTimer timer(stats ? &stats->refinementTime : nullptr);
+		minimized = reverse(reverse(automaton));
+	}
+	minimized.SetTitle(automaton.GetTitle() + MINIMIZED_SUFFIX);
+	if (stats)
+	{
+		stats->reachableStates = automaton.GetStates().size();
+		stats->minimizedStates = minimized.GetStates().size();
+	}
+	return minimized;
+}
 
-		if (!RefineSinglePass(automaton, partitions, logSteps, iteration))
+MinimizationStrategy MinimizationAlgorithm::ChooseStrategy(const Automaton& automaton)
+{
+	if (automaton.GetStates().empty())
+	{
+		return MinimizationStrategy::HOPCROFT;
+	}
+
+	// Стоимость в переходах: Хопкрофт - детерминизация и n * |Σ| * log n на уточнение,
+	// Брзозовский - две детерминизации, каждая оценивается суммарным размером подмножеств обращения
+	const std::size_t alphabetSize = std::max<std::size_t>(1, automaton.GetAlphabet().size());
+	const bool deterministic = automaton.IsDeterministic();
+	const std::size_t limit = std::max(MIN_SUBSET_BUDGET, SUBSET_BUDGET_PER_STATE * automaton.GetStates().size());
+	const auto forward = deterministic
+		? SubsetEstimate{automaton.GetStates().size(), 0}
+		: EstimateSubsets(automaton, limit);
+	const auto passes = static_cast<std::size_t>(std::bit_width(forward.subsets));
+	const std::size_t hopcroftCost = (forward.work + forward.subsets * passes) * alphabetSize;
+
+	// Обращение перебирается, только пока Брзозовский еще может оказаться дешевле
+	const std::size_t budget = hopcroftCost / (BRZOZOWSKI_PASSES * alphabetSize) + 1;
+	const auto backward = EstimateSubsets(LanguageOperations::Reverse(automaton), budget);
+	const std::size_t brzozowskiCost = BRZOZOWSKI_PASSES * backward.work * alphabetSize;
+
+	return brzozowskiCost < hopcroftCost ? MinimizationStrategy::BRZOZOWSKI : MinimizationStrategy::HOPCROFT;
+}
+
+Automaton MinimizationAlgorithm::Minimize(const Automaton& automaton, bool logSteps, MinimizationStats* stats)
+{
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AssertIsAutomatonDeterministic(automaton);
+	if (automaton.GetStates().empty())
+	{
+		return BuildMinimizedAutomaton(automaton, {});
+	}
+
+	// Мертвые и недостижимые состояния не участвуют в разбиении, результат - частичный ДКА.
+	// Уже подрезанный автомат не копируется
+	const auto trimmed = TrimIfNeeded(automaton, stats);
+	return MinimizeTrimmed(trimmed ? *trimmed : automaton, logSteps, stats);
+}
+
+// Вход забирается в локальную переменную и освобождается при выходе, а не в конце выражения вызывающего
+Automaton MinimizationAlgorithm::Minimize(Automaton&& automaton, bool logSteps, MinimizationStats* stats)
+{
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AssertIsAutomatonDeterministic(automaton);
+	Automaton input = std::move(automaton);
+	automaton.Clear();
+	if (input.GetStates().empty())
+	{
+		return BuildMinimizedAutomaton(input, {});
+	}
+
+	TrimInput(input, stats);
+	return MinimizeTrimmed(input, logSteps, stats);
+}
+
+void MinimizationAlgorithm::MinimizeInPlace(Automaton& automaton, bool logSteps, MinimizationStats* stats)
+{
+	automaton = Minimize(std::move(automaton), logSteps, stats);
+}
+
+Automaton MinimizationAlgorithm::MinimizeHopcroft(const Automaton& automaton, MinimizationStats* stats)
+{
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AssertIsAutomatonDeterministic(automaton);
+	if (automaton.GetStates().empty())
+	{
+		return BuildMinimizedAutomaton(automaton, {});
+	}
+
+	const auto trimmed = TrimIfNeeded(automaton, stats);
+	return MinimizeTrimmedHopcroft(trimmed ? *trimmed : automaton, stats);
+}
+
+Automaton MinimizationAlgorithm::MinimizeHopcroft(Automaton&& automaton, MinimizationStats* stats)
+{
+	PhaseTimer totalTimer(stats ? &stats->totalTime : nullptr);
+	AssertIsAutomatonDeterministic(automaton);
+	Automaton input = std::move(automaton);
+	automaton.Clear();
+	if (input.GetStates().empty())
+	{
+		return BuildMinimizedAutomaton(input, {});
+	}
+
+	TrimInput(input, stats);
+	return MinimizeTrimmedHopcroft(input, stats);
+}
+
+Automaton MinimizationAlgorithm::MinimizeTrimmedHopcroft(const Automaton& trimmed, MinimizationStats* stats)
+{
+	if (stats)
+	{
+		stats->reachableStates = trimmed.GetStates().size();
+	}
+
+	std::vector<std::set<State>> partitions;
+	{
+		PhaseTimer timer(stats ? &stats->refinementTime : nullptr);
+		partitions = HopcroftPartition(trimmed, stats);
+	}
+
+	PhaseTimer buildTimer(stats ? &stats->buildTime : nullptr);
+	auto minimized = BuildMinimizedAutomaton(trimmed, partitions);
+	if (stats)
+	{
+		stats->minimizedStates = minimized.GetStates().size();
+	}
+	return minimized;
+}
+
+Automaton MinimizationAlgorithm::MinimizeTrimmed(const Automaton& trimmed, bool logSteps, MinimizationStats* stats)
+{
+	auto partitions = InitialPartition(trimmed, trimmed.GetStates());
+	if (stats)
+	{
+		stats->reachableStates = trimmed.GetStates().size();
+	}
+
+	int iteration = 0;
+	{
+		PhaseTimer timer(stats ? &stats->refinementTime : nullptr);
+		while (true)
 		{
-			if (logSteps) std::cout << "Partitions are stable. Minimization complete." << std::endl;
-			break;
+			iteration++;
+			if (logSteps)
+			{
+				std::cout << "\nIteration " << iteration << std::endl;
+			}
+
+			const bool refined = RefineSinglePass(trimmed, partitions, logSteps, iteration);
+			if (stats)
+			{
+				stats->refinementIterations++;
+				stats->partitionsPerIteration.push_back(partitions.size());
+				stats->peakBytes = std::max(stats->peakBytes, EstimateRefinementBytes(trimmed, partitions.size()));
+			}
+
+			if (!refined)
+			{
+				if (logSteps) std::cout << "Partitions are stable. Minimization complete." << std::endl;
+				break;
+			}
 		}
 	}
 
-	return BuildMinimizedAutomaton(automaton, partitions);
+	PhaseTimer buildTimer(stats ? &stats->buildTime : nullptr);
+	auto minimized = BuildMinimizedAutomaton(trimmed, partitions);
+	if (stats)
+	{
+		stats->minimizedStates = minimized.GetStates().size();
+	}
+
+	return minimized;
 }
 
 bool MinimizationAlgorithm::RefineSinglePass(
@@ -1,16 +1,44 @@
 #pragma once
 
+#include "AlgorithmStats.h"
 #include "Automaton.h"
 #include <vector>
 
+enum class MinimizationStrategy
+{
+	AUTO,
+	// Детерминизация и алгоритм Хопкрофта
+	HOPCROFT,
+	// Обращение и детерминизация дважды
+	BRZOZOWSKI
+};
+
 class MinimizationAlgorithm
 {
 public:
 	MinimizationAlgorithm() = default;
 	virtual ~MinimizationAlgorithm() = default;
-	static Automaton Minimize(const Automaton& automaton, bool logSteps = false);
+	// Уточнение разбиения проходами Мура: O(n) проходов, зато с logSteps печатается таблица каждого прохода
+	static Automaton Minimize(const Automaton& automaton, bool logSteps = false, MinimizationStats* stats = nullptr);
+	// Вход подрезается на месте и освобождается внутри вызова
+	static Automaton Minimize(Automaton&& automaton, bool logSteps = false, MinimizationStats* stats = nullptr);
+	// Буферы входа не переиспользуются: вход только освобождается раньше, чем при automaton = Minimize(automaton)
+	static void MinimizeInPlace(Automaton& automaton, bool logSteps = false, MinimizationStats* stats = nullptr);
+	// Алгоритм Хопкрофта за O(n * |Σ| * log n); в статистике refinementIterations - число обработанных разделителей
+	static Automaton MinimizeHopcroft(const Automaton& automaton, MinimizationStats* stats = nullptr);
+	static Automaton MinimizeHopcroft(Automaton&& automaton, MinimizationStats* stats = nullptr);
+
+	// Минимальный ДКА для произвольного автомата, в том числе НКА с e-переходами
+	static Automaton MinimizeNfa(const Automaton& automaton, MinimizationStrategy strategy = MinimizationStrategy::AUTO);
+	// В статистике refinementIterations - число обращений, partitionsPerIteration - размер ДКА после каждого
+	static Automaton MinimizeBrzozowski(const Automaton& automaton, MinimizationStats* stats = nullptr);
+	// Сравнивает оценки стоимости: детерминизация автомата и n * |Σ| * log n на уточнение
+	// против двух детерминизаций обращения; детерминизация оценивается суммарным размером подмножеств
+	static MinimizationStrategy ChooseStrategy(const Automaton& automaton);
 
 private:
+	static Automaton MinimizeTrimmed(const Automaton& trimmed, bool logSteps, MinimizationStats* stats);
+	static Automaton MinimizeTrimmedHopcroft(const Automaton& trimmed, MinimizationStats* stats);
 	static bool RefineSinglePass(
 		const Automaton& automaton,
 		std::vector<std::set<State>>& partitions,
@@ -0,0 +1,258 @@
+#include "ProductAutomaton.h"
+
+#include "DeterminizationAlgorithm.h"
+
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+// Компонента без перехода по символу: ее язык из этой точки пуст
+constexpr State DEAD_STATE = std::numeric_limits<State>::max();
+constexpr State DEAD_TRANSITION = std::numeric_limits<State>::max();
+
+void AssertHasComponents(const std::vector<Automaton>& components)
+{
+	if (components.empty())
+	{
+		throw std::invalid_argument("Product requires at least one automaton");
+	}
+}
+
+std::uint64_t TransitionKey(State state, Symbol symbol)
+{
+	return (static_cast<std::uint64_t>(state) << 8) | symbol;
+}
+
+State NextComponentState(const Automaton& dfa, State state, Symbol symbol)
+{
+	if (state == DEAD_STATE)
+	{
+		return DEAD_STATE;
+	}
+
+	const auto& transitions = dfa.GetTransitions();
+	const auto fromIt = transitions.find(state);
+	if (fromIt == transitions.end())
+	{
+		return DEAD_STATE;
+	}
+
+	const auto onIt = fromIt->second.find(symbol);
+	return onIt == fromIt->second.end() ? DEAD_STATE : *onIt->second.begin();
+}
+
+bool IsComponentFinal(const Automaton& dfa, State state)
+{
+	return state != DEAD_STATE && dfa.GetFinalStates().contains(state);
+}
+} // namespace
+
+std::size_t ProductAutomaton::TupleHash::operator()(const std::vector<State>& tuple) const
+{
+	std::size_t hash = tuple.size();
+	for (const State state : tuple)
+	{
+		hash ^= std::hash<State>{}(state) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
+
+ProductAutomaton::ProductAutomaton(std::vector<Automaton> components, ProductOperation operation)
+	: m_components(std::move(components))
+	, m_operation(operation)
+{
+	AssertHasComponents(m_components);
+
+	std::vector<State> startTuple;
+	startTuple.reserve(m_components.size());
+	for (auto& component : m_components)
+	{
+		if (!component.IsDeterministic())
+		{
+			DeterminizationAlgorithm::DetermineInPlace(component);
+		}
+
+		m_alphabet.insert(component.GetAlphabet().begin(), component.GetAlphabet().end());
+		startTuple.push_back(component.GetStates().empty() ? DEAD_STATE : component.GetStartState());
+	}
+
+	Register(std::move(startTuple));
+}
+
+State ProductAutomaton::GetStartState() const
+{
+	return 0;
+}
+
+std::optional<State> ProductAutomaton::Step(const State state, const Symbol symbol)
+{
+	const auto key = TransitionKey(state, symbol);
+	if (const auto cached = m_transitionCache.find(key); cached != m_transitionCache.end())
+	{
+		return cached->second == DEAD_TRANSITION ? std::nullopt : std::optional<State>(cached->second);
+	}
+
+	const auto& tuple = m_tuples.at(state);
+	std::vector<State> next;
+	next.reserve(tuple.size());
+	for (std::size_t i = 0; i < tuple.size(); ++i)
+	{
+		next.push_back(NextComponentState(m_components[i], tuple[i], symbol));
+	}
+
+	State result = DEAD_TRANSITION;
+	if (!IsDead(next))
+	{
+		result = Register(std::move(next));
+	}
+
+	m_transitionCache.emplace(key, result);
+	return result == DEAD_TRANSITION ? std::nullopt : std::optional<State>(result);
+}
+
+bool ProductAutomaton::IsFinal(const State state) const
+{
+	return m_finals.at(state);
+}
+
+bool ProductAutomaton::Recognize(const std::string& word)
+{
+	State state = GetStartState();
+	for (const auto symbol : word)
+	{
+		const auto next = Step(state, static_cast<Symbol>(symbol));
+		if (!next)
+		{
+			return false;
+		}
+		state = *next;
+	}
+	return IsFinal(state);
+}
+
+const std::set<Symbol>& ProductAutomaton::GetAlphabet() const
+{
+	return m_alphabet;
+}
+
+std::size_t ProductAutomaton::GetExploredStateCount() const
+{
+	return m_tuples.size();
+}
+
+const std::vector<State>& ProductAutomaton::GetComponentStates(const State state) const
+{
+	return m_tuples.at(state);
+}
+
+Automaton ProductAutomaton::Materialize(const std::string& title)
+{
+	Automaton result;
+	result.SetTitle(title);
+	result.SetStartState(GetStartState());
+
+	std::vector<bool> visited(m_tuples.size(), false);
+	std::queue<State> queue;
+	queue.push(GetStartState());
+	visited[GetStartState()] = true;
+
+	while (!queue.empty())
+	{
+		const State state = queue.front();
+		queue.pop();
+		if (IsFinal(state))
+		{
+			result.AddFinalState(state);
+		}
+
+		for (const Symbol symbol : m_alphabet)
+		{
+			const auto next = Step(state, symbol);
+			if (!next)
+			{
+				continue;
+			}
+
+			if (*next >= visited.size())
+			{
+				visited.resize(*next + 1, false);
+			}
+			if (!visited[*next])
+			{
+				visited[*next] = true;
+				queue.push(*next);
+			}
+			result.AddTransition(state, symbol, *next);
+		}
+	}
+
+	return result;
+}
+
+State ProductAutomaton::Register(std::vector<State>&& tuple)
+{
+	const auto [it, inserted] = m_registry.try_emplace(tuple, static_cast<State>(m_tuples.size()));
+	if (!inserted)
+	{
+		return it->second;
+	}
+
+	bool isFinal = false;
+	switch (m_operation)
+	{
+	case ProductOperation::INTERSECTION:
+		isFinal = true;
+		for (std::size_t i = 0; i < tuple.size() && isFinal; ++i)
+		{
+			isFinal = IsComponentFinal(m_components[i], tuple[i]);
+		}
+		break;
+	case ProductOperation::UNION:
+		for (std::size_t i = 0; i < tuple.size() && !isFinal; ++i)
+		{
+			isFinal = IsComponentFinal(m_components[i], tuple[i]);
+		}
+		break;
+	case ProductOperation::DIFFERENCE:
+		isFinal = IsComponentFinal(m_components[0], tuple[0]);
+		for (std::size_t i = 1; i < tuple.size() && isFinal; ++i)
+		{
+			isFinal = !IsComponentFinal(m_components[i], tuple[i]);
+		}
+		break;
+	}
+
+	m_tuples.push_back(std::move(tuple));
+	m_finals.push_back(isFinal);
+	return it->second;
+}
+
+bool ProductAutomaton::IsDead(const std::vector<State>& tuple) const
+{
+	switch (m_operation)
+	{
+	case ProductOperation::INTERSECTION:
+		for (const State state : tuple)
+		{
+			if (state == DEAD_STATE)
+			{
+				return true;
+			}
+		}
+		return false;
+	case ProductOperation::UNION:
+		for (const State state : tuple)
+		{
+			if (state != DEAD_STATE)
+			{
+				return false;
+			}
+		}
+		return true;
+	case ProductOperation::DIFFERENCE:
+		return tuple[0] == DEAD_STATE;
+	}
+	return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ProductOperation
+{
+	INTERSECTION, // слово принимают все компоненты
+	UNION,		  // слово принимает хотя бы одна компонента
+	DIFFERENCE	  // слово принимает первая компонента и не принимает ни одна из остальных
+};
+
+// Ленивое произведение ДКА: состояния-кортежи создаются только при первом достижении
+// из стартового, поэтому |Q1| x ... x |Qn| никогда не строится целиком.
+// НКА-компоненты детерминизируются при создании
+class ProductAutomaton
+{
+public:
+	ProductAutomaton(std::vector<Automaton> components, ProductOperation operation);
+
+	State GetStartState() const;
+	// std::nullopt - из состояния по символу нельзя прийти к принимаемому слову
+	std::optional<State> Step(State state, Symbol symbol);
+	bool IsFinal(State state) const;
+	bool Recognize(const std::string& word);
+
+	const std::set<Symbol>& GetAlphabet() const;
+	std::size_t GetExploredStateCount() const;
+	const std::vector<State>& GetComponentStates(State state) const;
+
+	// Обходит все достижимые кортежи и строит обычный ДКА
+	Automaton Materialize(const std::string& title);
+
+private:
+	struct TupleHash
+	{
+		std::size_t operator()(const std::vector<State>& tuple) const;
+	};
+
+	State Register(std::vector<State>&& tuple);
+	bool IsDead(const std::vector<State>& tuple) const;
+
+	std::vector<Automaton> m_components;
+	ProductOperation m_operation;
+	std::set<Symbol> m_alphabet;
+
+	std::unordered_map<std::vector<State>, State, TupleHash> m_registry;
+	std::vector<std::vector<State>> m_tuples;
+	std::vector<bool> m_finals;
+	// (состояние, символ) -> состояние; DEAD_TRANSITION для тупиковых переходов
+	std::unordered_map<std::uint64_t, State> m_transitionCache;
+};
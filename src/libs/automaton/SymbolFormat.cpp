@@ -0,0 +1,92 @@
+#include "SymbolFormat.h"
+
+#include <stdexcept>
+
+namespace
+{
+constexpr std::string_view HEX_DIGITS = "0123456789ABCDEF";
+
+void AssertIsSymbolValid(bool isValid, std::string_view label)
+{
+	if (!isValid)
+	{
+		throw std::invalid_argument("There must be one character, got '" + std::string(label) + "'");
+	}
+}
+
+int HexValue(char digit)
+{
+	if (digit >= '0' && digit <= '9') return digit - '0';
+	if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+	if (digit >= 'A' && digit <= 'F') return digit - 'A' + 10;
+	return -1;
+}
+} // namespace
+
+std::string SymbolFormat::ToLabel(const Symbol symbol)
+{
+	switch (symbol)
+	{
+	case '"':
+		return "\\\"";
+	case '\\':
+		return "\\\\";
+	case ',':
+		return "\\,";
+	case '\n':
+		return "\\n";
+	case '\r':
+		return "\\r";
+	case '\t':
+		return "\\t";
+	default:
+		break;
+	}
+
+	// Пробел тоже экранируется: метки разделяются запятыми и обрезаются по краям
+	if (symbol > ' ' && symbol < 0x7F)
+	{
+		return std::string(1, static_cast<char>(symbol));
+	}
+
+	return std::string("\\x") + HEX_DIGITS[symbol >> 4] + HEX_DIGITS[symbol & 0x0F];
+}
+
+std::optional<Symbol> SymbolFormat::FromLabel(std::string_view label)
+{
+	if (label.empty() || label == EPSILON_LABEL)
+	{
+		return std::nullopt;
+	}
+
+	if (label[0] != '\\')
+	{
+		AssertIsSymbolValid(label.size() == 1, label);
+		return static_cast<Symbol>(label[0]);
+	}
+
+	AssertIsSymbolValid(label.size() >= 2, label);
+	switch (label[1])
+	{
+	case 'n':
+		AssertIsSymbolValid(label.size() == 2, label);
+		return '\n';
+	case 'r':
+		AssertIsSymbolValid(label.size() == 2, label);
+		return '\r';
+	case 't':
+		AssertIsSymbolValid(label.size() == 2, label);
+		return '\t';
+	case 'x':
+	{
+		AssertIsSymbolValid(label.size() == 4, label);
+		const int high = HexValue(label[2]);
+		const int low = HexValue(label[3]);
+		AssertIsSymbolValid(high >= 0 && low >= 0, label);
+		return static_cast<Symbol>(high * 16 + low);
+	}
+	default:
+		AssertIsSymbolValid(label.size() == 2, label);
+		return static_cast<Symbol>(label[1]);
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Запись символов в метках .dot. Любой байт допустим как символ:
+// печатные символы пишутся как есть, служебные и непечатные - через escape-последовательности
+// (\" \\ \, \n \r \t \xHH). Метка "ε" (или пустая метка) обозначает e-переход
+class SymbolFormat
+{
+public:
+	static std::string ToLabel(Symbol symbol);
+	// std::nullopt - e-переход
+	static std::optional<Symbol> FromLabel(std::string_view label);
+
+	static constexpr std::string_view EPSILON_LABEL = "ε";
+};
@@ -0,0 +1,210 @@
+#include "TaggedAutomaton.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr std::size_t SYMBOL_COUNT = 256;
+constexpr std::size_t NO_POSITION = std::numeric_limits<std::size_t>::max();
+} // namespace
+
+void TaggedNfa::SetStartState(State state)
+{
+	AddState(state);
+	m_startState = state;
+}
+
+State TaggedNfa::GetStartState() const
+{
+	return m_startState;
+}
+
+void TaggedNfa::AddFinalState(State state)
+{
+	AddState(state);
+	m_final[state] = true;
+}
+
+bool TaggedNfa::IsFinal(State state) const
+{
+	return state < m_final.size() && m_final[state];
+}
+
+void TaggedNfa::AddTransition(State from, Symbol on, State to)
+{
+	AddState(std::max(from, to));
+	m_transitions[from].emplace_back(on, to);
+}
+
+void TaggedNfa::AddEpsilonTransition(State from, State to, Tag tag)
+{
+	AddState(std::max(from, to));
+	m_epsilonTransitions[from].emplace_back(to, tag);
+	if (tag != NO_TAG)
+	{
+		m_tagCount = std::max<std::size_t>(m_tagCount, tag + 1);
+	}
+}
+
+std::size_t TaggedNfa::GetStateCount() const
+{
+	return m_final.size();
+}
+
+std::size_t TaggedNfa::GetTagCount() const
+{
+	return m_tagCount;
+}
+
+const std::vector<std::pair<Symbol, State>>& TaggedNfa::GetTransitions(State state) const
+{
+	return m_transitions.at(state);
+}
+
+const std::vector<std::pair<State, Tag>>& TaggedNfa::GetEpsilonTransitions(State state) const
+{
+	return m_epsilonTransitions.at(state);
+}
+
+// Состояния нумеруются плотно, поэтому хранятся в векторах
+void TaggedNfa::AddState(State state)
+{
+	if (state >= m_final.size())
+	{
+		m_final.resize(state + 1, false);
+		m_transitions.resize(state + 1);
+		m_epsilonTransitions.resize(state + 1);
+	}
+}
+
+TaggedDfa::TaggedDfa(std::size_t tagCount)
+	: m_tagCount(tagCount)
+{
+}
+
+State TaggedDfa::AddState()
+{
+	m_transitions.resize(m_transitions.size() + SYMBOL_COUNT);
+	m_finalRegisters.emplace_back();
+	return static_cast<State>(m_finalRegisters.size() - 1);
+}
+
+void TaggedDfa::SetTransition(State from, Symbol on, State to, std::vector<RegisterOperation> operations)
+{
+	TrackRegisters(operations);
+	Transition& transition = m_transitions.at(from * SYMBOL_COUNT + on);
+	transition.target = to;
+	transition.operations = 0;
+	if (!operations.empty())
+	{
+		m_operationLists.push_back(std::move(operations));
+		transition.operations = m_operationLists.size() - 1;
+	}
+}
+
+void TaggedDfa::SetFinal(State state, std::vector<Register> tagRegisters)
+{
+	for (const Register reg : tagRegisters)
+	{
+		if (reg != NO_REGISTER)
+		{
+			m_registerCount = std::max<std::size_t>(m_registerCount, reg + 1);
+		}
+	}
+	m_finalRegisters.at(state) = std::move(tagRegisters);
+}
+
+void TaggedDfa::SetStartOperations(std::vector<RegisterOperation> operations)
+{
+	TrackRegisters(operations);
+	m_operationLists.push_back(std::move(operations));
+	m_startOperations = m_operationLists.size() - 1;
+}
+
+std::size_t TaggedDfa::GetStateCount() const
+{
+	return m_finalRegisters.size();
+}
+
+std::size_t TaggedDfa::GetRegisterCount() const
+{
+	return m_registerCount;
+}
+
+std::size_t TaggedDfa::GetTagCount() const
+{
+	return m_tagCount;
+}
+
+bool TaggedDfa::IsFinal(State state) const
+{
+	return m_finalRegisters.at(state).has_value();
+}
+
+std::optional<TaggedDfa::Offsets> TaggedDfa::Match(std::string_view word) const
+{
+	if (m_finalRegisters.empty())
+	{
+		return std::nullopt;
+	}
+
+	std::vector<std::size_t> registers(m_registerCount, NO_POSITION);
+	std::vector<std::size_t> scratch(m_registerCount);
+	ApplyOperations(m_startOperations, 0, registers, scratch);
+
+	State state = 0;
+	for (std::size_t i = 0; i < word.size(); ++i)
+	{
+		const Transition& transition = m_transitions[state * SYMBOL_COUNT + static_cast<Symbol>(word[i])];
+		if (transition.target == DEAD_STATE)
+		{
+			return std::nullopt;
+		}
+		ApplyOperations(transition.operations, i + 1, registers, scratch);
+		state = transition.target;
+	}
+
+	const auto& finalRegisters = m_finalRegisters[state];
+	if (!finalRegisters)
+	{
+		return std::nullopt;
+	}
+
+	Offsets offsets(m_tagCount);
+	for (std::size_t tag = 0; tag < m_tagCount; ++tag)
+	{
+		const Register reg = (*finalRegisters)[tag];
+		if (reg != NO_REGISTER && registers[reg] != NO_POSITION)
+		{
+			offsets[tag] = registers[reg];
+		}
+	}
+	return offsets;
+}
+
+void TaggedDfa::ApplyOperations(std::size_t list, std::size_t position, std::vector<std::size_t>& registers,
+	std::vector<std::size_t>& scratch) const
+{
+	const auto& operations = m_operationLists[list];
+	for (std::size_t i = 0; i < operations.size(); ++i)
+	{
+		const Register source = operations[i].source;
+		scratch[i] = source == RegisterOperation::POSITION ? position : registers[source];
+	}
+	for (std::size_t i = 0; i < operations.size(); ++i)
+	{
+		registers[operations[i].target] = scratch[i];
+	}
+}
+
+void TaggedDfa::TrackRegisters(const std::vector<RegisterOperation>& operations)
+{
+	for (const auto& operation : operations)
+	{
+		m_registerCount = std::max<std::size_t>(m_registerCount, operation.target + 1);
+		if (operation.source != RegisterOperation::POSITION)
+		{
+			m_registerCount = std::max<std::size_t>(m_registerCount, operation.source + 1);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Тег запоминает позицию во входе, на которой пройден помеченный e-переход.
+// Группа захвата g - пара тегов 2g (начало) и 2g + 1 (конец)
+using Tag = unsigned int;
+using Register = unsigned int;
+
+constexpr Tag NO_TAG = std::numeric_limits<Tag>::max();
+constexpr Register NO_REGISTER = std::numeric_limits<Register>::max();
+
+// НКА с упорядоченными e-переходами, часть из которых помечена тегами.
+// Порядок добавления переходов из состояния задает приоритет путей (leftmost-greedy):
+// из нескольких принимающих путей выбирается первый
+class TaggedNfa
+{
+public:
+	void SetStartState(State state);
+	State GetStartState() const;
+
+	void AddFinalState(State state);
+	bool IsFinal(State state) const;
+
+	void AddTransition(State from, Symbol on, State to);
+	void AddEpsilonTransition(State from, State to, Tag tag = NO_TAG);
+
+	std::size_t GetStateCount() const;
+	std::size_t GetTagCount() const;
+	const std::vector<std::pair<Symbol, State>>& GetTransitions(State state) const;
+	const std::vector<std::pair<State, Tag>>& GetEpsilonTransitions(State state) const;
+
+private:
+	void AddState(State state);
+
+	State m_startState = 0;
+	std::vector<char> m_final;
+	std::vector<std::vector<std::pair<Symbol, State>>> m_transitions;
+	std::vector<std::vector<std::pair<State, Tag>>> m_epsilonTransitions;
+	std::size_t m_tagCount = 0;
+};
+
+// Операция над регистрами на переходе: target <- source или target <- текущая позиция.
+// Все операции перехода выполняются параллельно: сначала читаются источники, затем пишутся приемники
+struct RegisterOperation
+{
+	static constexpr Register POSITION = NO_REGISTER - 1;
+
+	Register target;
+	Register source;
+};
+
+// Теговый ДКА (Laurikari, TDFA): значения тегов хранятся в регистрах, переходы несут операции над ними.
+// Сопоставление - один проход по входу без возвратов
+class TaggedDfa
+{
+public:
+	// Позиция для каждого тега, std::nullopt - тег не пройден на выбранном пути
+	using Offsets = std::vector<std::optional<std::size_t>>;
+
+	static constexpr State DEAD_STATE = std::numeric_limits<State>::max();
+
+	explicit TaggedDfa(std::size_t tagCount = 0);
+
+	State AddState();
+	void SetTransition(State from, Symbol on, State to, std::vector<RegisterOperation> operations);
+	// Регистры, из которых читаются теги при окончании входа в этом состоянии
+	void SetFinal(State state, std::vector<Register> tagRegisters);
+	void SetStartOperations(std::vector<RegisterOperation> operations);
+
+	std::size_t GetStateCount() const;
+	std::size_t GetRegisterCount() const;
+	std::size_t GetTagCount() const;
+	bool IsFinal(State state) const;
+
+	// Слово целиком; std::nullopt - не принимается
+	std::optional<Offsets> Match(std::string_view word) const;
+
+private:
+	struct Transition
+	{
+		State target = DEAD_STATE;
+		std::size_t operations = 0;
+	};
+
+	void ApplyOperations(std::size_t list, std::size_t position, std::vector<std::size_t>& registers,
+		std::vector<std::size_t>& scratch) const;
+	void TrackRegisters(const std::vector<RegisterOperation>& operations);
+
+	std::size_t m_tagCount;
+	std::size_t m_registerCount = 0;
+	std::vector<Transition> m_transitions;
+	// Список 0 - пустой
+	std::vector<std::vector<RegisterOperation>> m_operationLists = {{}};
+	std::vector<std::optional<std::vector<Register>>> m_finalRegisters;
+	std::size_t m_startOperations = 0;
+};
@@ -0,0 +1,186 @@
+#include "TrimAlgorithm.h"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+#include <vector>
+
+namespace
+{
+using Graph = std::map<State, std::vector<State>>;
+
+std::set<State> Traverse(const Graph& graph, const std::set<State>& sources)
+{
+	std::set<State> visited = sources;
+	std::queue<State> queue;
+	for (const State state : sources)
+	{
+		queue.push(state);
+	}
+
+	while (!queue.empty())
+	{
+		const State current = queue.front();
+		queue.pop();
+
+		const auto it = graph.find(current);
+		if (it == graph.end())
+		{
+			continue;
+		}
+		for (const State next : it->second)
+		{
+			if (visited.insert(next).second)
+			{
+				queue.push(next);
+			}
+		}
+	}
+
+	return visited;
+}
+
+Graph BuildGraph(const Automaton& automaton, bool reversed)
+{
+	Graph graph;
+	auto addEdge = [&](State from, State to) {
+		reversed ? graph[to].push_back(from) : graph[from].push_back(to);
+	};
+
+	for (const auto& [from, transitions] : automaton.GetTransitions())
+	{
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				addEdge(from, to);
+			}
+		}
+	}
+	for (const auto& [from, toStates] : automaton.GetEpsilonTransitions())
+	{
+		for (const State to : toStates)
+		{
+			addEdge(from, to);
+		}
+	}
+
+	return graph;
+}
+} // namespace
+
+std::set<State> TrimAlgorithm::FindReachableStates(const Automaton& automaton)
+{
+	if (automaton.GetStates().empty())
+	{
+		return {};
+	}
+	return Traverse(BuildGraph(automaton, false), {automaton.GetStartState()});
+}
+
+std::set<State> TrimAlgorithm::FindCoReachableStates(const Automaton& automaton)
+{
+	return Traverse(BuildGraph(automaton, true), automaton.GetFinalStates());
+}
+
+std::set<State> TrimAlgorithm::FindUsefulStates(const Automaton& automaton)
+{
+	const auto reachable = FindReachableStates(automaton);
+	const auto coReachable = FindCoReachableStates(automaton);
+
+	std::set<State> useful;
+	std::set_intersection(
+		reachable.begin(), reachable.end(),
+		coReachable.begin(), coReachable.end(),
+		std::inserter(useful, useful.end()));
+	return useful;
+}
+
+bool TrimAlgorithm::IsTrim(const Automaton& automaton)
+{
+	return IsTrim(automaton, FindUsefulStates(automaton));
+}
+
+bool TrimAlgorithm::IsTrim(const Automaton& automaton, const std::set<State>& useful)
+{
+	if (automaton.GetStates().empty())
+	{
+		return true;
+	}
+
+	const State start = automaton.GetStartState();
+	if (useful.contains(start))
+	{
+		return useful.size() == automaton.GetStates().size();
+	}
+
+	// Бесполезный старт Trim сохраняет, но без переходов: тогда других состояний нет вовсе
+	return automaton.GetStates().size() == 1
+		&& !automaton.GetTransitions().contains(start)
+		&& !automaton.GetEpsilonTransitions().contains(start);
+}
+
+Automaton TrimAlgorithm::Trim(const Automaton& automaton)
+{
+	return Trim(automaton, FindUsefulStates(automaton));
+}
+
+Automaton TrimAlgorithm::Trim(const Automaton& automaton, const std::set<State>& useful)
+{
+	Automaton trimmed;
+	trimmed.SetTitle(automaton.GetTitle());
+	if (automaton.GetStates().empty())
+	{
+		return trimmed;
+	}
+
+	trimmed.SetStartState(automaton.GetStartState());
+
+	for (const State state : useful)
+	{
+		trimmed.AddState(state);
+		if (automaton.GetFinalStates().contains(state))
+		{
+			trimmed.AddFinalState(state);
+		}
+	}
+
+	for (const auto& [from, transitions] : automaton.GetTransitions())
+	{
+		if (!useful.contains(from))
+		{
+			continue;
+		}
+		for (const auto& [symbol, toStates] : transitions)
+		{
+			for (const State to : toStates)
+			{
+				if (useful.contains(to))
+				{
+					trimmed.AddTransition(from, symbol, to);
+				}
+			}
+		}
+	}
+	for (const auto& [from, toStates] : automaton.GetEpsilonTransitions())
+	{
+		if (!useful.contains(from))
+		{
+			continue;
+		}
+		for (const State to : toStates)
+		{
+			if (useful.contains(to))
+			{
+				trimmed.AddEpsilonTransition(from, to);
+			}
+		}
+	}
+
+	return trimmed;
+}
+
+void TrimAlgorithm::TrimInPlace(Automaton& automaton, const std::set<State>& useful)
+{
+	automaton.RetainStates(useful);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <set>
+
+// Удаление бесполезных состояний: недостижимых из старта и тех, из которых не достичь конечного.
+// Язык не меняется; стартовое состояние сохраняется даже при пустом языке
+class TrimAlgorithm
+{
+public:
+	static Automaton Trim(const Automaton& automaton);
+	// useful - результат FindUsefulStates, чтобы не обходить автомат повторно
+	static Automaton Trim(const Automaton& automaton, const std::set<State>& useful);
+	// То же без копии: бесполезные состояния удаляются из самого автомата
+	static void TrimInPlace(Automaton& automaton, const std::set<State>& useful);
+
+	// Прямой обход от старта с учетом e-переходов
+	static std::set<State> FindReachableStates(const Automaton& automaton);
+	// Обратный обход от конечных состояний
+	static std::set<State> FindCoReachableStates(const Automaton& automaton);
+	static std::set<State> FindUsefulStates(const Automaton& automaton);
+
+	// Trim ничего не удалит
+	static bool IsTrim(const Automaton& automaton);
+	static bool IsTrim(const Automaton& automaton, const std::set<State>& useful);
+};
@@ -0,0 +1,428 @@
+#include "WordCounter.h"
+
+#include "DeterminizationAlgorithm.h"
+#include "TrimAlgorithm.h"
+
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::uint64_t MAX_MODULUS = std::uint64_t{1} << 32;
+
+using Matrix = std::vector<std::vector<std::uint64_t>>;
+
+void AssertIsModulusValid(std::uint64_t modulus)
+{
+	if (modulus == 0 || modulus > MAX_MODULUS)
+	{
+		throw std::invalid_argument("Modulus must be in (0, 2^32]");
+	}
+}
+
+Automaton ToTrimmedDfa(const Automaton& automaton)
+{
+	// Determine обрезает автомат сам
+	return automaton.IsDeterministic() ? TrimAlgorithm::Trim(automaton) : DeterminizationAlgorithm::Determine(automaton);
+}
+
+// Значения меньше 2^32, поэтому произведение помещается в 64 бита
+Matrix Multiply(const Matrix& left, const Matrix& right, std::uint64_t modulus)
+{
+	const std::size_t size = left.size();
+	Matrix result(size, std::vector<std::uint64_t>(size, 0));
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		for (std::size_t k = 0; k < size; ++k)
+		{
+			if (left[i][k] == 0)
+			{
+				continue;
+			}
+			for (std::size_t j = 0; j < size; ++j)
+			{
+				result[i][j] = (result[i][j] + left[i][k] * right[k][j]) % modulus;
+			}
+		}
+	}
+	return result;
+}
+
+std::vector<std::uint64_t> Multiply(const Matrix& matrix, const std::vector<std::uint64_t>& vector, std::uint64_t modulus)
+{
+	std::vector<std::uint64_t> result(vector.size(), 0);
+	for (std::size_t i = 0; i < matrix.size(); ++i)
+	{
+		for (std::size_t j = 0; j < vector.size(); ++j)
+		{
+			result[i] = (result[i] + matrix[i][j] * vector[j]) % modulus;
+		}
+	}
+	return result;
+}
+} // namespace
+
+WordCounter::WordCounter(const Automaton& automaton)
+{
+	const Automaton dfa = ToTrimmedDfa(automaton);
+	if (dfa.GetFinalStates().empty())
+	{
+		return;
+	}
+
+	const std::vector<State> states(dfa.GetStates().begin(), dfa.GetStates().end());
+	auto indexOf = [&](State state) {
+		return static_cast<State>(std::lower_bound(states.begin(), states.end(), state) - states.begin());
+	};
+
+	m_final.assign(states.size(), false);
+	m_offsets.assign(states.size() + 1, 0);
+	m_edgeOffsets.assign(states.size() + 1, 0);
+	for (std::size_t i = 0; i < states.size(); ++i)
+	{
+		m_final[i] = dfa.GetFinalStates().contains(states[i]);
+		std::map<State, std::uint32_t> multiplicities;
+		const auto it = dfa.GetTransitions().find(states[i]);
+		if (it != dfa.GetTransitions().end())
+		{
+			for (const auto& [symbol, toStates] : it->second)
+			{
+				const State target = indexOf(*toStates.begin());
+				m_symbols.emplace_back(symbol, target);
+				multiplicities[target]++;
+			}
+		}
+		for (const auto& [target, multiplicity] : multiplicities)
+		{
+			m_edges.push_back({target, multiplicity});
+		}
+		m_offsets[i + 1] = m_symbols.size();
+		m_edgeOffsets[i + 1] = m_edges.size();
+	}
+	m_startState = indexOf(dfa.GetStartState());
+	m_isEmpty = false;
+}
+
+BigUnsigned WordCounter::CountWords(std::size_t length) const
+{
+	return Count(length, false);
+}
+
+BigUnsigned WordCounter::CountWordsUpTo(std::size_t length) const
+{
+	return Count(length, true);
+}
+
+std::uint64_t WordCounter::CountWords(std::size_t length, std::uint64_t modulus) const
+{
+	return CountModulo(length, modulus, false);
+}
+
+std::uint64_t WordCounter::CountWordsUpTo(std::size_t length, std::uint64_t modulus) const
+{
+	return CountModulo(length, modulus, true);
+}
+
+// Обратный обход в ширину дает расстояние до финальных состояний,
+// затем из старта жадно берется наименьший символ, сокращающий расстояние
+std::optional<std::string> WordCounter::GetShortestWord() const
+{
+	if (m_isEmpty)
+	{
+		return std::nullopt;
+	}
+
+	const std::size_t stateCount = GetStateCount();
+	std::vector<std::vector<State>> predecessors(stateCount);
+	for (State state = 0; state < stateCount; ++state)
+	{
+		for (std::size_t i = m_edgeOffsets[state]; i < m_edgeOffsets[state + 1]; ++i)
+		{
+			predecessors[m_edges[i].target].push_back(state);
+		}
+	}
+
+	constexpr std::size_t UNREACHABLE = SIZE_MAX;
+	std::vector<std::size_t> distance(stateCount, UNREACHABLE);
+	std::queue<State> queue;
+	for (State state = 0; state < stateCount; ++state)
+	{
+		if (m_final[state])
+		{
+			distance[state] = 0;
+			queue.push(state);
+		}
+	}
+	while (!queue.empty())
+	{
+		const State state = queue.front();
+		queue.pop();
+		for (const State predecessor : predecessors[state])
+		{
+			if (distance[predecessor] == UNREACHABLE)
+			{
+				distance[predecessor] = distance[state] + 1;
+				queue.push(predecessor);
+			}
+		}
+	}
+
+	std::string word;
+	State state = m_startState;
+	while (distance[state] != 0)
+	{
+		for (std::size_t i = m_offsets[state]; i < m_offsets[state + 1]; ++i)
+		{
+			const auto [symbol, target] = m_symbols[i];
+			if (distance[target] + 1 == distance[state])
+			{
+				word.push_back(static_cast<char>(symbol));
+				state = target;
+				break;
+			}
+		}
+	}
+	return word;
+}
+
+WordEnumerator WordCounter::Enumerate() const
+{
+	return WordEnumerator(*this);
+}
+
+std::size_t WordCounter::GetStateCount() const
+{
+	return m_final.size();
+}
+
+BigUnsigned WordCounter::Count(std::size_t length, bool upTo) const
+{
+	if (m_isEmpty)
+	{
+		return 0;
+	}
+
+	const std::size_t stateCount = GetStateCount();
+	std::vector<BigUnsigned> current(stateCount);
+	for (State state = 0; state < stateCount; ++state)
+	{
+		current[state] = m_final[state] ? 1 : 0;
+	}
+
+	BigUnsigned total = upTo ? current[m_startState] : 0;
+	std::vector<BigUnsigned> next(stateCount);
+	for (std::size_t step = 0; step < length; ++step)
+	{
+		for (State state = 0; state < stateCount; ++state)
+		{
+			BigUnsigned sum;
+			for (std::size_t i = m_edgeOffsets[state]; i < m_edgeOffsets[state + 1]; ++i)
+			{
+				BigUnsigned term = current[m_edges[i].target];
+				term *= m_edges[i].multiplicity;
+				sum += term;
+			}
+			next[state] = std::move(sum);
+		}
+		current.swap(next);
+		if (upTo)
+		{
+			total += current[m_startState];
+		}
+	}
+	return upTo ? total : current[m_startState];
+}
+
+std::uint64_t WordCounter::CountModulo(std::size_t length, std::uint64_t modulus, bool upTo) const
+{
+	AssertIsModulusValid(modulus);
+	if (m_isEmpty)
+	{
+		return 0;
+	}
+
+	// Динамика стоит length * переходы, степень матрицы - size^3 * log(length)
+	const std::size_t size = GetStateCount() + (upTo ? 1 : 0);
+	const double powerCost = static_cast<double>(size) * size * size * std::bit_width(length);
+	const double dynamicCost = static_cast<double>(length) * std::max<std::size_t>(m_edges.size(), 1);
+	if (powerCost < dynamicCost)
+	{
+		return CountByPower(length, modulus, upTo);
+	}
+
+	const std::size_t stateCount = GetStateCount();
+	std::vector<std::uint64_t> current(stateCount);
+	for (State state = 0; state < stateCount; ++state)
+	{
+		current[state] = m_final[state] ? 1 % modulus : 0;
+	}
+
+	std::uint64_t total = upTo ? current[m_startState] : 0;
+	std::vector<std::uint64_t> next(stateCount);
+	for (std::size_t step = 0; step < length; ++step)
+	{
+		for (State state = 0; state < stateCount; ++state)
+		{
+			std::uint64_t sum = 0;
+			for (std::size_t i = m_edgeOffsets[state]; i < m_edgeOffsets[state + 1]; ++i)
+			{
+				sum = (sum + m_edges[i].multiplicity % modulus * current[m_edges[i].target]) % modulus;
+			}
+			next[state] = sum;
+		}
+		current.swap(next);
+		if (upTo)
+		{
+			total = (total + current[m_startState]) % modulus;
+		}
+	}
+	return upTo ? total : current[m_startState];
+}
+
+// c(n) = M * c(n - 1), c(0) = f. Для суммы по длинам S(n) = f + M * S(n - 1):
+// вектор дополняется единицей, а матрица - столбцом f
+std::uint64_t WordCounter::CountByPower(std::size_t length, std::uint64_t modulus, bool upTo) const
+{
+	const std::size_t stateCount = GetStateCount();
+	const std::size_t size = stateCount + (upTo ? 1 : 0);
+
+	Matrix power(size, std::vector<std::uint64_t>(size, 0));
+	std::vector<std::uint64_t> result(size, 0);
+	for (State state = 0; state < stateCount; ++state)
+	{
+		for (std::size_t i = m_edgeOffsets[state]; i < m_edgeOffsets[state + 1]; ++i)
+		{
+			power[state][m_edges[i].target] = m_edges[i].multiplicity % modulus;
+		}
+		result[state] = m_final[state] ? 1 % modulus : 0;
+		if (upTo)
+		{
+			power[state][stateCount] = result[state];
+		}
+	}
+	if (upTo)
+	{
+		power[stateCount][stateCount] = 1 % modulus;
+		result[stateCount] = 1 % modulus;
+	}
+
+	for (std::size_t rest = length; rest != 0; rest >>= 1)
+	{
+		if (rest & 1)
+		{
+			result = Multiply(power, result, modulus);
+		}
+		if (rest > 1)
+		{
+			power = Multiply(power, power, modulus);
+		}
+	}
+	return result[m_startState];
+}
+
+WordEnumerator::WordEnumerator(const WordCounter& counter)
+	: m_counter(counter)
+	, m_isExhausted(counter.m_isEmpty)
+{
+}
+
+std::optional<std::string> WordEnumerator::Next()
+{
+	while (!m_isExhausted)
+	{
+		if (m_stack.empty() && !StartLength())
+		{
+			continue;
+		}
+
+		auto& frame = m_stack.back();
+		if (m_word.size() == m_length)
+		{
+			// В кадр на полной глубине попадаем только через финальное состояние
+			std::string word = m_word;
+			m_stack.pop_back();
+			if (!m_word.empty())
+			{
+				m_word.pop_back();
+			}
+			if (m_stack.empty())
+			{
+				m_length++;
+			}
+			return word;
+		}
+
+		const auto& finishable = m_finishable[m_length - m_word.size() - 1];
+		const auto& counter = m_counter;
+		const std::size_t end = counter.m_offsets[frame.state + 1];
+		std::size_t edge = std::max(frame.edge, counter.m_offsets[frame.state]);
+		while (edge < end && !finishable[counter.m_symbols[edge].second])
+		{
+			edge++;
+		}
+
+		if (edge == end)
+		{
+			m_stack.pop_back();
+			if (m_stack.empty())
+			{
+				m_length++;
+			}
+			else
+			{
+				m_word.pop_back();
+			}
+			continue;
+		}
+
+		frame.edge = edge + 1;
+		const auto [symbol, target] = counter.m_symbols[edge];
+		m_word.push_back(static_cast<char>(symbol));
+		m_stack.push_back({target, 0});
+	}
+	return std::nullopt;
+}
+
+const std::vector<char>& WordEnumerator::GetFinishable(std::size_t remaining)
+{
+	const auto& counter = m_counter;
+	while (m_finishable.size() <= remaining)
+	{
+		std::vector<char> row(counter.GetStateCount(), false);
+		for (State state = 0; state < row.size(); ++state)
+		{
+			if (m_finishable.empty())
+			{
+				row[state] = counter.m_final[state];
+				continue;
+			}
+			const auto& previous = m_finishable.back();
+			for (std::size_t i = counter.m_edgeOffsets[state]; i < counter.m_edgeOffsets[state + 1] && !row[state]; ++i)
+			{
+				row[state] = previous[counter.m_edges[i].target];
+			}
+		}
+		m_finishable.push_back(std::move(row));
+	}
+	return m_finishable[remaining];
+}
+
+// Начинает перебор слов длины m_length; false - слов такой длины нет
+bool WordEnumerator::StartLength()
+{
+	if (!GetFinishable(m_length)[m_counter.m_startState])
+	{
+		m_length++;
+		if (++m_emptyLengths >= m_counter.GetStateCount())
+		{
+			m_isExhausted = true;
+		}
+		return false;
+	}
+	m_emptyLengths = 0;
+	m_stack.push_back({m_counter.m_startState, 0});
+	return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Automaton.h"
+#include "BigUnsigned.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+class WordEnumerator;
+
+// Подсчет и перечисление слов языка по обрезанному ДКА.
+// В ДКА каждому слову соответствует ровно один путь, поэтому число слов длины n из состояния q
+// равно сумме по переходам q -> t числа слов длины n - 1 из t
+class WordCounter
+{
+public:
+	// НКА детерминизируется
+	explicit WordCounter(const Automaton& automaton);
+
+	// Точное число слов длины length и длины не больше length: динамика O(length * переходы)
+	BigUnsigned CountWords(std::size_t length) const;
+	BigUnsigned CountWordsUpTo(std::size_t length) const;
+	// То же по модулю из (0, 2^32]: динамика или возведение матрицы переходов в степень,
+	// смотря что дешевле, поэтому годится и для очень больших длин
+	std::uint64_t CountWords(std::size_t length, std::uint64_t modulus) const;
+	std::uint64_t CountWordsUpTo(std::size_t length, std::uint64_t modulus) const;
+
+	// Первое слово языка в порядке shortlex (сначала по длине, затем лексикографически)
+	std::optional<std::string> GetShortestWord() const;
+
+	// Ленивое перечисление в порядке shortlex; перечислитель не должен пережить счетчик
+	WordEnumerator Enumerate() const;
+
+	std::size_t GetStateCount() const;
+
+private:
+	friend class WordEnumerator;
+
+	// Переход с кратностью: сколько символов ведут из состояния в target
+	struct Edge
+	{
+		State target;
+		std::uint32_t multiplicity;
+	};
+
+	BigUnsigned Count(std::size_t length, bool upTo) const;
+	std::uint64_t CountModulo(std::size_t length, std::uint64_t modulus, bool upTo) const;
+	std::uint64_t CountByPower(std::size_t length, std::uint64_t modulus, bool upTo) const;
+
+	// Обрезанный ДКА в сжатом виде: переходы состояния s - m_symbols[m_offsets[s]..m_offsets[s + 1]),
+	// отсортированы по символу
+	std::vector<std::size_t> m_offsets;
+	std::vector<std::pair<Symbol, State>> m_symbols;
+	// Те же переходы, сгруппированные по целевому состоянию
+	std::vector<std::size_t> m_edgeOffsets;
+	std::vector<Edge> m_edges;
+	std::vector<char> m_final;
+	State m_startState = 0;
+	bool m_isEmpty = true;
+};
+
+// Выдает слова языка по одному в порядке shortlex. Слова длины L перебираются обходом в глубину
+// с отсечением ветвей, из которых нельзя дойти до финального состояния ровно за оставшиеся шаги.
+// Если язык конечен, перечисление заканчивается: после обрезки в ДКА с s состояниями
+// слово длины не меньше L + s есть только вместе со словом длины из [L, L + s)
+class WordEnumerator
+{
+public:
+	explicit WordEnumerator(const WordCounter& counter);
+
+	std::optional<std::string> Next();
+
+private:
+	struct Frame
+	{
+		State state;
+		std::size_t edge;
+	};
+
+	// m_finishable[r][q] - из q можно принять слово длины ровно r
+	const std::vector<char>& GetFinishable(std::size_t remaining);
+	bool StartLength();
+
+	const WordCounter& m_counter;
+	std::vector<std::vector<char>> m_finishable;
+	std::vector<Frame> m_stack;
+	std::string m_word;
+	std::size_t m_length = 0;
+	std::size_t m_emptyLengths = 0;
+	bool m_isExhausted = false;
+};
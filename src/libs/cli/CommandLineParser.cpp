@@ -0,0 +1,260 @@
+#include "CommandLineParser.h"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+// Больше потоков не дает выигрыша и только исчерпывает ресурсы системы
+constexpr unsigned long long MAX_THREADS = 1024;
+
+const std::string USAGE = R"(Usage: compiler-ta <command> [options]
+
+Commands:
+  determinize   build a DFA from the input automaton
+  minimize      determinize if needed and minimize
+  match         recognize whole words, one per line
+  search        print lines that contain a word of the language
+  bench         time determinization, minimization and matching
+  dictionary    build a minimal acyclic DFA from a word list (-w)
+  count         count words of a given length and find the shortest word
+  enumerate     print the first words of the language in shortlex order
+
+Options:
+  -i, --input FILE     input automaton (.dot or binary, detected by signature)
+  -o, --output FILE    output automaton (default: stdout, dot only)
+  --format dot|binary  output format (default: dot)
+  -w, --words FILE     words or text for match/search/bench ('-' for stdin)
+  --distance K         match words within edit distance K of the language
+  --threads N          worker threads for match/search/bench (default: 1)
+  --repeat N           bench repetitions (default: 1)
+  --stats              print algorithm counters as JSON to stderr
+  --log                print intermediate tables
+  --reduce             merge bisimilar NFA states before processing
+  --unsorted           dictionary words are not sorted
+  --length N           word length for count (default: 10)
+  --limit N            number of words for enumerate (default: 10)
+  --modulus M          count modulo M instead of exactly
+  --strategy NAME      auto|hopcroft|brzozowski for minimize/bench (default: auto)
+  -h, --help           show this message
+)";
+
+const std::map<std::string, Command> COMMANDS = {
+	{"determinize", Command::DETERMINIZE},
+	{"minimize", Command::MINIMIZE},
+	{"match", Command::MATCH},
+	{"search", Command::SEARCH},
+	{"bench", Command::BENCH},
+	{"dictionary", Command::DICTIONARY},
+	{"count", Command::COUNT},
+	{"enumerate", Command::ENUMERATE},
+	{"help", Command::HELP},
+	{"-h", Command::HELP},
+	{"--help", Command::HELP},
+};
+
+void AssertHasValue(int index, int argc, const std::string& option)
+{
+	if (index + 1 >= argc)
+	{
+		throw std::invalid_argument("Option " + option + " requires a value");
+	}
+}
+
+unsigned long long ParseNumber(const std::string& value, const std::string& option)
+{
+	std::size_t parsed = 0;
+	unsigned long long number = 0;
+	try
+	{
+		number = value.starts_with('-') ? 0 : std::stoull(value, &parsed);
+	}
+	catch (const std::out_of_range&)
+	{
+		throw std::invalid_argument("Option " + option + " value is too large: " + value);
+	}
+	catch (const std::invalid_argument&)
+	{
+		parsed = 0;
+	}
+	if (value.empty() || parsed != value.size())
+	{
+		throw std::invalid_argument("Option " + option + " requires a non-negative number, got '" + value + "'");
+	}
+	return number;
+}
+
+unsigned long long ParsePositive(const std::string& value, const std::string& option)
+{
+	const auto number = ParseNumber(value, option);
+	if (number == 0)
+	{
+		throw std::invalid_argument("Option " + option + " requires a positive number");
+	}
+	return number;
+}
+
+unsigned ParseThreadCount(const std::string& value, const std::string& option)
+{
+	const auto number = ParsePositive(value, option);
+	if (number > MAX_THREADS)
+	{
+		throw std::invalid_argument("Option " + option + " allows at most " + std::to_string(MAX_THREADS) + " threads");
+	}
+	return static_cast<unsigned>(number);
+}
+
+AutomatonFormat ParseFormat(const std::string& value)
+{
+	if (value == "dot")
+	{
+		return AutomatonFormat::DOT;
+	}
+	if (value == "binary")
+	{
+		return AutomatonFormat::BINARY;
+	}
+	throw std::invalid_argument("Unknown format '" + value + "'");
+}
+
+MinimizationStrategy ParseStrategy(const std::string& value)
+{
+	if (value == "auto")
+	{
+		return MinimizationStrategy::AUTO;
+	}
+	if (value == "hopcroft")
+	{
+		return MinimizationStrategy::HOPCROFT;
+	}
+	if (value == "brzozowski")
+	{
+		return MinimizationStrategy::BRZOZOWSKI;
+	}
+	throw std::invalid_argument("Unknown minimization strategy '" + value + "'");
+}
+
+void AssertIsOptionsValid(const CommandLineOptions& options)
+{
+	if (options.command == Command::HELP)
+	{
+		return;
+	}
+	if (options.inputPath.empty() && options.command != Command::DICTIONARY)
+	{
+		throw std::invalid_argument("Input automaton is required (-i FILE)");
+	}
+	if (options.outputFormat == AutomatonFormat::BINARY && options.outputPath.empty())
+	{
+		throw std::invalid_argument("Binary output requires an output file (-o FILE)");
+	}
+}
+} // namespace
+
+CommandLineOptions CommandLineParser::Parse(int argc, const char* const argv[])
+{
+	CommandLineOptions options;
+	if (argc < 2)
+	{
+		return options;
+	}
+
+	const auto command = COMMANDS.find(argv[1]);
+	if (command == COMMANDS.end())
+	{
+		throw std::invalid_argument("Unknown command '" + std::string(argv[1]) + "'");
+	}
+	options.command = command->second;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		if (option == "--stats")
+		{
+			options.stats = true;
+			continue;
+		}
+		if (option == "--log")
+		{
+			options.logSteps = true;
+			continue;
+		}
+		if (option == "--reduce")
+		{
+			options.reduce = true;
+			continue;
+		}
+		if (option == "--unsorted")
+		{
+			options.unsorted = true;
+			continue;
+		}
+		if (option == "-h" || option == "--help")
+		{
+			options.command = Command::HELP;
+			return options;
+		}
+
+		AssertHasValue(i, argc, option);
+		const std::string value = argv[++i];
+
+		if (option == "-i" || option == "--input")
+		{
+			options.inputPath = value;
+		}
+		else if (option == "-o" || option == "--output")
+		{
+			options.outputPath = value;
+		}
+		else if (option == "--format")
+		{
+			options.outputFormat = ParseFormat(value);
+		}
+		else if (option == "--strategy")
+		{
+			options.strategy = ParseStrategy(value);
+		}
+		else if (option == "-w" || option == "--words")
+		{
+			options.wordsPath = value;
+			options.hasWords = true;
+		}
+		else if (option == "--threads")
+		{
+			options.threads = ParseThreadCount(value, option);
+		}
+		else if (option == "--distance")
+		{
+			options.distance = ParseNumber(value, option);
+		}
+		else if (option == "--repeat")
+		{
+			options.repeat = ParsePositive(value, option);
+		}
+		else if (option == "--length")
+		{
+			options.length = ParseNumber(value, option);
+		}
+		else if (option == "--limit")
+		{
+			options.limit = ParsePositive(value, option);
+		}
+		else if (option == "--modulus")
+		{
+			options.modulus = ParsePositive(value, option);
+		}
+		else
+		{
+			throw std::invalid_argument("Unknown option '" + option + "'");
+		}
+	}
+
+	AssertIsOptionsValid(options);
+	return options;
+}
+
+const std::string& CommandLineParser::Usage()
+{
+	return USAGE;
+}
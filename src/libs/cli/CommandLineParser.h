@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MinimizationAlgorithm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class Command
+{
+	DETERMINIZE,
+	MINIMIZE,
+	MATCH,
+	SEARCH,
+	BENCH,
+	DICTIONARY,
+	COUNT,
+	ENUMERATE,
+	HELP
+};
+
+enum class AutomatonFormat
+{
+	DOT,
+	BINARY
+};
+
+struct CommandLineOptions
+{
+	Command command = Command::HELP;
+	std::string inputPath;
+	// Пустой путь - вывод в stdout (только для .dot)
+	std::string outputPath;
+	AutomatonFormat outputFormat = AutomatonFormat::DOT;
+	// Слова или текст построчно, "-" - stdin
+	std::string wordsPath = "-";
+	bool hasWords = false;
+	unsigned threads = 1;
+	// Допустимое расстояние Левенштейна для match, 0 - точное совпадение
+	std::size_t distance = 0;
+	std::size_t repeat = 1;
+	bool stats = false;
+	bool logSteps = false;
+	// Слияние бисимилярных состояний НКА перед остальными шагами
+	bool reduce = false;
+	MinimizationStrategy strategy = MinimizationStrategy::AUTO;
+	// Слова словаря не отсортированы
+	bool unsorted = false;
+	// Длина слов для count и число слов для enumerate
+	std::size_t length = 10;
+	std::size_t limit = 10;
+	// 0 - точный подсчет
+	std::uint64_t modulus = 0;
+};
+
+class CommandLineParser
+{
+public:
+	static CommandLineOptions Parse(int argc, const char* const argv[]);
+	static const std::string& Usage();
+};
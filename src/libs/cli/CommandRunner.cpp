@@ -0,0 +1,491 @@
+#include "CommandRunner.h"
+
+#include "AutomatonBuilder.h"
+#include "AutomatonSerializer.h"
+#include "ApproximateMatcher.h"
+#include "AutomatonVisualizer.h"
+#include "BisimulationAlgorithm.h"
+#include "CompiledDfa.h"
+#include "DictionaryBuilder.h"
+#include "DeterminizationAlgorithm.h"
+#include "EpsilonEliminationAlgorithm.h"
+#include "MinimizationAlgorithm.h"
+#include "WordCounter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <optional>
+#include <thread>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMilliseconds(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void AssertIsFileOpen(const std::ifstream& file)
+{
+	if (!file.is_open())
+	{
+		throw std::invalid_argument("The file cannot be opened");
+	}
+}
+
+// Делит [0, count) на непрерывные куски по числу потоков
+void RunParallel(std::size_t count, unsigned threads, const std::function<void(std::size_t, std::size_t)>& work)
+{
+	threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+	if (threads <= 1)
+	{
+		work(0, count);
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	workers.reserve(threads);
+	const std::size_t chunk = (count + threads - 1) / threads;
+	for (unsigned i = 0; i < threads; ++i)
+	{
+		const std::size_t begin = std::min(count, i * chunk);
+		const std::size_t end = std::min(count, begin + chunk);
+		workers.emplace_back(work, begin, end);
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+std::size_t TotalBytes(const std::vector<std::string>& lines)
+{
+	std::size_t bytes = 0;
+	for (const auto& line : lines)
+	{
+		bytes += line.size();
+	}
+	return bytes;
+}
+
+void PrintThroughput(std::ostream& log, const std::string& label, std::size_t items, std::size_t bytes, double milliseconds)
+{
+	const double seconds = std::max(milliseconds, 1e-6) / 1000.0;
+	log << std::fixed << std::setprecision(3)
+		<< label << ": " << items << " lines, " << bytes << " bytes in " << milliseconds << " ms"
+		<< " (" << items / seconds << " lines/s, " << bytes / seconds / (1024.0 * 1024.0) << " MiB/s)"
+		<< std::defaultfloat << std::endl;
+}
+
+// Замыкания вычисляются один раз для всего пакета слов, а не на каждом символе
+Automaton PrepareForRecognition(Automaton automaton)
+{
+	if (automaton.HasEpsilonTransitions())
+	{
+		return EpsilonEliminationAlgorithm::RemoveEpsilon(automaton);
+	}
+	return automaton;
+}
+
+// Число состояний входа запоминается заранее, если вход отдан алгоритму через std::move
+void PrintStates(std::ostream& log, const std::string& label, std::size_t fromStateCount, const Automaton& to, double milliseconds)
+{
+	log << std::fixed << std::setprecision(3)
+		<< label << ": " << fromStateCount << " -> " << to.GetStates().size()
+		<< " states in " << milliseconds << " ms" << std::defaultfloat << std::endl;
+}
+
+void PrintStates(std::ostream& log, const std::string& label, const Automaton& from, const Automaton& to, double milliseconds)
+{
+	PrintStates(log, label, from.GetStates().size(), to, milliseconds);
+}
+} // namespace
+
+CommandRunner::CommandRunner(const CommandLineOptions& options, std::istream& input, std::ostream& output, std::ostream& log)
+	: m_options(options)
+	, m_input(input)
+	, m_output(output)
+	, m_log(log)
+{
+}
+
+void CommandRunner::Run()
+{
+	switch (m_options.command)
+	{
+	case Command::DETERMINIZE:
+		Determinize();
+		break;
+	case Command::MINIMIZE:
+		Minimize();
+		break;
+	case Command::MATCH:
+		Match();
+		break;
+	case Command::SEARCH:
+		Search();
+		break;
+	case Command::BENCH:
+		Bench();
+		break;
+	case Command::DICTIONARY:
+		Dictionary();
+		break;
+	case Command::COUNT:
+		Count();
+		break;
+	case Command::ENUMERATE:
+		Enumerate();
+		break;
+	case Command::HELP:
+		m_output << CommandLineParser::Usage();
+		break;
+	}
+}
+
+Automaton CommandRunner::LoadAutomaton(const std::string& path)
+{
+	if (AutomatonSerializer::IsBinaryFile(path))
+	{
+		return AutomatonSerializer::FromBinaryFile(path);
+	}
+	return AutomatonBuilder::FromFile(path);
+}
+
+void CommandRunner::Determinize()
+{
+	auto nfa = LoadInput();
+
+	DeterminizationStats stats;
+	const std::size_t stateCount = nfa.GetStates().size();
+	const auto start = Clock::now();
+	const auto dfa = DeterminizationAlgorithm::Determine(std::move(nfa), m_options.logSteps, &stats);
+	PrintStates(m_log, "determinize", stateCount, dfa, ElapsedMilliseconds(start));
+
+	if (m_options.stats)
+	{
+		m_log << stats.ToJson() << std::endl;
+	}
+	SaveAutomaton(dfa);
+}
+
+void CommandRunner::Minimize()
+{
+	auto input = LoadInput();
+	if (ResolveStrategy(input) == MinimizationStrategy::BRZOZOWSKI)
+	{
+		MinimizationStats stats;
+		const auto start = Clock::now();
+		const auto minimized = MinimizationAlgorithm::MinimizeBrzozowski(input, &stats);
+		PrintStates(m_log, "brzozowski", input, minimized, ElapsedMilliseconds(start));
+		if (m_options.stats)
+		{
+			m_log << stats.ToJson() << std::endl;
+		}
+		SaveAutomaton(minimized);
+		return;
+	}
+
+	auto automaton = ToDeterministic(std::move(input));
+	MinimizationStats stats;
+	const std::size_t stateCount = automaton.GetStates().size();
+	const auto start = Clock::now();
+	// Таблицы итераций есть только у проходов Мура, без --log работает алгоритм Хопкрофта
+	const auto minimized = m_options.logSteps
+		? MinimizationAlgorithm::Minimize(std::move(automaton), true, &stats)
+		: MinimizationAlgorithm::MinimizeHopcroft(std::move(automaton), &stats);
+	PrintStates(m_log, "minimize", stateCount, minimized, ElapsedMilliseconds(start));
+
+	if (m_options.stats)
+	{
+		m_log << stats.ToJson() << std::endl;
+	}
+	SaveAutomaton(minimized);
+}
+
+void CommandRunner::Match()
+{
+	const auto automaton = PrepareForRecognition(LoadInput());
+	const auto words = ReadLines();
+	std::vector<char> results(words.size(), 0);
+
+	// ДКА распознаем по плотной таблице с ранним отказом в мертвых состояниях
+	std::optional<CompiledDfa> compiled;
+	std::optional<ApproximateMatcher> approximate;
+	if (m_options.distance > 0)
+	{
+		approximate.emplace(automaton);
+	}
+	else if (automaton.IsDeterministic())
+	{
+		compiled.emplace(automaton);
+	}
+
+	auto recognize = [&](const std::string& word) {
+		if (approximate)
+		{
+			return approximate->Matches(word, m_options.distance);
+		}
+		return compiled ? compiled->Recognize(word) : automaton.Recognize(word);
+	};
+
+	const auto start = Clock::now();
+	RunParallel(words.size(), m_options.threads, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			results[i] = recognize(words[i]);
+		}
+	});
+	const double elapsed = ElapsedMilliseconds(start);
+
+	for (std::size_t i = 0; i < words.size(); ++i)
+	{
+		m_output << (results[i] ? "[true] " : "[false]") << "\t" << words[i] << "\n";
+	}
+	m_output.flush();
+
+	const auto accepted = std::count(results.begin(), results.end(), 1);
+	m_log << "accepted: " << accepted << " of " << words.size() << std::endl;
+	PrintThroughput(m_log, "match", words.size(), TotalBytes(words), elapsed);
+}
+
+void CommandRunner::Search()
+{
+	const auto automaton = PrepareForRecognition(LoadInput());
+	const auto lines = ReadLines();
+	std::vector<char> found(lines.size(), 0);
+
+	const auto start = Clock::now();
+	RunParallel(lines.size(), m_options.threads, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			found[i] = automaton.Search(lines[i]).has_value();
+		}
+	});
+	const double elapsed = ElapsedMilliseconds(start);
+
+	for (std::size_t i = 0; i < lines.size(); ++i)
+	{
+		if (found[i])
+		{
+			m_output << i + 1 << ":" << lines[i] << "\n";
+		}
+	}
+	m_output.flush();
+
+	PrintThroughput(m_log, "search", lines.size(), TotalBytes(lines), elapsed);
+}
+
+void CommandRunner::Bench()
+{
+	const auto automaton = LoadInput();
+	const std::vector<std::string> words = m_options.hasWords ? ReadLines() : std::vector<std::string>{};
+	const auto strategy = ResolveStrategy(automaton);
+
+	for (std::size_t run = 1; run <= m_options.repeat; ++run)
+	{
+		m_log << "run " << run << std::endl;
+
+		Automaton minimized;
+		auto start = Clock::now();
+		if (strategy == MinimizationStrategy::BRZOZOWSKI)
+		{
+			MinimizationStats minimizationStats;
+			minimized = MinimizationAlgorithm::MinimizeBrzozowski(automaton, &minimizationStats);
+			PrintStates(m_log, "brzozowski", automaton, minimized, ElapsedMilliseconds(start));
+			if (m_options.stats)
+			{
+				m_log << minimizationStats.ToJson() << std::endl;
+			}
+		}
+		else
+		{
+			DeterminizationStats determinizationStats;
+			auto dfa = DeterminizationAlgorithm::Determine(automaton, false, &determinizationStats);
+			PrintStates(m_log, "determinize", automaton, dfa, ElapsedMilliseconds(start));
+
+			MinimizationStats minimizationStats;
+			const std::size_t dfaStateCount = dfa.GetStates().size();
+			start = Clock::now();
+			minimized = MinimizationAlgorithm::MinimizeHopcroft(std::move(dfa), &minimizationStats);
+			PrintStates(m_log, "minimize", dfaStateCount, minimized, ElapsedMilliseconds(start));
+
+			if (m_options.stats)
+			{
+				m_log << determinizationStats.ToJson() << std::endl;
+				m_log << minimizationStats.ToJson() << std::endl;
+			}
+		}
+
+		if (words.empty())
+		{
+			continue;
+		}
+
+		const CompiledDfa compiled(minimized);
+		start = Clock::now();
+		RunParallel(words.size(), m_options.threads, [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				compiled.Recognize(words[i]);
+			}
+		});
+		PrintThroughput(m_log, "match", words.size(), TotalBytes(words), ElapsedMilliseconds(start));
+	}
+}
+
+Automaton CommandRunner::LoadInput()
+{
+	auto automaton = LoadAutomaton(m_options.inputPath);
+	if (!m_options.reduce)
+	{
+		return automaton;
+	}
+
+	const auto start = Clock::now();
+	auto reduced = BisimulationAlgorithm::Reduce(automaton);
+	PrintStates(m_log, "reduce", automaton, reduced, ElapsedMilliseconds(start));
+	return reduced;
+}
+
+// Слова читаются потоком, в памяти остается только строящийся автомат
+void CommandRunner::Dictionary()
+{
+	std::ifstream file;
+	std::istream& words = OpenWords(file);
+
+	const auto start = Clock::now();
+	const auto dictionary = DictionaryBuilder::FromStream(words, !m_options.unsorted);
+	m_log << std::fixed << std::setprecision(3)
+		<< "dictionary: " << dictionary.GetStates().size() << " states in " << ElapsedMilliseconds(start) << " ms"
+		<< std::defaultfloat << std::endl;
+
+	SaveAutomaton(dictionary);
+}
+
+void CommandRunner::Count()
+{
+	const WordCounter counter(LoadInput());
+	const auto length = m_options.length;
+
+	const auto start = Clock::now();
+	if (m_options.modulus != 0)
+	{
+		m_output << "length " << length << ": " << counter.CountWords(length, m_options.modulus)
+			<< " (mod " << m_options.modulus << ")\n";
+		m_output << "up to " << length << ": " << counter.CountWordsUpTo(length, m_options.modulus)
+			<< " (mod " << m_options.modulus << ")\n";
+	}
+	else
+	{
+		m_output << "length " << length << ": " << counter.CountWords(length).ToString() << "\n";
+		m_output << "up to " << length << ": " << counter.CountWordsUpTo(length).ToString() << "\n";
+	}
+
+	const auto shortest = counter.GetShortestWord();
+	m_output << "shortest: " << (shortest ? "\"" + *shortest + "\"" : "none") << std::endl;
+	m_log << std::fixed << std::setprecision(3)
+		<< "count: " << counter.GetStateCount() << " states in " << ElapsedMilliseconds(start) << " ms"
+		<< std::defaultfloat << std::endl;
+}
+
+void CommandRunner::Enumerate()
+{
+	const WordCounter counter(LoadInput());
+	auto enumerator = counter.Enumerate();
+	for (std::size_t i = 0; i < m_options.limit; ++i)
+	{
+		const auto word = enumerator.Next();
+		if (!word)
+		{
+			break;
+		}
+		m_output << *word << "\n";
+	}
+	m_output.flush();
+}
+
+MinimizationStrategy CommandRunner::ResolveStrategy(const Automaton& automaton)
+{
+	if (m_options.strategy != MinimizationStrategy::AUTO)
+	{
+		return m_options.strategy;
+	}
+
+	const auto start = Clock::now();
+	const auto strategy = MinimizationAlgorithm::ChooseStrategy(automaton);
+	m_log << std::fixed << std::setprecision(3)
+		<< "strategy: " << (strategy == MinimizationStrategy::BRZOZOWSKI ? "brzozowski" : "hopcroft")
+		<< " chosen in " << ElapsedMilliseconds(start) << " ms" << std::defaultfloat << std::endl;
+	return strategy;
+}
+
+Automaton CommandRunner::ToDeterministic(Automaton automaton)
+{
+	if (automaton.IsDeterministic())
+	{
+		return automaton;
+	}
+
+	DeterminizationStats stats;
+	const std::size_t stateCount = automaton.GetStates().size();
+	const auto start = Clock::now();
+	auto dfa = DeterminizationAlgorithm::Determine(std::move(automaton), m_options.logSteps, &stats);
+	PrintStates(m_log, "determinize", stateCount, dfa, ElapsedMilliseconds(start));
+
+	if (m_options.stats)
+	{
+		m_log << stats.ToJson() << std::endl;
+	}
+	return dfa;
+}
+
+void CommandRunner::SaveAutomaton(const Automaton& automaton)
+{
+	if (m_options.outputFormat == AutomatonFormat::BINARY)
+	{
+		AutomatonSerializer::ToBinaryFile(automaton, m_options.outputPath);
+	}
+	else if (m_options.outputPath.empty())
+	{
+		AutomatonVisualizer::ExportToDot(automaton, m_output, "result");
+	}
+	else
+	{
+		AutomatonVisualizer::ExportToDot(automaton, m_options.outputPath);
+	}
+}
+
+std::istream& CommandRunner::OpenWords(std::ifstream& file)
+{
+	if (m_options.wordsPath == "-")
+	{
+		return m_input;
+	}
+
+	file.open(m_options.wordsPath);
+	AssertIsFileOpen(file);
+	return file;
+}
+
+std::vector<std::string> CommandRunner::ReadLines()
+{
+	std::ifstream file;
+	std::istream& input = OpenWords(file);
+
+	std::vector<std::string> lines;
+	std::string line;
+	while (std::getline(input, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		lines.push_back(std::move(line));
+	}
+	return lines;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Automaton.h"
+#include "CommandLineParser.h"
+
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Выполняет команду CLI. Результаты пишутся в output, сводки и статистика - в log,
+// чтобы stdout оставался пригодным для конвейеров
+class CommandRunner
+{
+public:
+	CommandRunner(const CommandLineOptions& options, std::istream& input, std::ostream& output, std::ostream& log);
+
+	void Run();
+
+	static Automaton LoadAutomaton(const std::string& path);
+
+private:
+	void Determinize();
+	void Minimize();
+	void Match();
+	void Search();
+	void Bench();
+	void Dictionary();
+	void Count();
+	void Enumerate();
+
+	Automaton LoadInput();
+	MinimizationStrategy ResolveStrategy(const Automaton& automaton);
+	Automaton ToDeterministic(Automaton automaton);
+	void SaveAutomaton(const Automaton& automaton);
+	std::istream& OpenWords(std::ifstream& file);
+	std::vector<std::string> ReadLines();
+
+	const CommandLineOptions& m_options;
+	std::istream& m_input;
+	std::ostream& m_output;
+	std::ostream& m_log;
+};
@@ -0,0 +1,371 @@
+#include "AutomatonGenerator.h"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Сначала читаемые символы, затем остальные байты
+constexpr std::string_view READABLE_ALPHABET = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+constexpr unsigned BYTE_COUNT = 256;
+constexpr unsigned MAX_DE_BRUIJN_ORDER = 30;
+
+// SplitMix64: одинаковая последовательность на любой платформе и стандартной библиотеке,
+// в отличие от std::uniform_*_distribution
+class SplitMix64
+{
+public:
+	explicit SplitMix64(std::uint64_t seed)
+		: m_state(seed)
+	{
+	}
+
+	std::uint64_t Next()
+	{
+		std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Равномерно в [0, bound), bound > 0. Метод Лемира: старшая половина Next() * bound, а младшая
+	// отбрасывает значения, из-за которых часть результатов выпадала бы на одно значение чаще
+	std::uint64_t NextBelow(std::uint64_t bound)
+	{
+		auto [high, low] = MultiplyWide(Next(), bound);
+		if (low < bound)
+		{
+			const std::uint64_t threshold = (0 - bound) % bound;
+			while (low < threshold)
+			{
+				std::tie(high, low) = MultiplyWide(Next(), bound);
+			}
+		}
+		return high;
+	}
+
+	// Равномерно в [0, 1)
+	double NextUnit()
+	{
+		return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+	}
+
+	bool NextBool(double probability)
+	{
+		return NextUnit() < probability;
+	}
+
+private:
+	// Полное 128-битное произведение (старшая и младшая половины) на 32-битных частях, без расширений компилятора
+	static std::pair<std::uint64_t, std::uint64_t> MultiplyWide(std::uint64_t left, std::uint64_t right)
+	{
+		constexpr std::uint64_t LOW_MASK = 0xFFFFFFFFull;
+		const std::uint64_t lowLow = (left & LOW_MASK) * (right & LOW_MASK);
+		const std::uint64_t highLow = (left >> 32) * (right & LOW_MASK);
+		const std::uint64_t lowHigh = (left & LOW_MASK) * (right >> 32);
+		const std::uint64_t highHigh = (left >> 32) * (right >> 32);
+		const std::uint64_t middle = (lowLow >> 32) + (highLow & LOW_MASK) + lowHigh;
+		return {highHigh + (highLow >> 32) + (middle >> 32), left * right};
+	}
+
+	std::uint64_t m_state;
+};
+
+void AssertIsRatioValid(double value, const std::string& name)
+{
+	if (value < 0.0 || value > 1.0)
+	{
+		throw std::invalid_argument(name + " must be in [0, 1]");
+	}
+}
+
+void AssertIsParamsValid(const RandomAutomatonParams& params)
+{
+	if (params.stateCount == 0)
+	{
+		throw std::invalid_argument("State count must be positive");
+	}
+	if (params.alphabetSize == 0 || params.alphabetSize > AutomatonGenerator::MaxAlphabetSize())
+	{
+		throw std::invalid_argument("Alphabet size must be in [1, " + std::to_string(AutomatonGenerator::MaxAlphabetSize()) + "]");
+	}
+	if (params.density < 0.0)
+	{
+		throw std::invalid_argument("Density must be non-negative");
+	}
+	AssertIsRatioValid(params.finalRatio, "Final ratio");
+	AssertIsRatioValid(params.epsilonRatio, "Epsilon ratio");
+	if (params.epsilonRatio >= 1.0)
+	{
+		throw std::invalid_argument("Epsilon ratio must be less than 1");
+	}
+}
+
+void EmitStartAndFinals(const RandomAutomatonParams& params, SplitMix64& random, AutomatonSink& sink)
+{
+	sink.SetStartState(0);
+	bool hasFinal = false;
+	for (State state = 0; state < params.stateCount; ++state)
+	{
+		if (random.NextBool(params.finalRatio))
+		{
+			sink.AddFinalState(state);
+			hasFinal = true;
+		}
+	}
+
+	// Пустой язык неинтересен для нагрузочных тестов
+	if (!hasFinal && params.finalRatio > 0.0)
+	{
+		sink.AddFinalState(params.stateCount - 1);
+	}
+}
+
+// Число переходов с дробным средним: целая часть плюс один переход с вероятностью дробной
+unsigned SampleCount(double mean, SplitMix64& random)
+{
+	const auto whole = static_cast<unsigned>(mean);
+	return whole + (random.NextBool(mean - whole) ? 1 : 0);
+}
+
+std::vector<bool> DeBruijnSequence(unsigned order)
+{
+	// Последовательность Линдона (алгоритм FKM) для двоичного алфавита
+	std::vector<bool> sequence;
+	sequence.reserve(std::size_t{1} << order);
+	std::vector<unsigned> word(order + 1, 0);
+
+	unsigned length = 1;
+	while (true)
+	{
+		if (order % length == 0)
+		{
+			for (unsigned i = 1; i <= length; ++i)
+			{
+				sequence.push_back(word[i] == 1);
+			}
+		}
+
+		length = order;
+		while (length > 0 && word[length] == 1)
+		{
+			--length;
+		}
+		if (length == 0)
+		{
+			break;
+		}
+
+		++word[length];
+		for (unsigned i = length + 1; i <= order; ++i)
+		{
+			word[i] = word[i - length];
+		}
+	}
+
+	return sequence;
+}
+
+std::array<Symbol, BYTE_COUNT> BuildAlphabet()
+{
+	std::array<Symbol, BYTE_COUNT> alphabet{};
+	std::array<bool, BYTE_COUNT> used{};
+	unsigned size = 0;
+	for (const char symbol : READABLE_ALPHABET)
+	{
+		alphabet[size++] = static_cast<Symbol>(symbol);
+		used[static_cast<Symbol>(symbol)] = true;
+	}
+	for (unsigned byte = 0; byte < BYTE_COUNT; ++byte)
+	{
+		if (!used[byte])
+		{
+			alphabet[size++] = static_cast<Symbol>(byte);
+		}
+	}
+	return alphabet;
+}
+
+template <typename Generate>
+Automaton Build(const std::string& title, Generate&& generate)
+{
+	Automaton automaton;
+	automaton.SetTitle(title);
+	AutomatonBuildSink sink(automaton);
+	generate(sink);
+	return automaton;
+}
+} // namespace
+
+unsigned AutomatonGenerator::MaxAlphabetSize()
+{
+	return BYTE_COUNT;
+}
+
+Symbol AutomatonGenerator::AlphabetSymbol(const unsigned index)
+{
+	static const auto alphabet = BuildAlphabet();
+	if (index >= alphabet.size())
+	{
+		throw std::out_of_range("Alphabet symbol index is out of range");
+	}
+	return alphabet[index];
+}
+
+void AutomatonGenerator::RandomNfa(const RandomAutomatonParams& params, AutomatonSink& sink)
+{
+	AssertIsParamsValid(params);
+	SplitMix64 random(params.seed);
+	EmitStartAndFinals(params, random, sink);
+
+	const double meanOutDegree = params.density * params.alphabetSize;
+	for (State from = 0; from < params.stateCount; ++from)
+	{
+		if (params.connected && from + 1 < params.stateCount)
+		{
+			sink.AddTransition(from, AlphabetSymbol(random.NextBelow(params.alphabetSize)), from + 1);
+		}
+
+		const unsigned count = SampleCount(meanOutDegree, random);
+		for (unsigned i = 0; i < count; ++i)
+		{
+			const auto to = static_cast<State>(random.NextBelow(params.stateCount));
+			if (random.NextBool(params.epsilonRatio))
+			{
+				sink.AddEpsilonTransition(from, to);
+			}
+			else
+			{
+				sink.AddTransition(from, AlphabetSymbol(random.NextBelow(params.alphabetSize)), to);
+			}
+		}
+	}
+}
+
+Automaton AutomatonGenerator::RandomNfa(const RandomAutomatonParams& params)
+{
+	return Build("RandomNfa", [&](AutomatonSink& sink) {
+		RandomNfa(params, sink);
+	});
+}
+
+void AutomatonGenerator::RandomDfa(const RandomAutomatonParams& params, AutomatonSink& sink)
+{
+	AssertIsParamsValid(params);
+	AssertIsRatioValid(params.density, "DFA density");
+	SplitMix64 random(params.seed);
+	EmitStartAndFinals(params, random, sink);
+
+	for (State from = 0; from < params.stateCount; ++from)
+	{
+		// Символ, по которому идет переход цепочки достижимости
+		const bool hasChainTransition = params.connected && from + 1 < params.stateCount;
+		const auto chainSymbol = static_cast<unsigned>(random.NextBelow(params.alphabetSize));
+
+		for (unsigned symbolIndex = 0; symbolIndex < params.alphabetSize; ++symbolIndex)
+		{
+			if (hasChainTransition && symbolIndex == chainSymbol)
+			{
+				sink.AddTransition(from, AlphabetSymbol(symbolIndex), from + 1);
+			}
+			else if (random.NextBool(params.density))
+			{
+				const auto to = static_cast<State>(random.NextBelow(params.stateCount));
+				sink.AddTransition(from, AlphabetSymbol(symbolIndex), to);
+			}
+		}
+	}
+}
+
+Automaton AutomatonGenerator::RandomDfa(const RandomAutomatonParams& params)
+{
+	return Build("RandomDfa", [&](AutomatonSink& sink) {
+		RandomDfa(params, sink);
+	});
+}
+
+void AutomatonGenerator::NthSymbolFromEnd(const unsigned n, AutomatonSink& sink)
+{
+	if (n == 0)
+	{
+		throw std::invalid_argument("Position from the end must be positive");
+	}
+
+	const Symbol a = AlphabetSymbol(0);
+	const Symbol b = AlphabetSymbol(1);
+
+	sink.SetStartState(0);
+	sink.AddFinalState(n);
+	sink.AddTransition(0, a, 0);
+	sink.AddTransition(0, b, 0);
+	sink.AddTransition(0, a, 1);
+	for (State state = 1; state < n; ++state)
+	{
+		sink.AddTransition(state, a, state + 1);
+		sink.AddTransition(state, b, state + 1);
+	}
+}
+
+Automaton AutomatonGenerator::NthSymbolFromEnd(const unsigned n)
+{
+	return Build("NthSymbolFromEnd", [&](AutomatonSink& sink) {
+		NthSymbolFromEnd(n, sink);
+	});
+}
+
+void AutomatonGenerator::DeBruijnCycle(const unsigned order, AutomatonSink& sink)
+{
+	if (order == 0 || order > MAX_DE_BRUIJN_ORDER)
+	{
+		throw std::invalid_argument("De Bruijn order must be in [1, " + std::to_string(MAX_DE_BRUIJN_ORDER) + "]");
+	}
+
+	const auto sequence = DeBruijnSequence(order);
+	const auto n = static_cast<State>(sequence.size());
+	const Symbol a = AlphabetSymbol(0);
+
+	sink.SetStartState(0);
+	for (State state = 0; state < n; ++state)
+	{
+		if (sequence[state])
+		{
+			sink.AddFinalState(state);
+		}
+		sink.AddTransition(state, a, (state + 1) % n);
+	}
+}
+
+Automaton AutomatonGenerator::DeBruijnCycle(const unsigned order)
+{
+	return Build("DeBruijnCycle", [&](AutomatonSink& sink) {
+		DeBruijnCycle(order, sink);
+	});
+}
+
+void AutomatonGenerator::Chain(const State n, AutomatonSink& sink)
+{
+	if (n == 0)
+	{
+		throw std::invalid_argument("Chain length must be positive");
+	}
+
+	const Symbol a = AlphabetSymbol(0);
+	sink.SetStartState(0);
+	sink.AddFinalState(n);
+	for (State state = 0; state < n; ++state)
+	{
+		sink.AddTransition(state, a, state + 1);
+	}
+}
+
+Automaton AutomatonGenerator::Chain(const State n)
+{
+	return Build("Chain", [&](AutomatonSink& sink) {
+		Chain(n, sink);
+	});
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Automaton.h"
+#include "AutomatonSink.h"
+
+#include <cstdint>
+
+struct RandomAutomatonParams
+{
+	// Число состояний
+	State stateCount = 100;
+	// Размер алфавита (не больше AutomatonGenerator::MaxAlphabetSize())
+	unsigned alphabetSize = 2;
+	// Среднее число переходов из состояния по одному символу (для ДКА - вероятность перехода, [0, 1])
+	double density = 1.0;
+	// Доля e-переходов среди всех переходов НКА, [0, 1)
+	double epsilonRatio = 0.0;
+	// Доля конечных состояний, [0, 1]
+	double finalRatio = 0.1;
+	// Цепочка 0 -> 1 -> ... -> n-1 гарантирует достижимость всех состояний
+	bool connected = true;
+	std::uint64_t seed = 0;
+};
+
+class AutomatonGenerator
+{
+public:
+	static unsigned MaxAlphabetSize();
+	static Symbol AlphabetSymbol(unsigned index);
+
+	// Случайный НКА с заданной плотностью и долей e-переходов
+	static void RandomNfa(const RandomAutomatonParams& params, AutomatonSink& sink);
+	static Automaton RandomNfa(const RandomAutomatonParams& params);
+
+	// Случайный (частичный) ДКА
+	static void RandomDfa(const RandomAutomatonParams& params, AutomatonSink& sink);
+	static Automaton RandomDfa(const RandomAutomatonParams& params);
+
+	// (a|b)*a(a|b)^{n-1}: n + 1 состояние НКА, 2^n состояний минимального ДКА
+	static void NthSymbolFromEnd(unsigned n, AutomatonSink& sink);
+	static Automaton NthSymbolFromEnd(unsigned n);
+
+	// Однобуквенный цикл длины 2^order, конечные состояния задаются последовательностью де Брёйна B(2, order).
+	// Худший случай для алгоритма Хопкрофта (Berstel, Carton)
+	static void DeBruijnCycle(unsigned order, AutomatonSink& sink);
+	static Automaton DeBruijnCycle(unsigned order);
+
+	// Цепочка из n переходов с единственным конечным состоянием в конце.
+	// Худший случай по числу итераций для минимизации разбиением (n - 1 проход)
+	static void Chain(State n, AutomatonSink& sink);
+	static Automaton Chain(State n);
+};
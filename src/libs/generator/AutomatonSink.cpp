@@ -0,0 +1,72 @@
+#include "AutomatonSink.h"
+#include "SymbolFormat.h"
+
+AutomatonBuildSink::AutomatonBuildSink(Automaton& automaton)
+	: m_automaton(automaton)
+{
+}
+
+void AutomatonBuildSink::SetStartState(const State startState)
+{
+	m_automaton.SetStartState(startState);
+}
+
+void AutomatonBuildSink::AddFinalState(const State finalState)
+{
+	m_automaton.AddFinalState(finalState);
+}
+
+void AutomatonBuildSink::AddTransition(const State from, const Symbol on, const State to)
+{
+	m_automaton.AddTransition(from, on, to);
+}
+
+void AutomatonBuildSink::AddEpsilonTransition(const State from, const State to)
+{
+	m_automaton.AddEpsilonTransition(from, to);
+}
+
+DotStreamSink::DotStreamSink(std::ostream& output, const std::string& title)
+	: m_output(output)
+{
+	m_output << "digraph " << title << "\n{\n";
+}
+
+DotStreamSink::~DotStreamSink()
+{
+	Close();
+}
+
+// AutomatonBuilder разбирает файл построчно, поэтому start и final
+// можно писать в любом месте, не накапливая их до конца генерации
+void DotStreamSink::SetStartState(const State startState)
+{
+	m_output << "    start = " << startState << ";\n";
+}
+
+void DotStreamSink::AddFinalState(const State finalState)
+{
+	m_output << "    final = " << finalState << ";\n";
+}
+
+void DotStreamSink::AddTransition(const State from, const Symbol on, const State to)
+{
+	m_output << "    " << from << " -> " << to << " [label = \"" << SymbolFormat::ToLabel(on) << "\"];\n";
+}
+
+void DotStreamSink::AddEpsilonTransition(const State from, const State to)
+{
+	m_output << "    " << from << " -> " << to << ";\n";
+}
+
+void DotStreamSink::Close()
+{
+	if (m_closed)
+	{
+		return;
+	}
+
+	m_output << "}\n";
+	m_output.flush();
+	m_closed = true;
+}
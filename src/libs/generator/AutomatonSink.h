@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Automaton.h"
+
+#include <ostream>
+#include <string>
+
+// Приемник состояний и переходов генератора.
+// Позволяет не держать в памяти весь автомат при генерации миллионов состояний.
+class AutomatonSink
+{
+public:
+	virtual ~AutomatonSink() = default;
+
+	virtual void SetStartState(State startState) = 0;
+	virtual void AddFinalState(State finalState) = 0;
+	virtual void AddTransition(State from, Symbol on, State to) = 0;
+	virtual void AddEpsilonTransition(State from, State to) = 0;
+};
+
+// Собирает сгенерированный автомат в Automaton
+class AutomatonBuildSink : public AutomatonSink
+{
+public:
+	explicit AutomatonBuildSink(Automaton& automaton);
+
+	void SetStartState(State startState) override;
+	void AddFinalState(State finalState) override;
+	void AddTransition(State from, Symbol on, State to) override;
+	void AddEpsilonTransition(State from, State to) override;
+
+private:
+	Automaton& m_automaton;
+};
+
+// Потоково пишет автомат в формате .dot, который читает AutomatonBuilder
+class DotStreamSink : public AutomatonSink
+{
+public:
+	DotStreamSink(std::ostream& output, const std::string& title);
+	~DotStreamSink() override;
+
+	void SetStartState(State startState) override;
+	void AddFinalState(State finalState) override;
+	void AddTransition(State from, Symbol on, State to) override;
+	void AddEpsilonTransition(State from, State to) override;
+
+	void Close();
+
+private:
+	std::ostream& m_output;
+	bool m_closed = false;
+};
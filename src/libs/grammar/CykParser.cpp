@@ -0,0 +1,323 @@
+#include "CykParser.h"
+
+#include "NormalFormAlgorithm.h"
+
+#include <algorithm>
+#include <barrier>
+#include <limits>
+#include <map>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t WORD_BITS = 64;
+constexpr std::uint32_t NO_ROW = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint32_t UNKNOWN_TERMINAL = std::numeric_limits<std::uint32_t>::max();
+
+std::uint32_t AddRow(std::vector<std::uint32_t>& rows, std::uint32_t nonTerminal, std::size_t& count)
+{
+	if (rows[nonTerminal] == NO_ROW)
+	{
+		rows[nonTerminal] = static_cast<std::uint32_t>(count++);
+	}
+	return rows[nonTerminal];
+}
+} // namespace
+
+// Строки хранятся треугольно: ends[B][i] - только слова с битами больше i, starts[C][j] - только слова с битами меньше j.
+// Это вдвое меньше полной таблицы при тех же индексах слов
+struct CykParser::Bounds
+{
+	std::size_t first = std::numeric_limits<std::size_t>::max();
+	std::size_t last = 0;
+};
+
+struct CykParser::Table
+{
+	std::size_t length;
+	std::size_t rowWords;
+	std::size_t endsRowCount;
+	std::size_t startsRowCount;
+	std::vector<std::size_t> endsOffsets;
+	std::vector<std::size_t> startsOffsets;
+	std::size_t endsBlock = 0;
+	std::size_t startsBlock = 0;
+	std::vector<Word> ends;
+	std::vector<Word> starts;
+	// Наименьший и наибольший установленный бит строки: точки разбиения ищутся только в пересечении отрезков.
+	// Биты ends добавляются по возрастанию, starts - по убыванию, поэтому границы обновляются за O(1).
+	// Границы всех строк одной позиции лежат рядом, так как ячейка перебирает их подряд
+	std::vector<Bounds> endsBounds;
+	std::vector<Bounds> startsBounds;
+
+	Table(std::size_t length, std::size_t endsRowCount, std::size_t startsRowCount)
+		: length(length)
+		, rowWords(length / WORD_BITS + 1)
+		, endsRowCount(endsRowCount)
+		, startsRowCount(startsRowCount)
+		, endsOffsets(length + 1)
+		, startsOffsets(length + 1)
+	{
+		for (std::size_t i = 0; i <= length; ++i)
+		{
+			endsOffsets[i] = endsBlock;
+			endsBlock += rowWords - i / WORD_BITS;
+			startsOffsets[i] = startsBlock;
+			startsBlock += i / WORD_BITS + 1;
+		}
+		ends.assign(endsRowCount * endsBlock, 0);
+		starts.assign(startsRowCount * startsBlock, 0);
+		endsBounds.assign(endsRowCount * (length + 1), Bounds{});
+		startsBounds.assign(startsRowCount * (length + 1), Bounds{});
+	}
+
+	void SetEnd(std::uint32_t row, std::size_t begin, std::size_t end)
+	{
+		ends[EndsBase(row, begin) + end / WORD_BITS] |= Word{1} << (end % WORD_BITS);
+		Bounds& bounds = endsBounds[begin * endsRowCount + row];
+		bounds.first = std::min(bounds.first, end);
+		bounds.last = end;
+	}
+
+	void SetStart(std::uint32_t row, std::size_t begin, std::size_t end)
+	{
+		starts[StartsBase(row, end) + begin / WORD_BITS] |= Word{1} << (begin % WORD_BITS);
+		Bounds& bounds = startsBounds[end * startsRowCount + row];
+		bounds.first = begin;
+		bounds.last = std::max(bounds.last, begin);
+	}
+
+	// Индекс нулевого слова строки, как если бы она хранилась целиком
+	std::size_t EndsBase(std::uint32_t row, std::size_t begin) const
+	{
+		return row * endsBlock + endsOffsets[begin] - begin / WORD_BITS;
+	}
+
+	std::size_t StartsBase(std::uint32_t row, std::size_t end) const
+	{
+		return row * startsBlock + startsOffsets[end];
+	}
+};
+
+CykParser::CykParser(const Grammar& grammar, unsigned threads)
+	: m_threads(std::max(threads, 1u))
+{
+	const Grammar normalForm = NormalFormAlgorithm::IsChomskyNormalForm(grammar)
+		? grammar
+		: NormalFormAlgorithm::ToChomskyNormalForm(grammar);
+	const auto& table = normalForm.GetSymbolTable();
+
+	// Нетерминалы нумеруются плотно
+	std::vector<std::uint32_t> indices(table.GetSize(), NO_ROW);
+	for (SymbolId id = 0; id < table.GetSize(); ++id)
+	{
+		if (normalForm.IsNonTerminal(id))
+		{
+			indices[id] = static_cast<std::uint32_t>(m_nonTerminalCount++);
+		}
+	}
+	m_start = indices[normalForm.GetStartSymbolId()];
+	m_endsRows.assign(m_nonTerminalCount, NO_ROW);
+	m_startsRows.assign(m_nonTerminalCount, NO_ROW);
+	AddRow(m_endsRows, m_start, m_endsRowCount);
+
+	std::vector<std::vector<BinaryRule>> binaryRules(m_nonTerminalCount);
+	for (std::size_t rule = 0; rule < normalForm.GetRuleCount(); ++rule)
+	{
+		const std::uint32_t left = indices[normalForm.GetRuleLeft(rule)[0]];
+		const auto right = normalForm.GetRuleRight(rule);
+		if (right.empty())
+		{
+			m_acceptsEmpty = true;
+		}
+		else if (right.size() == 1)
+		{
+			const auto [it, inserted] = m_terminals.try_emplace(table.GetName(right[0]), m_terminalRules.size());
+			if (inserted)
+			{
+				m_terminalRules.emplace_back();
+			}
+			m_terminalRules[it->second].push_back(left);
+		}
+		else
+		{
+			binaryRules[left].push_back({indices[right[0]], indices[right[1]]});
+			AddRow(m_endsRows, indices[right[0]], m_endsRowCount);
+			AddRow(m_startsRows, indices[right[1]], m_startsRowCount);
+		}
+	}
+
+	std::map<std::pair<std::uint32_t, std::uint32_t>, std::vector<std::uint32_t>> lefts;
+	for (std::uint32_t left = 0; left < m_nonTerminalCount; ++left)
+	{
+		for (const auto [leftChild, rightChild] : binaryRules[left])
+		{
+			auto& pairLefts = lefts[{m_endsRows[leftChild], m_startsRows[rightChild]}];
+			if (pairLefts.empty() || pairLefts.back() != left)
+			{
+				pairLefts.push_back(left);
+			}
+		}
+	}
+	for (const auto& [rows, pairLefts] : lefts)
+	{
+		m_pairs.push_back({rows.first, rows.second, m_pairLefts.size(), m_pairLefts.size() + pairLefts.size()});
+		m_pairLefts.insert(m_pairLefts.end(), pairLefts.begin(), pairLefts.end());
+	}
+}
+
+bool CykParser::Recognize(std::span<const std::string_view> tokens) const
+{
+	std::vector<std::uint32_t> terminals;
+	terminals.reserve(tokens.size());
+	for (const auto token : tokens)
+	{
+		const auto it = m_terminals.find(token);
+		terminals.push_back(it == m_terminals.end() ? UNKNOWN_TERMINAL : it->second);
+	}
+	return RecognizeTerminals(terminals);
+}
+
+bool CykParser::Recognize(std::string_view word) const
+{
+	std::vector<std::uint32_t> terminals;
+	terminals.reserve(word.size());
+	for (std::size_t i = 0; i < word.size(); ++i)
+	{
+		const auto it = m_terminals.find(word.substr(i, 1));
+		terminals.push_back(it == m_terminals.end() ? UNKNOWN_TERMINAL : it->second);
+	}
+	return RecognizeTerminals(terminals);
+}
+
+std::size_t CykParser::GetNonTerminalCount() const
+{
+	return m_nonTerminalCount;
+}
+
+bool CykParser::RecognizeTerminals(std::span<const std::uint32_t> terminals) const
+{
+	const std::size_t length = terminals.size();
+	if (length == 0)
+	{
+		return m_acceptsEmpty;
+	}
+	if (std::find(terminals.begin(), terminals.end(), UNKNOWN_TERMINAL) != terminals.end())
+	{
+		return false;
+	}
+
+	Table table(length, m_endsRowCount, m_startsRowCount);
+	for (std::size_t i = 0; i < length; ++i)
+	{
+		for (const std::uint32_t nonTerminal : m_terminalRules[terminals[i]])
+		{
+			if (m_endsRows[nonTerminal] != NO_ROW)
+			{
+				table.SetEnd(m_endsRows[nonTerminal], i, i + 1);
+			}
+			if (m_startsRows[nonTerminal] != NO_ROW)
+			{
+				table.SetStart(m_startsRows[nonTerminal], i, i + 1);
+			}
+		}
+	}
+
+	// Потоки берут начала подслов через одно и синхронизируются после каждой диагонали
+	const unsigned threads = static_cast<unsigned>(std::min<std::size_t>(m_threads, length));
+	auto fillDiagonals = [&](unsigned worker, auto&& synchronize) {
+		std::vector<char> derived(m_nonTerminalCount);
+		for (std::size_t span = 2; span <= length; ++span)
+		{
+			for (std::size_t begin = worker; begin + span <= length; begin += threads)
+			{
+				FillCell(table, begin, begin + span, derived);
+			}
+			synchronize();
+		}
+	};
+
+	if (threads <= 1)
+	{
+		fillDiagonals(0, [] {});
+	}
+	else
+	{
+		std::barrier barrier(threads);
+		std::vector<std::thread> workers;
+		workers.reserve(threads);
+		for (unsigned worker = 0; worker < threads; ++worker)
+		{
+			workers.emplace_back(fillDiagonals, worker, [&barrier] { barrier.arrive_and_wait(); });
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	const Word last = table.ends[table.EndsBase(m_endsRows[m_start], 0) + length / WORD_BITS];
+	return (last >> (length % WORD_BITS)) & 1;
+}
+
+// Запись идет только в строки ends[*][begin] и starts[*][end], которые в этой диагонали не читает никто, кроме текущей ячейки
+void CykParser::FillCell(Table& table, std::size_t begin, std::size_t end, std::vector<char>& derived) const
+{
+	const Bounds* endsBounds = table.endsBounds.data() + begin * table.endsRowCount;
+	const Bounds* startsBounds = table.startsBounds.data() + end * table.startsRowCount;
+	std::fill(derived.begin(), derived.end(), false);
+	for (const RulePair& pair : m_pairs)
+	{
+		// Пересечение отрезков пусто почти у всех пар, поэтому оно проверяется первым
+		const Bounds& leftBounds = endsBounds[pair.endsRow];
+		const Bounds& rightBounds = startsBounds[pair.startsRow];
+		const std::size_t low = std::max(leftBounds.first, rightBounds.first);
+		const std::size_t high = std::min(leftBounds.last, rightBounds.last);
+		if (low > high)
+		{
+			continue;
+		}
+
+		const auto firstLeft = m_pairLefts.begin() + pair.firstLeft;
+		const auto lastLeft = m_pairLefts.begin() + pair.lastLeft;
+		if (std::all_of(firstLeft, lastLeft, [&](std::uint32_t left) { return derived[left]; }))
+		{
+			continue;
+		}
+
+		const Word* ends = table.ends.data() + table.EndsBase(pair.endsRow, begin);
+		const Word* starts = table.starts.data() + table.StartsBase(pair.startsRow, end);
+		bool splits = false;
+		for (std::size_t word = low / WORD_BITS; word <= high / WORD_BITS && !splits; ++word)
+		{
+			splits = (ends[word] & starts[word]) != 0;
+		}
+		if (!splits)
+		{
+			continue;
+		}
+
+		for (auto it = firstLeft; it != lastLeft; ++it)
+		{
+			const std::uint32_t left = *it;
+			if (derived[left])
+			{
+				continue;
+			}
+			derived[left] = true;
+			if (m_endsRows[left] != NO_ROW)
+			{
+				table.SetEnd(m_endsRows[left], begin, end);
+			}
+			if (m_startsRows[left] != NO_ROW)
+			{
+				table.SetStart(m_startsRows[left], begin, end);
+			}
+		}
+	}
+}
+
+std::size_t CykParser::NameHash::operator()(std::string_view name) const
+{
+	return std::hash<std::string_view>{}(name);
+}
@@ -0,0 +1,700 @@
+#include "EarleyParser.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+constexpr std::uint32_t NO_LEO = std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t NOT_PREDICTED = std::numeric_limits<std::size_t>::max();
+
+std::uint64_t MakeKey(std::uint64_t high, std::uint64_t low)
+{
+	return high << 32 | low;
+}
+
+// Множество ключей с очисткой за O(1): ячейка занята, только если помечена текущим поколением.
+// Одна таблица переиспользуется для всех множеств Эрли
+class StampedSet
+{
+public:
+	void Clear()
+	{
+		++m_generation;
+		m_size = 0;
+	}
+
+	bool Insert(std::uint64_t key)
+	{
+		if (2 * (m_size + 1) > m_keys.size())
+		{
+			Grow();
+		}
+		const std::size_t mask = m_keys.size() - 1;
+		for (std::size_t slot = Hash(key) & mask;; slot = (slot + 1) & mask)
+		{
+			if (m_stamps[slot] != m_generation)
+			{
+				m_stamps[slot] = m_generation;
+				m_keys[slot] = key;
+				++m_size;
+				return true;
+			}
+			if (m_keys[slot] == key)
+			{
+				return false;
+			}
+		}
+	}
+
+private:
+	static std::size_t Hash(std::uint64_t key)
+	{
+		key *= 0x9E3779B97F4A7C15ull;
+		return static_cast<std::size_t>(key ^ (key >> 29));
+	}
+
+	void Grow()
+	{
+		std::vector<std::uint64_t> keys;
+		keys.reserve(m_size);
+		for (std::size_t slot = 0; slot < m_keys.size(); ++slot)
+		{
+			if (m_stamps[slot] == m_generation)
+			{
+				keys.push_back(m_keys[slot]);
+			}
+		}
+		m_keys.assign(std::max<std::size_t>(64, 2 * m_keys.size()), 0);
+		m_stamps.assign(m_keys.size(), 0);
+		m_size = 0;
+		for (const auto key : keys)
+		{
+			Insert(key);
+		}
+	}
+
+	std::vector<std::uint64_t> m_keys;
+	std::vector<std::uint32_t> m_stamps;
+	std::uint32_t m_generation = 1;
+	std::size_t m_size = 0;
+};
+} // namespace
+
+// Множество k - items[setOffsets[k]..setOffsets[k + 1]), его ожидающие пункты - waiting[waitingOffsets[k]..)
+struct EarleyParser::Chart
+{
+	struct Waiting
+	{
+		SymbolId symbol;
+		std::uint32_t item;
+	};
+
+	// Пункт Leo для (множество, X): единственный ожидающий X пункт penult = [B -> β • X, o] и вершина цепочки,
+	// в которую сворачиваются завершения B, затем следующего звена next и т.д.
+	struct LeoEntry
+	{
+		Item penult;
+		std::uint32_t next;
+		Item top;
+	};
+
+	std::vector<Item> items;
+	std::vector<std::size_t> setOffsets = {0};
+	std::vector<Waiting> waiting;
+	std::vector<std::size_t> waitingOffsets = {0};
+	std::vector<LeoEntry> leoEntries;
+	std::unordered_map<std::uint64_t, std::uint32_t> leoByKey;
+	// Пункты Leo, примененные в множестве k: завершения их цепочек в множество не попали
+	std::vector<std::uint32_t> leoUses;
+	std::vector<std::size_t> leoUseOffsets = {0};
+
+	std::size_t GetSetCount() const
+	{
+		return setOffsets.size() - 1;
+	}
+
+	std::span<const Waiting> GetWaiting(std::size_t set, SymbolId symbol) const
+	{
+		const auto first = waiting.begin() + static_cast<std::ptrdiff_t>(waitingOffsets[set]);
+		const auto last = waiting.begin() + static_cast<std::ptrdiff_t>(waitingOffsets[set + 1]);
+		const auto [begin, end] = std::equal_range(first, last, Waiting{symbol, 0},
+			[](const Waiting& left, const Waiting& right) { return left.symbol < right.symbol; });
+		return {begin, end};
+	}
+};
+
+// Лес строится сверху вниз по готовой таблице: узел (X, i, j) раскрывается по завершенным пунктам
+// [X -> α •, i] множества j, префикс α на [i, j) - по точкам k, где пункт с точкой перед последним символом
+// есть в множестве k, а последний символ выводит w[k..j). Завершения, пропущенные Leo, восстанавливаются
+// из цепочек только для тех множеств, которые понадобились лесу
+struct EarleyParser::ForestBuilder
+{
+	using NodeId = ParseForest::NodeId;
+
+	struct NodeKeyHash
+	{
+		std::size_t operator()(const std::pair<std::uint64_t, std::uint64_t>& key) const
+		{
+			return std::hash<std::uint64_t>{}(key.first * 0x9E3779B97F4A7C15ull ^ key.second);
+		}
+	};
+
+	static constexpr std::uint64_t INTERMEDIATE = std::uint64_t{1} << 63;
+
+	const EarleyParser& parser;
+	const Chart& chart;
+	std::span<const SymbolId> terminals;
+	// Ключи пунктов каждого множества по возрастанию, границы множеств - как в chart.items
+	std::vector<std::uint64_t> sortedItems;
+	// Обратный индекс: пункт -> множества, в которых он есть, по возрастанию
+	std::vector<std::pair<std::uint64_t, std::uint32_t>> occurrences;
+	// Завершения, пропущенные Leo, по множествам; строятся при первом обращении
+	std::vector<std::vector<std::uint64_t>> leoCompleted;
+	std::vector<char> leoExpanded;
+	std::unordered_map<std::pair<std::uint64_t, std::uint64_t>, NodeId, NodeKeyHash> nodes;
+	std::vector<NodeId> pending;
+	ParseForest forest;
+
+	ForestBuilder(const EarleyParser& parser, const Chart& chart, std::span<const SymbolId> terminals)
+		: parser(parser)
+		, chart(chart)
+		, terminals(terminals)
+		, leoCompleted(chart.GetSetCount())
+		, leoExpanded(chart.GetSetCount(), false)
+	{
+		sortedItems.reserve(chart.items.size());
+		occurrences.reserve(chart.items.size());
+		for (std::size_t set = 0; set < chart.GetSetCount(); ++set)
+		{
+			for (std::size_t i = chart.setOffsets[set]; i < chart.setOffsets[set + 1]; ++i)
+			{
+				const std::uint64_t key = MakeKey(chart.items[i].state, chart.items[i].origin);
+				sortedItems.push_back(key);
+				occurrences.emplace_back(key, static_cast<std::uint32_t>(set));
+			}
+			std::sort(sortedItems.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[set]), sortedItems.end());
+		}
+		std::sort(occurrences.begin(), occurrences.end());
+		nodes.reserve(chart.items.size());
+	}
+
+	ParseForest Build()
+	{
+		forest.SetRoot(GetSymbolNode(parser.m_start, 0, terminals.size()));
+		std::vector<ParseForest::PackedNode> packed;
+		while (!pending.empty())
+		{
+			const NodeId node = pending.back();
+			pending.pop_back();
+			const ParseForest::Node current = forest.GetNode(node);
+
+			packed.clear();
+			if (current.symbol == NO_SYMBOL)
+			{
+				ExpandPrefix(current.rule, current.dot, current.begin, current.end, packed);
+			}
+			else
+			{
+				for (std::size_t i = parser.m_rulesByLeftOffsets[current.symbol];
+					 i < parser.m_rulesByLeftOffsets[current.symbol + 1]; ++i)
+				{
+					const std::size_t rule = parser.m_rulesByLeft[i];
+					if (IsCompleted(current.end, parser.GetCompletedState(rule), current.begin))
+					{
+						ExpandPrefix(rule, parser.GetRuleLength(rule), current.begin, current.end, packed);
+					}
+				}
+			}
+			forest.SetPacked(node, packed);
+		}
+		return std::move(forest);
+	}
+
+	// Варианты разбора префикса длины dot правила rule на [begin, end)
+	void ExpandPrefix(std::size_t rule, std::size_t dot, std::size_t begin, std::size_t end,
+		std::vector<ParseForest::PackedNode>& packed)
+	{
+		if (dot == 0)
+		{
+			packed.push_back({rule, begin, ParseForest::NO_NODE, ParseForest::NO_NODE});
+			return;
+		}
+
+		const StateId before = parser.m_ruleStates[rule] + static_cast<StateId>(dot - 1);
+		const SymbolId last = parser.m_stateNext[before];
+		auto addPivot = [&](std::size_t pivot) {
+			if (!Contains(pivot, before, begin))
+			{
+				return;
+			}
+			NodeId left = ParseForest::NO_NODE;
+			if (dot == 2)
+			{
+				left = GetSymbolNode(parser.m_stateNext[before - 1], begin, pivot);
+			}
+			else if (dot > 2)
+			{
+				left = GetIntermediateNode(rule, dot - 1, begin, pivot);
+			}
+			packed.push_back({rule, pivot, left, GetSymbolNode(last, pivot, end)});
+		};
+
+		if (parser.m_isTerminal[last])
+		{
+			if (end > begin && terminals[end - 1] == last)
+			{
+				addPivot(end - 1);
+			}
+			return;
+		}
+
+		// Точки разбиения перебираются по меньшему из списков: множества с пунктом перед последним символом
+		// или начала завершений последнего символа. Для правой рекурсии первый список из одного элемента
+		const std::uint64_t beforeKey = MakeKey(before, begin);
+		const auto first = std::lower_bound(occurrences.begin(), occurrences.end(), std::pair(beforeKey, std::uint32_t{0}));
+		const auto bound = std::upper_bound(first, occurrences.end(), std::pair(beforeKey, static_cast<std::uint32_t>(end)));
+		const auto rules = std::span(parser.m_rulesByLeft)
+			.subspan(parser.m_rulesByLeftOffsets[last], parser.m_rulesByLeftOffsets[last + 1] - parser.m_rulesByLeftOffsets[last]);
+		const auto firstRule = rules.begin();
+		const auto lastRule = rules.end();
+		std::size_t completedCount = 0;
+		for (auto rule = firstRule; rule != lastRule; ++rule)
+		{
+			completedCount += CountOrigins(end, parser.GetCompletedState(*rule), begin);
+		}
+
+		if (static_cast<std::size_t>(bound - first) <= completedCount)
+		{
+			for (auto occurrence = first; occurrence != bound; ++occurrence)
+			{
+				const std::size_t pivot = occurrence->second;
+				if (std::any_of(firstRule, lastRule, [&](std::uint32_t rule) {
+						return IsCompleted(end, parser.GetCompletedState(rule), pivot);
+					}))
+				{
+					addPivot(pivot);
+				}
+			}
+			return;
+		}
+
+		std::vector<std::size_t> pivots;
+		for (auto rule = firstRule; rule != lastRule; ++rule)
+		{
+			CollectOrigins(end, parser.GetCompletedState(*rule), begin, pivots);
+		}
+		std::sort(pivots.begin(), pivots.end());
+		pivots.erase(std::unique(pivots.begin(), pivots.end()), pivots.end());
+		for (const auto pivot : pivots)
+		{
+			addPivot(pivot);
+		}
+	}
+
+	NodeId GetSymbolNode(SymbolId symbol, std::size_t begin, std::size_t end)
+	{
+		return GetNode({symbol, MakeKey(begin, end)}, {symbol, 0, 0, begin, end}, !parser.m_isTerminal[symbol]);
+	}
+
+	NodeId GetIntermediateNode(std::size_t rule, std::size_t dot, std::size_t begin, std::size_t end)
+	{
+		const StateId state = parser.m_ruleStates[rule] + static_cast<StateId>(dot);
+		return GetNode({INTERMEDIATE | state, MakeKey(begin, end)}, {NO_SYMBOL, rule, dot, begin, end}, true);
+	}
+
+	NodeId GetNode(const std::pair<std::uint64_t, std::uint64_t>& key, const ParseForest::Node& node, bool expand)
+	{
+		const auto [it, inserted] = nodes.try_emplace(key, ParseForest::NO_NODE);
+		if (inserted)
+		{
+			it->second = forest.AddNode(node);
+			if (expand)
+			{
+				pending.push_back(it->second);
+			}
+		}
+		return it->second;
+	}
+
+	// Незавершенные пункты Leo не пропускает, поэтому их достаточно искать в самом множестве
+	bool Contains(std::size_t set, StateId state, std::size_t origin) const
+	{
+		return std::binary_search(sortedItems.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[set]),
+			sortedItems.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[set + 1]), MakeKey(state, origin));
+	}
+
+	bool IsCompleted(std::size_t set, StateId state, std::size_t origin)
+	{
+		const auto& skipped = GetLeoCompleted(set);
+		return Contains(set, state, origin) || std::binary_search(skipped.begin(), skipped.end(), MakeKey(state, origin));
+	}
+
+	// Начала завершенных пунктов состояния state в множестве set не левее minOrigin
+	void CollectOrigins(std::size_t set, StateId state, std::size_t minOrigin, std::vector<std::size_t>& origins)
+	{
+		ForEachOriginRange(set, state, minOrigin, [&](auto first, auto last) {
+			for (auto it = first; it != last; ++it)
+			{
+				origins.push_back(static_cast<std::uint32_t>(*it));
+			}
+		});
+	}
+
+	std::size_t CountOrigins(std::size_t set, StateId state, std::size_t minOrigin)
+	{
+		std::size_t count = 0;
+		ForEachOriginRange(set, state, minOrigin, [&](auto first, auto last) {
+			count += static_cast<std::size_t>(last - first);
+		});
+		return count;
+	}
+
+	// Ключи пунктов (state, origin >= minOrigin) среди пунктов множества и среди пропущенных Leo
+	template <typename Callback>
+	void ForEachOriginRange(std::size_t set, StateId state, std::size_t minOrigin, Callback&& callback)
+	{
+		auto find = [&](auto first, auto last) {
+			callback(std::lower_bound(first, last, MakeKey(state, minOrigin)),
+				std::lower_bound(first, last, MakeKey(state + 1, 0)));
+		};
+		find(sortedItems.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[set]),
+			sortedItems.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[set + 1]));
+		const auto& skipped = GetLeoCompleted(set);
+		find(skipped.begin(), skipped.end());
+	}
+
+	const std::vector<std::uint64_t>& GetLeoCompleted(std::size_t set)
+	{
+		auto& completed = leoCompleted[set];
+		if (!leoExpanded[set])
+		{
+			leoExpanded[set] = true;
+			for (std::size_t use = chart.leoUseOffsets[set]; use < chart.leoUseOffsets[set + 1]; ++use)
+			{
+				for (std::uint32_t entry = chart.leoUses[use]; entry != NO_LEO; entry = chart.leoEntries[entry].next)
+				{
+					const Item& penult = chart.leoEntries[entry].penult;
+					completed.push_back(MakeKey(penult.state + 1, penult.origin));
+				}
+			}
+			std::sort(completed.begin(), completed.end());
+			completed.erase(std::unique(completed.begin(), completed.end()), completed.end());
+		}
+		return completed;
+	}
+};
+
+EarleyParser::EarleyParser(const Grammar& grammar)
+	: m_symbols(grammar.GetSymbolTable())
+	, m_start(grammar.GetStartSymbolId())
+{
+	if (m_start == NO_SYMBOL)
+	{
+		throw std::invalid_argument("Grammar start symbol is not set");
+	}
+
+	// Служебный стартовый символ получает номер за последним символом грамматики
+	const auto startSymbol = static_cast<SymbolId>(m_symbols.GetSize());
+	const std::size_t symbolCount = m_symbols.GetSize() + 1;
+	m_isTerminal.assign(symbolCount, false);
+	for (SymbolId id = 0; id < m_symbols.GetSize(); ++id)
+	{
+		m_isTerminal[id] = grammar.IsTerminal(id);
+	}
+
+	auto addRule = [this](SymbolId left, std::span<const SymbolId> right) {
+		const auto rule = static_cast<std::uint32_t>(m_ruleLeft.size());
+		m_ruleLeft.push_back(left);
+		m_ruleStates.push_back(static_cast<StateId>(m_stateNext.size()));
+		m_stateNext.insert(m_stateNext.end(), right.begin(), right.end());
+		m_stateNext.push_back(NO_SYMBOL);
+		m_stateRule.insert(m_stateRule.end(), right.size() + 1, rule);
+	};
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const auto left = grammar.GetRuleLeft(rule);
+		if (left.size() != 1)
+		{
+			throw std::invalid_argument("Grammar is not context-free: rule " + std::to_string(rule)
+				+ " has more than one symbol on the left");
+		}
+		addRule(left[0], grammar.GetRuleRight(rule));
+	}
+	m_startRule = m_ruleLeft.size();
+	addRule(startSymbol, std::span(&m_start, 1));
+	m_ruleStates.push_back(static_cast<StateId>(m_stateNext.size()));
+
+	m_rulesByLeftOffsets.assign(symbolCount + 1, 0);
+	for (const auto left : m_ruleLeft)
+	{
+		++m_rulesByLeftOffsets[left + 1];
+	}
+	for (std::size_t symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		m_rulesByLeftOffsets[symbol + 1] += m_rulesByLeftOffsets[symbol];
+	}
+	m_rulesByLeft.resize(m_ruleLeft.size());
+	std::vector<std::size_t> fill(m_rulesByLeftOffsets.begin(), m_rulesByLeftOffsets.end() - 1);
+	for (std::uint32_t rule = 0; rule < m_ruleLeft.size(); ++rule)
+	{
+		m_rulesByLeft[fill[m_ruleLeft[rule]]++] = rule;
+	}
+
+	// Обнуляемые символы: правило срабатывает, когда обнулены все символы его правой части
+	std::vector<std::size_t> remaining(m_ruleLeft.size());
+	std::vector<std::vector<std::uint32_t>> occurrences(symbolCount);
+	std::vector<SymbolId> queue;
+	m_nullable.assign(symbolCount, false);
+	auto markNullable = [&](SymbolId symbol) {
+		if (!m_nullable[symbol])
+		{
+			m_nullable[symbol] = true;
+			queue.push_back(symbol);
+		}
+	};
+	for (std::uint32_t rule = 0; rule < m_ruleLeft.size(); ++rule)
+	{
+		remaining[rule] = GetRuleLength(rule);
+		for (StateId state = m_ruleStates[rule]; state < GetCompletedState(rule); ++state)
+		{
+			occurrences[m_stateNext[state]].push_back(rule);
+		}
+		if (remaining[rule] == 0)
+		{
+			markNullable(m_ruleLeft[rule]);
+		}
+	}
+	while (!queue.empty())
+	{
+		const SymbolId symbol = queue.back();
+		queue.pop_back();
+		for (const auto rule : occurrences[symbol])
+		{
+			if (--remaining[rule] == 0)
+			{
+				markNullable(m_ruleLeft[rule]);
+			}
+		}
+	}
+}
+
+bool EarleyParser::Recognize(std::span<const std::string_view> tokens) const
+{
+	const auto terminals = ToTerminals(tokens);
+	return IsAccepted(BuildChart(terminals), terminals.size());
+}
+
+bool EarleyParser::Recognize(std::string_view word) const
+{
+	const auto terminals = ToTerminals(word);
+	return IsAccepted(BuildChart(terminals), terminals.size());
+}
+
+std::optional<ParseForest> EarleyParser::Parse(std::span<const std::string_view> tokens) const
+{
+	const auto terminals = ToTerminals(tokens);
+	const Chart chart = BuildChart(terminals);
+	if (!IsAccepted(chart, terminals.size()))
+	{
+		return std::nullopt;
+	}
+	return ForestBuilder(*this, chart, terminals).Build();
+}
+
+std::optional<ParseForest> EarleyParser::Parse(std::string_view word) const
+{
+	const auto terminals = ToTerminals(word);
+	const Chart chart = BuildChart(terminals);
+	if (!IsAccepted(chart, terminals.size()))
+	{
+		return std::nullopt;
+	}
+	return ForestBuilder(*this, chart, terminals).Build();
+}
+
+// Неизвестный токен становится NO_SYMBOL: его не ждет ни один пункт
+std::vector<SymbolId> EarleyParser::ToTerminals(std::span<const std::string_view> tokens) const
+{
+	std::vector<SymbolId> terminals;
+	terminals.reserve(tokens.size());
+	for (const auto token : tokens)
+	{
+		const auto id = m_symbols.Find(token);
+		terminals.push_back(id && m_isTerminal[*id] ? *id : NO_SYMBOL);
+	}
+	return terminals;
+}
+
+std::vector<SymbolId> EarleyParser::ToTerminals(std::string_view word) const
+{
+	std::vector<std::string_view> tokens;
+	tokens.reserve(word.size());
+	for (std::size_t i = 0; i < word.size(); ++i)
+	{
+		tokens.push_back(word.substr(i, 1));
+	}
+	return ToTerminals(tokens);
+}
+
+EarleyParser::Chart EarleyParser::BuildChart(std::span<const SymbolId> terminals) const
+{
+	if (terminals.size() >= std::numeric_limits<std::uint32_t>::max())
+	{
+		throw std::length_error("Input is too long");
+	}
+
+	Chart chart;
+	StampedSet added;
+	std::vector<std::size_t> predicted(m_isTerminal.size(), NOT_PREDICTED);
+	auto add = [&](StateId state, std::uint32_t origin) {
+		if (added.Insert(MakeKey(state, origin)))
+		{
+			chart.items.push_back({state, origin});
+		}
+	};
+
+	added.Clear();
+	add(m_ruleStates[m_startRule], 0);
+	for (std::size_t set = 0;; ++set)
+	{
+		const auto current = static_cast<std::uint32_t>(set);
+		// Пункты добавляются в конец массива, пока множество обрабатывается
+		for (std::size_t i = chart.setOffsets[set]; i < chart.items.size(); ++i)
+		{
+			const Item item = chart.items[i];
+			const SymbolId next = m_stateNext[item.state];
+			if (next == NO_SYMBOL)
+			{
+				// Завершения с началом в текущем множестве уже учтены сдвигом точки через обнуляемый символ
+				if (item.origin == current)
+				{
+					continue;
+				}
+				const SymbolId left = m_ruleLeft[m_stateRule[item.state]];
+				const std::uint32_t leo = FindLeo(chart, item.origin, left);
+				if (leo != NO_LEO)
+				{
+					add(chart.leoEntries[leo].top.state, chart.leoEntries[leo].top.origin);
+					chart.leoUses.push_back(leo);
+					continue;
+				}
+				for (const auto& waiting : chart.GetWaiting(item.origin, left))
+				{
+					const Item parent = chart.items[waiting.item];
+					add(parent.state + 1, parent.origin);
+				}
+			}
+			else if (!m_isTerminal[next])
+			{
+				if (predicted[next] != set)
+				{
+					predicted[next] = set;
+					for (std::size_t rule = m_rulesByLeftOffsets[next]; rule < m_rulesByLeftOffsets[next + 1]; ++rule)
+					{
+						add(m_ruleStates[m_rulesByLeft[rule]], current);
+					}
+				}
+				if (m_nullable[next])
+				{
+					add(item.state + 1, item.origin);
+				}
+			}
+		}
+		chart.setOffsets.push_back(chart.items.size());
+		chart.leoUseOffsets.push_back(chart.leoUses.size());
+
+		for (std::size_t i = chart.setOffsets[set]; i < chart.setOffsets[set + 1]; ++i)
+		{
+			const SymbolId next = m_stateNext[chart.items[i].state];
+			if (next != NO_SYMBOL)
+			{
+				chart.waiting.push_back({next, static_cast<std::uint32_t>(i)});
+			}
+		}
+		std::sort(chart.waiting.begin() + static_cast<std::ptrdiff_t>(chart.waitingOffsets[set]),
+			chart.waiting.end(), [](const auto& left, const auto& right) { return left.symbol < right.symbol; });
+		chart.waitingOffsets.push_back(chart.waiting.size());
+
+		if (set == terminals.size())
+		{
+			break;
+		}
+		added.Clear();
+		for (const auto& waiting : chart.GetWaiting(set, terminals[set]))
+		{
+			const Item item = chart.items[waiting.item];
+			add(item.state + 1, item.origin);
+		}
+		if (chart.items.size() == chart.setOffsets[set + 1])
+		{
+			break;
+		}
+	}
+	return chart;
+}
+
+bool EarleyParser::IsAccepted(const Chart& chart, std::size_t length) const
+{
+	if (chart.GetSetCount() != length + 1)
+	{
+		return false;
+	}
+	const auto first = chart.items.begin() + static_cast<std::ptrdiff_t>(chart.setOffsets[length]);
+	return std::any_of(first, chart.items.end(), [this](const Item& item) {
+		return item.state == GetCompletedState(m_startRule) && item.origin == 0;
+	});
+}
+
+// Цепочка строится без рекурсии: сначала собираются звенья до известного пункта или до конца цепочки,
+// затем вершина распространяется назад. Звено с началом в том же множестве цепочку обрывает,
+// иначе циклические правила вроде A -> B, B -> A зациклили бы поиск
+std::uint32_t EarleyParser::FindLeo(Chart& chart, std::uint32_t set, SymbolId symbol) const
+{
+	std::vector<std::pair<std::uint64_t, Item>> path;
+	std::uint32_t tail = NO_LEO;
+	for (std::uint64_t key = MakeKey(set, symbol);;)
+	{
+		if (const auto it = chart.leoByKey.find(key); it != chart.leoByKey.end())
+		{
+			tail = it->second;
+			break;
+		}
+		const auto waiting = chart.GetWaiting(static_cast<std::size_t>(key >> 32), static_cast<SymbolId>(key));
+		if (waiting.size() != 1 || m_stateNext[chart.items[waiting[0].item].state + 1] != NO_SYMBOL)
+		{
+			chart.leoByKey.emplace(key, NO_LEO);
+			break;
+		}
+		const Item penult = chart.items[waiting[0].item];
+		path.emplace_back(key, penult);
+		if (penult.origin == key >> 32)
+		{
+			break;
+		}
+		key = MakeKey(penult.origin, m_ruleLeft[m_stateRule[penult.state]]);
+	}
+
+	for (auto it = path.rbegin(); it != path.rend(); ++it)
+	{
+		const Item& penult = it->second;
+		const Item top = tail == NO_LEO ? Item{penult.state + 1, penult.origin} : chart.leoEntries[tail].top;
+		chart.leoEntries.push_back({penult, tail, top});
+		tail = static_cast<std::uint32_t>(chart.leoEntries.size() - 1);
+		chart.leoByKey.emplace(it->first, tail);
+	}
+	return tail;
+}
+
+std::size_t EarleyParser::GetRuleLength(std::size_t rule) const
+{
+	return m_ruleStates[rule + 1] - m_ruleStates[rule] - 1;
+}
+
+EarleyParser::StateId EarleyParser::GetCompletedState(std::size_t rule) const
+{
+	return m_ruleStates[rule + 1] - 1;
+}
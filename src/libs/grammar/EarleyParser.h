@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Grammar.h"
+#include "ParseForest.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Разбор по произвольной контекстно-свободной грамматике алгоритмом Эрли.
+// Пустые правила обрабатываются по Aycock-Horspool: при предсказании обнуляемого символа точка сразу сдвигается.
+// Правая рекурсия - по Leo: цепочка завершений с единственным ожидающим пунктом заменяется ее вершиной,
+// поэтому LR(k)-грамматики разбираются за линейное время, в том числе праворекурсивные.
+// Пункты всех множеств лежат в одном массиве, ожидающие пункты множества отсортированы по символу после точки
+class EarleyParser
+{
+public:
+	explicit EarleyParser(const Grammar& grammar);
+
+	bool Recognize(std::span<const std::string_view> tokens) const;
+	// Каждый байт - отдельный терминал
+	bool Recognize(std::string_view word) const;
+
+	// Лес всех деревьев вывода, std::nullopt - слово не выводится.
+	// Номера правил и символов в лесу - номера исходной грамматики
+	std::optional<ParseForest> Parse(std::span<const std::string_view> tokens) const;
+	std::optional<ParseForest> Parse(std::string_view word) const;
+
+private:
+	// Правило с точкой: состояния правила r - m_ruleStates[r]..m_ruleStates[r + 1] - 1, последнее - завершенное
+	using StateId = std::uint32_t;
+
+	struct Item
+	{
+		StateId state;
+		std::uint32_t origin;
+	};
+
+	struct Chart;
+	struct ForestBuilder;
+
+	std::vector<SymbolId> ToTerminals(std::span<const std::string_view> tokens) const;
+	std::vector<SymbolId> ToTerminals(std::string_view word) const;
+	Chart BuildChart(std::span<const SymbolId> terminals) const;
+	bool IsAccepted(const Chart& chart, std::size_t length) const;
+	std::uint32_t FindLeo(Chart& chart, std::uint32_t set, SymbolId symbol) const;
+
+	std::size_t GetRuleLength(std::size_t rule) const;
+	StateId GetCompletedState(std::size_t rule) const;
+
+	SymbolTable m_symbols;
+	std::vector<char> m_isTerminal;
+	std::vector<char> m_nullable;
+	SymbolId m_start;
+	// Служебное правило S0 -> S: его завершение в последнем множестве означает успех
+	std::size_t m_startRule = 0;
+
+	std::vector<StateId> m_ruleStates;
+	std::vector<SymbolId> m_ruleLeft;
+	// Символ после точки, NO_SYMBOL у завершенного состояния
+	std::vector<SymbolId> m_stateNext;
+	std::vector<std::uint32_t> m_stateRule;
+	// Правила нетерминала X - m_rulesByLeft[m_rulesByLeftOffsets[X]..m_rulesByLeftOffsets[X + 1])
+	std::vector<std::size_t> m_rulesByLeftOffsets;
+	std::vector<std::uint32_t> m_rulesByLeft;
+};
@@ -1,5 +1,11 @@
 #include "Grammar.h"
+#include "ProductionParser.h"
+#include "SymbolGraph.h"
+
+#include <algorithm>
+#include <optional>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace
 {
@@ -19,10 +25,194 @@ void AssertIsSymbolNonTerminal(const SymbolString& symbol, const std::set<Symbol
 	}
 }
 
+void AssertIsSymbolDeclared(bool isDeclared, std::string_view symbol)
+{
+	if (!isDeclared)
+	{
+		throw std::invalid_argument("Symbol '" + std::string(symbol) + "' is neither a terminal nor a non-terminal");
+	}
+}
+
+void AssertHasNonTerminal(bool hasNonTerminal)
+{
+	if (!hasNonTerminal)
+	{
+		throw std::invalid_argument("Left side of a rule must contain a non-terminal");
+	}
+}
+
+enum class Linearity
+{
+	ANY,
+	RIGHT,
+	LEFT,
+	NONE
+};
+
+// Правило A -> w или A -> B подходит обоим видам, A -> wB - праволинейное, A -> Bw - леволинейное
+Linearity GetLinearity(const Grammar& grammar, std::span<const SymbolId> right)
+{
+	const auto nonTerminalCount = std::count_if(right.begin(), right.end(), [&](SymbolId id) {
+		return grammar.IsNonTerminal(id);
+	});
+	if (nonTerminalCount == 0 || right.size() == 1)
+	{
+		return Linearity::ANY;
+	}
+	if (nonTerminalCount == 1 && grammar.IsNonTerminal(right.back()))
+	{
+		return Linearity::RIGHT;
+	}
+	if (nonTerminalCount == 1 && grammar.IsNonTerminal(right.front()))
+	{
+		return Linearity::LEFT;
+	}
+	return Linearity::NONE;
+}
+
+// Правила сравниваются по номерам символов обеих частей
+class RuleHash
+{
+public:
+	explicit RuleHash(const Grammar& grammar)
+		: m_grammar(grammar)
+	{
+	}
+
+	std::size_t operator()(std::size_t rule) const
+	{
+		const auto left = m_grammar.GetRuleLeft(rule);
+		std::size_t hash = left.size();
+		for (const auto part : {left, m_grammar.GetRuleRight(rule)})
+		{
+			for (const SymbolId id : part)
+			{
+				hash = hash * 1000003 ^ id;
+			}
+		}
+		return hash;
+	}
+
+private:
+	const Grammar& m_grammar;
+};
+
+class RuleEqual
+{
+public:
+	explicit RuleEqual(const Grammar& grammar)
+		: m_grammar(grammar)
+	{
+	}
+
+	bool operator()(std::size_t first, std::size_t second) const
+	{
+		return std::ranges::equal(m_grammar.GetRuleLeft(first), m_grammar.GetRuleLeft(second))
+			&& std::ranges::equal(m_grammar.GetRuleRight(first), m_grammar.GetRuleRight(second));
+	}
+
+private:
+	const Grammar& m_grammar;
+};
 
-Production ParseProductionStringImpl(const std::string& /*productionString*/)
+// Один проход по правилам: признаки всех четырех типов копятся одновременно,
+// цепные правила откладываются для поиска циклов
+GrammarClassification ClassifyRules(const Grammar& grammar)
 {
-	return {};
+	GrammarClassification result;
+	const SymbolId start = grammar.GetStartSymbolId();
+	const std::size_t symbolCount = grammar.GetSymbolTable().GetSize();
+
+	bool isContextFree = true;
+	bool isNonContracting = true;
+	bool hasStartEpsilon = false;
+	bool hasStartOnRight = false;
+	Linearity linearity = Linearity::ANY;
+	std::vector<std::size_t> unitRules;
+	std::vector<std::vector<SymbolId>> unitEdges(symbolCount);
+	std::unordered_set<std::size_t, RuleHash, RuleEqual> seen(
+		grammar.GetRuleCount(), RuleHash(grammar), RuleEqual(grammar));
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const auto left = grammar.GetRuleLeft(rule);
+		const auto right = grammar.GetRuleRight(rule);
+
+		if (left.size() == 1 && grammar.IsNonTerminal(left[0]))
+		{
+			const Linearity current = GetLinearity(grammar, right);
+			if (current == Linearity::NONE || (current != Linearity::ANY && linearity != Linearity::ANY && current != linearity))
+			{
+				linearity = Linearity::NONE;
+			}
+			else if (current != Linearity::ANY && linearity == Linearity::ANY)
+			{
+				linearity = current;
+			}
+
+			if (right.size() >= 2 && right.front() == left[0] && right.back() == left[0])
+			{
+				result.ambiguityHints.push_back({AmbiguityPattern::LEFT_AND_RIGHT_RECURSION, rule});
+			}
+			if (right.size() == 1 && grammar.IsNonTerminal(right[0]))
+			{
+				unitRules.push_back(rule);
+				unitEdges[left[0]].push_back(right[0]);
+			}
+		}
+		else
+		{
+			isContextFree = false;
+		}
+
+		// Сокращающее правило допустимо только в виде S -> ε
+		if (left.size() > right.size())
+		{
+			const bool isStartEpsilon = right.empty() && left.size() == 1 && left[0] == start;
+			hasStartEpsilon = hasStartEpsilon || isStartEpsilon;
+			isNonContracting = isNonContracting && isStartEpsilon;
+		}
+		hasStartOnRight = hasStartOnRight || std::ranges::find(right, start) != right.end();
+
+		if (!seen.insert(rule).second)
+		{
+			result.ambiguityHints.push_back({AmbiguityPattern::DUPLICATE_RULE, rule});
+		}
+	}
+
+	if (!unitRules.empty())
+	{
+		const auto component = SymbolGraph::FindComponents(symbolCount, unitEdges);
+		for (const std::size_t rule : unitRules)
+		{
+			if (component[grammar.GetRuleLeft(rule)[0]] == component[grammar.GetRuleRight(rule)[0]])
+			{
+				result.ambiguityHints.push_back({AmbiguityPattern::UNIT_CYCLE, rule});
+			}
+		}
+		std::ranges::stable_sort(result.ambiguityHints, {}, &AmbiguityHint::rule);
+	}
+
+	if (isContextFree)
+	{
+		result.type = linearity == Linearity::NONE ? ChomskyType::CONTEXT_FREE : ChomskyType::REGULAR;
+	}
+	else
+	{
+		const bool isContextSensitive = isNonContracting && !(hasStartEpsilon && hasStartOnRight);
+		result.type = isContextSensitive ? ChomskyType::CONTEXT_DEPENDED : ChomskyType::TURING;
+	}
+	return result;
+}
+
+std::string JoinNames(const SymbolTable& symbols, std::span<const SymbolId> ids)
+{
+	std::string text;
+	for (const SymbolId id : ids)
+	{
+		text += symbols.GetName(id);
+	}
+	return text;
 }
 } // namespace
 
@@ -40,12 +230,22 @@ void Grammar::AddTerminal(const SymbolString& terminal)
 {
 	AssertIsTSymbolStringExist(terminal);
 	m_terminals.insert(terminal);
+
+	const SymbolId id = m_symbols.Intern(terminal);
+	TrackSymbol(id);
+	m_isTerminal[id] = true;
+	m_derived.classification.reset();
 }
 
 void Grammar::AddNonTerminal(const SymbolString& nonTerminal)
 {
 	AssertIsTSymbolStringExist(nonTerminal);
 	m_nonTerminals.insert(nonTerminal);
+
+	const SymbolId id = m_symbols.Intern(nonTerminal);
+	TrackSymbol(id);
+	m_isNonTerminal[id] = true;
+	m_derived.classification.reset();
 }
 
 // Делать проверку после добавления терминальных символов
@@ -53,19 +253,22 @@ void Grammar::SetStartSymbol(const SymbolString& startSymbol)
 {
 	AssertIsSymbolNonTerminal(startSymbol, m_nonTerminals);
 	m_startSymbol = startSymbol;
+	m_startSymbolId = *m_symbols.Find(startSymbol);
+	m_derived.classification.reset();
 }
 
 
-// Правая часть правила не должна быть пустой (ε-правила обрабатываются особо)
-// Замечание: Классические ε-правила имеют пустую правую часть
+// Пустая правая часть - ε-правило A -> ε.
+// Правило разбирается на объявленные символы по наибольшему совпадению: "aB" - это a и B
 void Grammar::AddProduction(Production production)
 {
 	AssertIsTSymbolStringExist(production.m_left);
-	AssertIsTSymbolStringExist(production.m_right);
 
-	// - Проверить, что все символы в m_left существуют в m_nonTerminals или m_terminals
-	// - Проверить, что все символы в m_right существуют в m_nonTerminals или m_terminals
-	m_productions.push_back(std::move(production));
+	std::vector<SymbolId> left;
+	std::vector<SymbolId> right;
+	ResolveSymbols(production.m_left, left);
+	ResolveSymbols(production.m_right, right);
+	AddRule(left, right);
 }
 
 const std::string& Grammar::GetName() const
@@ -75,9 +278,17 @@ const std::string& Grammar::GetName() const
 
 ChomskyType Grammar::GetType() const
 {
-	// TODO: Если m_type == UNKNOWN, можно добавить логику для автоматического определения типа
-	// на основе анализа m_productions (но это сложная задача)
-	return m_type;
+	return m_type != ChomskyType::UNKNOWN ? m_type : Classify().type;
+}
+
+const GrammarClassification& Grammar::Classify() const
+{
+	std::lock_guard lock(m_derived.mutex);
+	if (!m_derived.classification)
+	{
+		m_derived.classification = ClassifyRules(*this);
+	}
+	return *m_derived.classification;
 }
 
 const std::set<SymbolString>& Grammar::GetTerminals() const
@@ -97,91 +308,146 @@ const SymbolString& Grammar::GetStartSymbol() const
 
 const std::vector<Production>& Grammar::GetProductions() const
 {
-	return m_productions;
+	std::lock_guard lock(m_derived.mutex);
+	for (std::size_t rule = m_derived.productions.size(); rule < GetRuleCount(); ++rule)
+	{
+		m_derived.productions.push_back({JoinNames(m_symbols, GetRuleLeft(rule)), JoinNames(m_symbols, GetRuleRight(rule))});
+	}
+	return m_derived.productions;
 }
 
-void Grammar::AddProductionFromString(const std::string& productionString)
+Grammar::DerivedCache::DerivedCache(const DerivedCache& other)
 {
-	Production production = ParseProductionStringImpl(productionString);
-	AddProduction(std::move(production));
+	std::lock_guard lock(other.mutex);
+	productions = other.productions;
+	classification = other.classification;
 }
 
-bool Grammar::IsRegular() const
+Grammar::DerivedCache& Grammar::DerivedCache::operator=(const DerivedCache& other)
+{
+	if (this != &other)
+	{
+		std::scoped_lock lock(mutex, other.mutex);
+		productions = other.productions;
+		classification = other.classification;
+	}
+	return *this;
+}
+
+void Grammar::AddProductionFromString(std::string_view productionString)
 {
-	if (m_productions.empty())
+	const ParsedProduction parsed = ProductionParser::Parse(productionString);
+
+	std::vector<SymbolId> left;
+	for (const auto symbol : parsed.left)
 	{
-		return true;
+		ResolveSymbols(symbol, left);
 	}
 
-	int determinedType = -1;
-	for (const auto& production : m_productions)
+	std::vector<SymbolId> right;
+	for (const auto& alternative : parsed.alternatives)
 	{
-		// 1. Проверка левой части: Должен быть один нетерминал
-		if (production.m_left.length() != 1 || !m_nonTerminals.contains(production.m_left))
+		right.clear();
+		for (const auto symbol : alternative)
 		{
-			// Нарушение основного правила для Типа 3
-			return false;
+			ResolveSymbols(symbol, right);
 		}
+		AddRule(left, right);
+	}
+}
 
-		// 2. Анализ правой части и определение типа правила
-		auto currentRuleType = -1;
-		bool ruleOk = false;
+bool Grammar::IsRegular() const
+{
+	return Classify().type == ChomskyType::REGULAR;
+}
 
-		const SymbolString& right = production.m_right;
+const SymbolTable& Grammar::GetSymbolTable() const
+{
+	return m_symbols;
+}
 
-		if (right.empty()) // Правило A -> ε
-		{
-			// ε-правила допустимы и подходят под оба типа
-			ruleOk = true;
-		}
-		else if (right.length() == 1) // Правило A -> a
-		{
-			if (m_terminals.contains(right))
-			{
-				// Подходит под оба типа
-				ruleOk = true;
-			}
-		}
-		else if (right.length() == 2) // Правила A -> aB или A -> Ba
-		{
-			SymbolString firstSymbol = right.substr(0, 1);
-			SymbolString secondSymbol = right.substr(1, 1);
+bool Grammar::IsTerminal(SymbolId id) const
+{
+	return id < m_isTerminal.size() && m_isTerminal[id];
+}
 
-			// Проверка на праволинейность (A -> aB)
-			if (m_terminals.contains(firstSymbol) && m_nonTerminals.contains(secondSymbol))
-			{
-				ruleOk = true;
-				currentRuleType = 0;
-			}
-			// Проверка на леволинейность (A -> Ba)
-			else if (m_nonTerminals.contains(firstSymbol) && m_terminals.contains(secondSymbol))
-			{
-				ruleOk = true;
-				currentRuleType = 1;
-			}
-		}
+bool Grammar::IsNonTerminal(SymbolId id) const
+{
+	return id < m_isNonTerminal.size() && m_isNonTerminal[id];
+}
 
-		if (!ruleOk)
-		{
-			return false;
-		}
+SymbolId Grammar::GetStartSymbolId() const
+{
+	return m_startSymbolId;
+}
+
+std::size_t Grammar::GetRuleCount() const
+{
+	return m_ruleSplits.size();
+}
+
+std::span<const SymbolId> Grammar::GetRuleLeft(std::size_t rule) const
+{
+	const std::size_t begin = m_ruleOffsets.at(rule);
+	return {m_ruleSymbols.data() + begin, m_ruleSplits.at(rule) - begin};
+}
+
+std::span<const SymbolId> Grammar::GetRuleRight(std::size_t rule) const
+{
+	const std::size_t begin = m_ruleSplits.at(rule);
+	return {m_ruleSymbols.data() + begin, m_ruleOffsets.at(rule + 1) - begin};
+}
+
+// Сначала ищется имя целиком, затем наибольшее совпадение с объявленными именами с начала остатка
+void Grammar::ResolveSymbols(std::string_view text, std::vector<SymbolId>& symbols) const
+{
+	if (const auto id = m_symbols.Find(text))
+	{
+		symbols.push_back(*id);
+		return;
+	}
 
-		// 3. Проверка на смешивание типов
-		// Если текущее правило однозначно право- или леволинейное:
-		if (currentRuleType != -1)
+	std::size_t position = 0;
+	while (position < text.size())
+	{
+		std::size_t length = std::min(m_symbols.GetMaxNameLength(), text.size() - position);
+		std::optional<SymbolId> id;
+		while (length > 0 && !(id = m_symbols.Find(text.substr(position, length))))
 		{
-			// Если тип грамматики еще не определен, устанавливаем его
-			if (determinedType == -1)
-			{
-				determinedType = currentRuleType;
-			}
-			// Если тип уже определен и он не совпадает с текущим правилом - ошибка
-			else if (determinedType != currentRuleType)
-			{
-				return false;
-			}
+			--length;
 		}
+		AssertIsSymbolDeclared(id.has_value(), text.substr(position, 1));
+		symbols.push_back(*id);
+		position += length;
 	}
+}
 
-	return true;
+void Grammar::AddRule(std::span<const SymbolId> left, std::span<const SymbolId> right)
+{
+	bool hasNonTerminal = false;
+	for (const SymbolId id : left)
+	{
+		AssertIsSymbolDeclared(IsTerminal(id) || IsNonTerminal(id), m_symbols.GetName(id));
+		hasNonTerminal = hasNonTerminal || IsNonTerminal(id);
+	}
+	AssertHasNonTerminal(hasNonTerminal);
+	for (const SymbolId id : right)
+	{
+		AssertIsSymbolDeclared(IsTerminal(id) || IsNonTerminal(id), m_symbols.GetName(id));
+	}
+
+	m_ruleSymbols.insert(m_ruleSymbols.end(), left.begin(), left.end());
+	m_ruleSplits.push_back(m_ruleSymbols.size());
+	m_ruleSymbols.insert(m_ruleSymbols.end(), right.begin(), right.end());
+	m_ruleOffsets.push_back(m_ruleSymbols.size());
+	m_derived.classification.reset();
+}
+
+void Grammar::TrackSymbol(SymbolId id)
+{
+	if (id >= m_isTerminal.size())
+	{
+		m_isTerminal.resize(id + 1, false);
+		m_isNonTerminal.resize(id + 1, false);
+	}
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "SymbolTable.h"
+
+#include <mutex>
+#include <optional>
 #include <set>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using SymbolString = std::string; // Терминалы и нетерминалы как строки
@@ -15,12 +21,32 @@ enum class ChomskyType
 	UNKNOWN = -1		  // Если тип еще не определен
 };
 
+// Приемы записи, из-за которых у слова обычно появляется несколько деревьев вывода
+enum class AmbiguityPattern
+{
+	DUPLICATE_RULE,			  // Одно и то же правило записано дважды
+	LEFT_AND_RIGHT_RECURSION, // A -> A α A, например E -> E + E без приоритетов
+	UNIT_CYCLE				  // A -> B, B -> A: у слова бесконечно много выводов
+};
+
+struct AmbiguityHint
+{
+	AmbiguityPattern pattern;
+	std::size_t rule;
+};
+
+struct GrammarClassification
+{
+	ChomskyType type = ChomskyType::UNKNOWN;
+	// Упорядочены по номеру правила
+	std::vector<AmbiguityHint> ambiguityHints;
+};
+
 /**
  * @brief Структура для хранения одного правила вывода (продукции)
  */
 struct Production
 {
-	// TODO: не забыть написать проверку в Assert
 	// Левая часть правила (может быть > 1 символа для типов 0, 1)
 	SymbolString m_left;
 	// Правая часть правила
@@ -37,7 +63,12 @@ public:
 	const std::string& GetName() const;
 
 	void SetType(ChomskyType type);
+	// Тип, заданный через SetType, иначе определенный по правилам
 	ChomskyType GetType() const;
+	// Самый узкий тип по всем правилам за один проход и шаблоны, склонные к неоднозначности.
+	// Регулярной считается право- или леволинейная грамматика с цепочками терминалов любой длины.
+	// Результат хранится до следующего изменения грамматики
+	const GrammarClassification& Classify() const;
 
 	void AddTerminal(const SymbolString& terminal);
 	const std::set<SymbolString>& GetTerminals() const;
@@ -48,21 +79,55 @@ public:
 	void SetStartSymbol(const SymbolString& startSymbol);
 	const SymbolString& GetStartSymbol() const;
 
-	void AddProductionFromString(const std::string& productionString);
+	// "A -> α | β" добавляет правило на каждую альтернативу, см. ProductionParser
+	void AddProductionFromString(std::string_view productionString);
+	// Символы правила должны быть объявлены, в левой части нужен нетерминал
 	void AddProduction(Production production);
+	void AddRule(std::span<const SymbolId> left, std::span<const SymbolId> right);
 
 	const std::vector<Production>& GetProductions() const;
 	bool IsRegular() const;
 
-	// TODO: добавить проверки (IsTuring()...) для вида грамматики
+	// Интернированное представление. Правила разбираются на символы по наибольшему совпадению
+	// с уже объявленными именами, поэтому символы объявляются до правил
+	const SymbolTable& GetSymbolTable() const;
+	bool IsTerminal(SymbolId id) const;
+	bool IsNonTerminal(SymbolId id) const;
+	SymbolId GetStartSymbolId() const;
+	std::size_t GetRuleCount() const;
+	std::span<const SymbolId> GetRuleLeft(std::size_t rule) const;
+	std::span<const SymbolId> GetRuleRight(std::size_t rule) const;
 
 private:
-	// Production ParseProductionString(const std::string& productionString) const; // Написать в namespace {} в cpp файле
-
 	std::string m_name;
 	ChomskyType m_type = ChomskyType::UNKNOWN;
 	std::set<SymbolString> m_terminals;
 	std::set<SymbolString> m_nonTerminals;
 	SymbolString m_startSymbol;
-	std::vector<Production> m_productions;
+	// Строковый вид правил и классификация достраиваются при обращении.
+	// Константные методы и копирование берут mutex, поэтому одну грамматику можно читать из нескольких потоков
+	struct DerivedCache
+	{
+		DerivedCache() = default;
+		DerivedCache(const DerivedCache& other);
+		DerivedCache& operator=(const DerivedCache& other);
+
+		mutable std::mutex mutex;
+		std::vector<Production> productions;
+		std::optional<GrammarClassification> classification;
+	};
+	mutable DerivedCache m_derived;
+
+	void ResolveSymbols(std::string_view text, std::vector<SymbolId>& symbols) const;
+	void TrackSymbol(SymbolId id);
+
+	SymbolTable m_symbols;
+	std::vector<char> m_isTerminal;
+	std::vector<char> m_isNonTerminal;
+	SymbolId m_startSymbolId = NO_SYMBOL;
+	// Все правила подряд в одном массиве: левая часть правила i - [m_ruleOffsets[i], m_ruleSplits[i]),
+	// правая - [m_ruleSplits[i], m_ruleOffsets[i + 1])
+	std::vector<SymbolId> m_ruleSymbols;
+	std::vector<std::size_t> m_ruleOffsets = {0};
+	std::vector<std::size_t> m_ruleSplits;
 };
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "GrammarAnalysis.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+void AssertIsContextFree(const Grammar& grammar)
+{
+	if (grammar.GetStartSymbolId() == NO_SYMBOL)
+	{
+		throw std::invalid_argument("Grammar start symbol is not set");
+	}
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		if (grammar.GetRuleLeft(rule).size() != 1)
+		{
+			throw std::invalid_argument("Grammar is not context-free: rule " + std::to_string(rule)
+				+ " has more than one symbol on the left");
+		}
+	}
+}
+
+// Рабочий список без повторов: символ уже в очереди не добавляется второй раз
+class Worklist
+{
+public:
+	explicit Worklist(std::size_t size)
+		: m_queued(size, false)
+	{
+	}
+
+	void Push(SymbolId symbol)
+	{
+		if (!m_queued[symbol])
+		{
+			m_queued[symbol] = true;
+			m_symbols.push_back(symbol);
+		}
+	}
+
+	bool IsEmpty() const
+	{
+		return m_symbols.empty();
+	}
+
+	SymbolId Pop()
+	{
+		const SymbolId symbol = m_symbols.back();
+		m_symbols.pop_back();
+		m_queued[symbol] = false;
+		return symbol;
+	}
+
+private:
+	std::vector<char> m_queued;
+	std::vector<SymbolId> m_symbols;
+};
+} // namespace
+
+GrammarAnalysis::GrammarAnalysis(const Grammar& grammar)
+{
+	AssertIsContextFree(grammar);
+
+	const std::size_t symbolCount = grammar.GetSymbolTable().GetSize();
+	m_terminalIndices.assign(symbolCount, NO_INDEX);
+	m_nonTerminalIndices.assign(symbolCount, NO_INDEX);
+	for (SymbolId symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		if (grammar.IsTerminal(symbol))
+		{
+			m_terminalIndices[symbol] = m_terminals.size();
+			m_terminals.push_back(symbol);
+		}
+		else if (grammar.IsNonTerminal(symbol))
+		{
+			m_nonTerminalIndices[symbol] = m_nonTerminals.size();
+			m_nonTerminals.push_back(symbol);
+		}
+	}
+	m_terminals.push_back(NO_SYMBOL);
+
+	ComputeNullable(grammar);
+	ComputeFirst(grammar);
+	ComputeFollow(grammar);
+}
+
+std::size_t GrammarAnalysis::GetTerminalCount() const
+{
+	return m_terminals.size();
+}
+
+std::size_t GrammarAnalysis::GetEndOfInputIndex() const
+{
+	return m_terminals.size() - 1;
+}
+
+std::size_t GrammarAnalysis::GetTerminalIndex(SymbolId symbol) const
+{
+	return symbol < m_terminalIndices.size() ? m_terminalIndices[symbol] : NO_INDEX;
+}
+
+SymbolId GrammarAnalysis::GetTerminal(std::size_t index) const
+{
+	return m_terminals.at(index);
+}
+
+std::size_t GrammarAnalysis::GetNonTerminalCount() const
+{
+	return m_nonTerminals.size();
+}
+
+std::size_t GrammarAnalysis::GetNonTerminalIndex(SymbolId symbol) const
+{
+	return symbol < m_nonTerminalIndices.size() ? m_nonTerminalIndices[symbol] : NO_INDEX;
+}
+
+SymbolId GrammarAnalysis::GetNonTerminal(std::size_t index) const
+{
+	return m_nonTerminals.at(index);
+}
+
+bool GrammarAnalysis::IsNullable(SymbolId symbol) const
+{
+	return m_nullable.at(symbol);
+}
+
+const TerminalSet& GrammarAnalysis::GetFirst(SymbolId symbol) const
+{
+	return m_first.at(symbol);
+}
+
+const TerminalSet& GrammarAnalysis::GetFollow(SymbolId nonTerminal) const
+{
+	AssertIsNonTerminal(nonTerminal);
+	return m_follow[m_nonTerminalIndices[nonTerminal]];
+}
+
+bool GrammarAnalysis::AddFirst(std::span<const SymbolId> symbols, TerminalSet& target) const
+{
+	for (const SymbolId symbol : symbols)
+	{
+		target.UnionWith(m_first[symbol]);
+		if (!m_nullable[symbol])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Правило срабатывает, когда обнулены все символы правой части: счетчик необнуленных символов на правило
+void GrammarAnalysis::ComputeNullable(const Grammar& grammar)
+{
+	const std::size_t symbolCount = m_terminalIndices.size();
+	std::vector<std::size_t> remaining(grammar.GetRuleCount());
+	std::vector<std::vector<std::size_t>> occurrences(symbolCount);
+	std::vector<SymbolId> queue;
+	m_nullable.assign(symbolCount, false);
+	auto markNullable = [&](SymbolId symbol) {
+		if (!m_nullable[symbol])
+		{
+			m_nullable[symbol] = true;
+			queue.push_back(symbol);
+		}
+	};
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const auto right = grammar.GetRuleRight(rule);
+		remaining[rule] = right.size();
+		for (const SymbolId symbol : right)
+		{
+			occurrences[symbol].push_back(rule);
+		}
+		if (right.empty())
+		{
+			markNullable(grammar.GetRuleLeft(rule)[0]);
+		}
+	}
+	while (!queue.empty())
+	{
+		const SymbolId symbol = queue.back();
+		queue.pop_back();
+		for (const std::size_t rule : occurrences[symbol])
+		{
+			if (--remaining[rule] == 0)
+			{
+				markNullable(grammar.GetRuleLeft(rule)[0]);
+			}
+		}
+	}
+}
+
+// FIRST(A) включает FIRST(X) для каждого X правой части A, перед которым все символы обнуляемы.
+// Такие пары X -> A - ребра, по которым изменения FIRST(X) распространяются рабочим списком
+void GrammarAnalysis::ComputeFirst(const Grammar& grammar)
+{
+	const std::size_t symbolCount = m_terminalIndices.size();
+	m_first.assign(symbolCount, TerminalSet(GetTerminalCount()));
+	std::vector<std::vector<SymbolId>> dependents(symbolCount);
+	Worklist worklist(symbolCount);
+
+	for (SymbolId symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		if (m_terminalIndices[symbol] != NO_INDEX)
+		{
+			m_first[symbol].Insert(m_terminalIndices[symbol]);
+		}
+	}
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const SymbolId left = grammar.GetRuleLeft(rule)[0];
+		for (const SymbolId symbol : grammar.GetRuleRight(rule))
+		{
+			if (symbol != left)
+			{
+				dependents[symbol].push_back(left);
+				worklist.Push(symbol);
+			}
+			if (!m_nullable[symbol])
+			{
+				break;
+			}
+		}
+	}
+
+	while (!worklist.IsEmpty())
+	{
+		const SymbolId symbol = worklist.Pop();
+		for (const SymbolId dependent : dependents[symbol])
+		{
+			if (m_first[dependent].UnionWith(m_first[symbol]))
+			{
+				worklist.Push(dependent);
+			}
+		}
+	}
+}
+
+// Для A -> α B β: FOLLOW(B) включает FIRST(β), а если β обнуляема - FOLLOW(A), это ребро A -> B
+void GrammarAnalysis::ComputeFollow(const Grammar& grammar)
+{
+	const std::size_t symbolCount = m_terminalIndices.size();
+	m_follow.assign(m_nonTerminals.size(), TerminalSet(GetTerminalCount()));
+	std::vector<std::vector<SymbolId>> dependents(symbolCount);
+	Worklist worklist(symbolCount);
+
+	m_follow[m_nonTerminalIndices[grammar.GetStartSymbolId()]].Insert(GetEndOfInputIndex());
+	worklist.Push(grammar.GetStartSymbolId());
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const SymbolId left = grammar.GetRuleLeft(rule)[0];
+		const auto right = grammar.GetRuleRight(rule);
+		for (std::size_t i = 0; i < right.size(); ++i)
+		{
+			const std::size_t index = m_nonTerminalIndices[right[i]];
+			if (index == NO_INDEX)
+			{
+				continue;
+			}
+			if (AddFirst(right.subspan(i + 1), m_follow[index]) && right[i] != left)
+			{
+				dependents[left].push_back(right[i]);
+			}
+			worklist.Push(right[i]);
+		}
+	}
+
+	while (!worklist.IsEmpty())
+	{
+		const SymbolId symbol = worklist.Pop();
+		for (const SymbolId dependent : dependents[symbol])
+		{
+			if (m_follow[m_nonTerminalIndices[dependent]].UnionWith(m_follow[m_nonTerminalIndices[symbol]]))
+			{
+				worklist.Push(dependent);
+			}
+		}
+	}
+}
+
+void GrammarAnalysis::AssertIsNonTerminal(SymbolId symbol) const
+{
+	if (GetNonTerminalIndex(symbol) == NO_INDEX)
+	{
+		throw std::invalid_argument("Symbol " + std::to_string(symbol) + " is not a non-terminal");
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Grammar.h"
+#include "TerminalSet.h"
+
+#include <limits>
+#include <span>
+#include <vector>
+
+// Множества nullable, FIRST и FOLLOW контекстно-свободной грамматики.
+// Терминалы нумеруются плотно в порядке интернирования, конец входа получает последний номер.
+// Каждое множество считается рабочим списком: символ пересчитывается, только когда изменился символ, от которого он зависит
+class GrammarAnalysis
+{
+public:
+	static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+	explicit GrammarAnalysis(const Grammar& grammar);
+
+	std::size_t GetTerminalCount() const;
+	std::size_t GetEndOfInputIndex() const;
+	// NO_INDEX - не терминал
+	std::size_t GetTerminalIndex(SymbolId symbol) const;
+	// NO_SYMBOL - конец входа
+	SymbolId GetTerminal(std::size_t index) const;
+
+	std::size_t GetNonTerminalCount() const;
+	// NO_INDEX - не нетерминал
+	std::size_t GetNonTerminalIndex(SymbolId symbol) const;
+	SymbolId GetNonTerminal(std::size_t index) const;
+
+	bool IsNullable(SymbolId symbol) const;
+	// У терминала FIRST - он сам
+	const TerminalSet& GetFirst(SymbolId symbol) const;
+	const TerminalSet& GetFollow(SymbolId nonTerminal) const;
+
+	// Добавляет FIRST цепочки к target, возвращает true, если цепочка выводит пустое слово
+	bool AddFirst(std::span<const SymbolId> symbols, TerminalSet& target) const;
+
+private:
+	void ComputeNullable(const Grammar& grammar);
+	void ComputeFirst(const Grammar& grammar);
+	void ComputeFollow(const Grammar& grammar);
+	void AssertIsNonTerminal(SymbolId symbol) const;
+
+	std::vector<std::size_t> m_terminalIndices;
+	std::vector<SymbolId> m_terminals;
+	std::vector<std::size_t> m_nonTerminalIndices;
+	std::vector<SymbolId> m_nonTerminals;
+	std::vector<char> m_nullable;
+	// По номеру символа
+	std::vector<TerminalSet> m_first;
+	// По номеру нетерминала
+	std::vector<TerminalSet> m_follow;
+};
@@ -0,0 +1,226 @@
+#include "GrammarBuilder.h"
+
+#include "ProductionParser.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace
+{
+constexpr char COMMENT = '#';
+constexpr char DIRECTIVE = '%';
+
+// Правило на каждую альтернативу; символы лежат в общем массиве
+struct PendingRule
+{
+	std::size_t line;
+	std::size_t leftBegin;
+	std::size_t leftEnd;
+	std::size_t rightBegin;
+	std::size_t rightEnd;
+};
+
+struct Declarations
+{
+	std::string_view name;
+	std::string_view start;
+	std::vector<std::string_view> terminals;
+	std::vector<std::string_view> nonTerminals;
+	bool hasTerminals = false;
+};
+
+void AssertIsFileOpen(const std::ifstream& file)
+{
+	if (!file.is_open())
+	{
+		throw std::invalid_argument("The file cannot be opened");
+	}
+}
+
+void AssertHasRules(const std::vector<PendingRule>& rules, std::string_view start)
+{
+	if (rules.empty() && start.empty())
+	{
+		throw std::invalid_argument("Grammar has no rules and no start symbol");
+	}
+}
+
+std::invalid_argument MakeLineError(std::size_t line, const std::exception& error)
+{
+	return std::invalid_argument("Line " + std::to_string(line) + ": " + error.what());
+}
+
+std::string_view TrimLeft(std::string_view text)
+{
+	const std::size_t begin = text.find_first_not_of(" \t\r");
+	return begin == std::string_view::npos ? std::string_view{} : text.substr(begin);
+}
+
+void ParseDirective(std::string_view line, Declarations& declarations)
+{
+	std::vector<std::string_view> words;
+	std::size_t position = 1;
+	while (position < line.size())
+	{
+		const std::size_t begin = line.find_first_not_of(" \t\r", position);
+		if (begin == std::string_view::npos)
+		{
+			break;
+		}
+		const std::size_t end = std::min(line.find_first_of(" \t\r", begin), line.size());
+		words.push_back(line.substr(begin, end - begin));
+		position = end;
+	}
+	if (words.empty())
+	{
+		throw std::invalid_argument("Empty directive");
+	}
+
+	const std::string_view directive = words.front();
+	const std::span<const std::string_view> values(words.data() + 1, words.size() - 1);
+	if (directive == "terminals")
+	{
+		declarations.terminals.insert(declarations.terminals.end(), values.begin(), values.end());
+		declarations.hasTerminals = true;
+	}
+	else if (directive == "nonterminals")
+	{
+		declarations.nonTerminals.insert(declarations.nonTerminals.end(), values.begin(), values.end());
+	}
+	else if ((directive == "start" || directive == "name") && values.size() == 1)
+	{
+		(directive == "start" ? declarations.start : declarations.name) = values.front();
+	}
+	else
+	{
+		throw std::invalid_argument("Unknown directive '%" + std::string(directive) + "'");
+	}
+}
+} // namespace
+
+Grammar GrammarBuilder::FromFile(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	AssertIsFileOpen(file);
+
+	std::ostringstream buffer;
+	buffer << file.rdbuf();
+	const std::string text = std::move(buffer).str();
+	return FromString(text);
+}
+
+Grammar GrammarBuilder::FromString(std::string_view text)
+{
+	Declarations declarations;
+	std::vector<std::string_view> symbols;
+	std::vector<PendingRule> rules;
+	ParsedProduction parsed;
+
+	std::size_t lineNumber = 0;
+	while (!text.empty())
+	{
+		++lineNumber;
+		const std::size_t end = std::min(text.find('\n'), text.size());
+		const std::string_view line = TrimLeft(text.substr(0, end));
+		text.remove_prefix(std::min(end + 1, text.size()));
+
+		if (line.empty() || line.front() == COMMENT)
+		{
+			continue;
+		}
+
+		try
+		{
+			if (line.front() == DIRECTIVE)
+			{
+				ParseDirective(line, declarations);
+				continue;
+			}
+			ProductionParser::Parse(line, parsed);
+		}
+		catch (const std::invalid_argument& error)
+		{
+			throw MakeLineError(lineNumber, error);
+		}
+
+		const std::size_t leftBegin = symbols.size();
+		symbols.insert(symbols.end(), parsed.left.begin(), parsed.left.end());
+		const std::size_t leftEnd = symbols.size();
+		for (const auto& alternative : parsed.alternatives)
+		{
+			const std::size_t rightBegin = symbols.size();
+			symbols.insert(symbols.end(), alternative.begin(), alternative.end());
+			rules.push_back({lineNumber, leftBegin, leftEnd, rightBegin, symbols.size()});
+		}
+	}
+	AssertHasRules(rules, declarations.start);
+
+	// Нетерминалы: объявленные и одиночные левые части, в порядке появления
+	Grammar grammar;
+	grammar.SetName(std::string(declarations.name));
+	std::unordered_set<std::string_view> nonTerminals(declarations.nonTerminals.begin(), declarations.nonTerminals.end());
+	for (const auto& rule : rules)
+	{
+		if (rule.leftEnd - rule.leftBegin == 1 && nonTerminals.insert(symbols[rule.leftBegin]).second)
+		{
+			declarations.nonTerminals.push_back(symbols[rule.leftBegin]);
+		}
+	}
+	for (const auto symbol : declarations.nonTerminals)
+	{
+		grammar.AddNonTerminal(std::string(symbol));
+	}
+	for (const auto symbol : declarations.terminals)
+	{
+		grammar.AddTerminal(std::string(symbol));
+	}
+
+	const auto& table = grammar.GetSymbolTable();
+	std::vector<SymbolId> ids;
+	auto resolve = [&](std::size_t begin, std::size_t end) {
+		ids.clear();
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			auto id = table.Find(symbols[i]);
+			if (!id && !declarations.hasTerminals)
+			{
+				grammar.AddTerminal(std::string(symbols[i]));
+				id = table.Find(symbols[i]);
+			}
+			if (!id)
+			{
+				throw std::invalid_argument("Unknown symbol '" + std::string(symbols[i]) + "'");
+			}
+			ids.push_back(*id);
+		}
+		return std::span<const SymbolId>(ids);
+	};
+
+	std::vector<SymbolId> left;
+	for (const auto& rule : rules)
+	{
+		try
+		{
+			const auto leftIds = resolve(rule.leftBegin, rule.leftEnd);
+			left.assign(leftIds.begin(), leftIds.end());
+			grammar.AddRule(left, resolve(rule.rightBegin, rule.rightEnd));
+		}
+		catch (const std::invalid_argument& error)
+		{
+			throw MakeLineError(rule.line, error);
+		}
+	}
+
+	try
+	{
+		grammar.SetStartSymbol(std::string(declarations.start.empty() ? symbols[rules.front().leftBegin] : declarations.start));
+	}
+	catch (const std::invalid_argument& error)
+	{
+		throw std::invalid_argument("Start symbol: " + std::string(error.what()));
+	}
+	return grammar;
+}
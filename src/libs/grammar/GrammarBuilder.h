@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Grammar.h"
+
+#include <string>
+#include <string_view>
+
+// Загрузка грамматики из текста. Строка - правило "A -> α | β" (см. ProductionParser) или директива:
+//   %name Имя
+//   %start S
+//   %terminals a b id
+//   %nonterminals S A
+// Строки, начинающиеся с '#', - комментарии.
+// Без директив нетерминалами считаются символы, стоящие одни в левой части правила, остальные - терминалами.
+// Если задана %terminals, незнакомый символ правой части - ошибка.
+// Стартовый символ по умолчанию - левая часть первого правила.
+// Текст разбирается за один проход без копирования символов, ошибки сообщаются с номером строки
+class GrammarBuilder
+{
+public:
+	static Grammar FromFile(const std::string& filename);
+	static Grammar FromString(std::string_view text);
+};
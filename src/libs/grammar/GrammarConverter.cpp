@@ -0,0 +1,280 @@
+#include "GrammarConverter.h"
+
+#include "EpsilonEliminationAlgorithm.h"
+#include "TrimAlgorithm.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <span>
+#include <stdexcept>
+
+namespace
+{
+enum class Linearity
+{
+	ANY,
+	RIGHT,
+	LEFT
+};
+
+void AssertIsStartSymbolSet(const Grammar& grammar)
+{
+	if (grammar.GetStartSymbol().empty())
+	{
+		throw std::invalid_argument("Grammar start symbol is not set");
+	}
+}
+
+std::string RuleToString(const Grammar& grammar, std::size_t rule)
+{
+	std::string text;
+	for (const SymbolId id : grammar.GetRuleLeft(rule))
+	{
+		text += grammar.GetSymbolTable().GetName(id);
+	}
+	text += " ->";
+	for (const SymbolId id : grammar.GetRuleRight(rule))
+	{
+		text += " " + grammar.GetSymbolTable().GetName(id);
+	}
+	return text;
+}
+
+void AssertIsTerminalsSingleByte(const Grammar& grammar, std::size_t rule)
+{
+	for (const SymbolId id : grammar.GetRuleRight(rule))
+	{
+		if (!grammar.IsNonTerminal(id) && grammar.GetSymbolTable().GetName(id).size() != 1)
+		{
+			throw std::invalid_argument("Terminal '" + grammar.GetSymbolTable().GetName(id)
+				+ "' must be a single byte to become an automaton symbol");
+		}
+	}
+}
+
+void AssertIsLeftSideValid(const Grammar& grammar, std::size_t rule)
+{
+	const auto left = grammar.GetRuleLeft(rule);
+	if (left.size() != 1 || !grammar.IsNonTerminal(left[0]))
+	{
+		throw std::invalid_argument("Rule '" + RuleToString(grammar, rule) + "' must have a single non-terminal on the left");
+	}
+}
+
+// Где в правой части стоит нетерминал: правило A -> B и правило без нетерминалов подходят обоим видам
+Linearity GetLinearity(const Grammar& grammar, std::size_t rule)
+{
+	AssertIsLeftSideValid(grammar, rule);
+	AssertIsTerminalsSingleByte(grammar, rule);
+	const auto right = grammar.GetRuleRight(rule);
+
+	const auto nonTerminalCount = std::count_if(right.begin(), right.end(), [&](SymbolId id) {
+		return grammar.IsNonTerminal(id);
+	});
+	if (nonTerminalCount == 0 || right.size() == 1)
+	{
+		return Linearity::ANY;
+	}
+	if (nonTerminalCount == 1 && grammar.IsNonTerminal(right.back()))
+	{
+		return Linearity::RIGHT;
+	}
+	if (nonTerminalCount == 1 && grammar.IsNonTerminal(right.front()))
+	{
+		return Linearity::LEFT;
+	}
+	throw std::invalid_argument("Rule '" + RuleToString(grammar, rule) + "' is not linear");
+}
+
+Linearity GetGrammarLinearity(const Grammar& grammar)
+{
+	Linearity result = Linearity::ANY;
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const Linearity linearity = GetLinearity(grammar, rule);
+		if (linearity == Linearity::ANY)
+		{
+			continue;
+		}
+		if (result != Linearity::ANY && result != linearity)
+		{
+			throw std::invalid_argument("Grammar mixes right-linear and left-linear rules");
+		}
+		result = linearity;
+	}
+	return result;
+}
+
+// Цепочка переходов по терминалам word из from в to, промежуточные состояния новые
+void AddPath(Automaton& nfa, const Grammar& grammar, State from, std::span<const SymbolId> word, State to, State& nextState)
+{
+	if (word.empty())
+	{
+		nfa.AddEpsilonTransition(from, to);
+		return;
+	}
+	auto symbolOf = [&](SymbolId id) {
+		return static_cast<Symbol>(grammar.GetSymbolTable().GetName(id).front());
+	};
+	for (std::size_t i = 0; i + 1 < word.size(); ++i)
+	{
+		nfa.AddTransition(from, symbolOf(word[i]), nextState);
+		from = nextState++;
+	}
+	nfa.AddTransition(from, symbolOf(word.back()), to);
+}
+
+// Имена нетерминалов: сначала S, затем заглавные буквы, затем остальные байты, не занятые терминалами
+std::vector<char> MakeNonTerminalNames(const std::set<Symbol>& alphabet, std::size_t count)
+{
+	std::string candidates = "SABCDEFGHIJKLMNOPQRTUVWXYZ";
+	for (int byte = 1; byte < 256; ++byte)
+	{
+		if (candidates.find(static_cast<char>(byte)) == std::string::npos)
+		{
+			candidates.push_back(static_cast<char>(byte));
+		}
+	}
+
+	std::vector<char> names;
+	for (const char candidate : candidates)
+	{
+		if (names.size() == count)
+		{
+			break;
+		}
+		if (!alphabet.contains(static_cast<Symbol>(candidate)))
+		{
+			names.push_back(candidate);
+		}
+	}
+	if (names.size() < count)
+	{
+		throw std::invalid_argument("Automaton has too many states to name them with single symbols");
+	}
+	return names;
+}
+} // namespace
+
+// Праволинейная: состояние на нетерминал, правило A -> wB - путь из A в B.
+// Леволинейная строится для обращенного языка тем же способом, но с обращенными путями:
+// A -> Bw - путь из B в A, A -> w - путь из нового начального состояния, финальное - стартовый символ
+Automaton GrammarConverter::ToAutomaton(const Grammar& grammar)
+{
+	AssertIsStartSymbolSet(grammar);
+	const bool isLeftLinear = GetGrammarLinearity(grammar) == Linearity::LEFT;
+
+	// Состояния нетерминалов нумеруются по номерам символов
+	constexpr State NO_STATE = std::numeric_limits<State>::max();
+	std::vector<State> states(grammar.GetSymbolTable().GetSize(), NO_STATE);
+	State nextState = 0;
+	for (SymbolId id = 0; id < states.size(); ++id)
+	{
+		if (grammar.IsNonTerminal(id))
+		{
+			states[id] = nextState++;
+		}
+	}
+	const State extraState = nextState++;
+
+	Automaton nfa;
+	nfa.SetTitle(grammar.GetName());
+	for (State state = 0; state <= extraState; ++state)
+	{
+		nfa.AddState(state);
+	}
+
+	const State start = states[grammar.GetStartSymbolId()];
+	if (isLeftLinear)
+	{
+		nfa.SetStartState(extraState);
+		nfa.AddFinalState(start);
+	}
+	else
+	{
+		nfa.SetStartState(start);
+		nfa.AddFinalState(extraState);
+	}
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const State left = states[grammar.GetRuleLeft(rule).front()];
+		const auto right = grammar.GetRuleRight(rule);
+		if (isLeftLinear)
+		{
+			const bool hasNonTerminal = !right.empty() && grammar.IsNonTerminal(right.front());
+			const State from = hasNonTerminal ? states[right.front()] : extraState;
+			AddPath(nfa, grammar, from, hasNonTerminal ? right.subspan(1) : right, left, nextState);
+			continue;
+		}
+
+		if (right.empty())
+		{
+			nfa.AddFinalState(left);
+			continue;
+		}
+		const bool hasNonTerminal = grammar.IsNonTerminal(right.back());
+		const State to = hasNonTerminal ? states[right.back()] : extraState;
+		AddPath(nfa, grammar, left, hasNonTerminal ? right.first(right.size() - 1) : right, to, nextState);
+	}
+
+	return nfa;
+}
+
+Grammar GrammarConverter::ToRightLinearGrammar(const Automaton& automaton)
+{
+	const Automaton nfa = TrimAlgorithm::Trim(automaton.HasEpsilonTransitions()
+			? EpsilonEliminationAlgorithm::RemoveEpsilon(automaton)
+			: automaton);
+
+	// Стартовое состояние получает первое имя
+	std::vector<State> order = {nfa.GetStartState()};
+	for (const State state : nfa.GetStates())
+	{
+		if (state != nfa.GetStartState())
+		{
+			order.push_back(state);
+		}
+	}
+	const auto names = MakeNonTerminalNames(nfa.GetAlphabet(), order.size());
+	std::map<State, char> nameOf;
+	for (std::size_t i = 0; i < order.size(); ++i)
+	{
+		nameOf.emplace(order[i], names[i]);
+	}
+
+	Grammar grammar;
+	grammar.SetName(nfa.GetTitle());
+	for (const Symbol symbol : nfa.GetAlphabet())
+	{
+		grammar.AddTerminal(SymbolString(1, static_cast<char>(symbol)));
+	}
+	for (const char name : names)
+	{
+		grammar.AddNonTerminal(SymbolString(1, name));
+	}
+	grammar.SetStartSymbol(SymbolString(1, nameOf.at(nfa.GetStartState())));
+
+	for (const State state : order)
+	{
+		const SymbolString left(1, nameOf.at(state));
+		const auto it = nfa.GetTransitions().find(state);
+		if (it != nfa.GetTransitions().end())
+		{
+			for (const auto& [symbol, toStates] : it->second)
+			{
+				for (const State to : toStates)
+				{
+					grammar.AddProduction({left, SymbolString{static_cast<char>(symbol), nameOf.at(to)}});
+				}
+			}
+		}
+		if (nfa.GetFinalStates().contains(state))
+		{
+			grammar.AddProduction({left, ""});
+		}
+	}
+
+	return grammar;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Automaton.h"
+#include "Grammar.h"
+
+// Переход между регулярными грамматиками и конечными автоматами за линейное время.
+// Символы грамматики односимвольные: правая часть правила читается посимвольно
+class GrammarConverter
+{
+public:
+	GrammarConverter() = default;
+	~GrammarConverter() = default;
+
+	// Право- или леволинейная грамматика в НКА. Допускаются правила A -> wB (A -> Bw) и A -> w
+	// с цепочкой терминалов w любой длины, в том числе пустой
+	static Automaton ToAutomaton(const Grammar& grammar);
+	// Праволинейная грамматика: A -> aB для перехода, A -> ε для финального состояния
+	static Grammar ToRightLinearGrammar(const Automaton& automaton);
+};
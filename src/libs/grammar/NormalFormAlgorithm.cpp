@@ -0,0 +1,630 @@
+#include "NormalFormAlgorithm.h"
+#include "SymbolGraph.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+const std::string START_SUFFIX = "'";
+
+struct WorkRule
+{
+	SymbolId left;
+	std::vector<SymbolId> right;
+
+	auto operator<=>(const WorkRule& other) const = default;
+};
+
+// Рабочая копия грамматики: новые нетерминалы добавляются без пересборки Grammar
+struct WorkGrammar
+{
+	std::string name;
+	std::vector<std::string> names;
+	std::unordered_map<std::string, SymbolId> ids;
+	std::vector<char> isTerminal;
+	SymbolId start = NO_SYMBOL;
+	std::vector<WorkRule> rules;
+
+	SymbolId AddSymbol(std::string name, bool terminal)
+	{
+		while (ids.contains(name))
+		{
+			name += START_SUFFIX;
+		}
+		const auto id = static_cast<SymbolId>(names.size());
+		ids.emplace(name, id);
+		names.push_back(std::move(name));
+		isTerminal.push_back(terminal);
+		return id;
+	}
+
+	std::size_t GetSymbolCount() const
+	{
+		return names.size();
+	}
+};
+
+void AssertIsContextFree(const Grammar& grammar, std::size_t rule)
+{
+	const auto left = grammar.GetRuleLeft(rule);
+	if (left.size() != 1 || !grammar.IsNonTerminal(left[0]))
+	{
+		throw std::invalid_argument("Grammar is not context-free: rule " + std::to_string(rule)
+			+ " has more than one symbol on the left");
+	}
+}
+
+void AssertHasStartSymbol(const Grammar& grammar)
+{
+	if (grammar.GetStartSymbolId() == NO_SYMBOL)
+	{
+		throw std::invalid_argument("Grammar start symbol is not set");
+	}
+}
+
+WorkGrammar ToWorkGrammar(const Grammar& grammar)
+{
+	AssertHasStartSymbol(grammar);
+
+	WorkGrammar work;
+	work.name = grammar.GetName();
+	const auto& table = grammar.GetSymbolTable();
+	for (SymbolId id = 0; id < table.GetSize(); ++id)
+	{
+		work.AddSymbol(table.GetName(id), !grammar.IsNonTerminal(id));
+	}
+	work.start = grammar.GetStartSymbolId();
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		AssertIsContextFree(grammar, rule);
+		const auto right = grammar.GetRuleRight(rule);
+		work.rules.push_back({grammar.GetRuleLeft(rule)[0], {right.begin(), right.end()}});
+	}
+	return work;
+}
+
+Grammar ToGrammar(const WorkGrammar& work)
+{
+	Grammar grammar;
+	grammar.SetName(work.name);
+
+	std::vector<char> used(work.GetSymbolCount(), false);
+	used[work.start] = true;
+	for (const auto& rule : work.rules)
+	{
+		used[rule.left] = true;
+		for (const SymbolId symbol : rule.right)
+		{
+			used[symbol] = true;
+		}
+	}
+	for (SymbolId id = 0; id < work.GetSymbolCount(); ++id)
+	{
+		if (work.isTerminal[id])
+		{
+			grammar.AddTerminal(work.names[id]);
+		}
+		else if (used[id])
+		{
+			grammar.AddNonTerminal(work.names[id]);
+		}
+	}
+	grammar.SetStartSymbol(work.names[work.start]);
+
+	// Номера в новой таблице символов отличаются от рабочих
+	std::vector<SymbolId> ids(work.GetSymbolCount(), NO_SYMBOL);
+	for (SymbolId id = 0; id < work.GetSymbolCount(); ++id)
+	{
+		if (const auto found = grammar.GetSymbolTable().Find(work.names[id]))
+		{
+			ids[id] = *found;
+		}
+	}
+
+	std::vector<SymbolId> right;
+	for (const auto& rule : work.rules)
+	{
+		right.clear();
+		for (const SymbolId symbol : rule.right)
+		{
+			right.push_back(ids[symbol]);
+		}
+		const SymbolId left = ids[rule.left];
+		grammar.AddRule(std::span<const SymbolId>(&left, 1), right);
+	}
+	return grammar;
+}
+
+void SortUnique(std::vector<WorkRule>& rules)
+{
+	std::sort(rules.begin(), rules.end());
+	rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+}
+
+// Новый стартовый символ, не встречающийся в правых частях
+void AddStartRule(WorkGrammar& work)
+{
+	const SymbolId start = work.AddSymbol(work.names[work.start] + START_SUFFIX, false);
+	work.rules.push_back({start, {work.start}});
+	work.start = start;
+}
+
+// Терминалы в правилах длины больше 1 заменяются нетерминалами X -> a
+void ReplaceTerminals(WorkGrammar& work)
+{
+	std::vector<SymbolId> replacements(work.GetSymbolCount(), NO_SYMBOL);
+	const std::size_t ruleCount = work.rules.size();
+	for (std::size_t i = 0; i < ruleCount; ++i)
+	{
+		if (work.rules[i].right.size() < 2)
+		{
+			continue;
+		}
+		for (std::size_t j = 0; j < work.rules[i].right.size(); ++j)
+		{
+			const SymbolId symbol = work.rules[i].right[j];
+			if (!work.isTerminal[symbol])
+			{
+				continue;
+			}
+			if (replacements[symbol] == NO_SYMBOL)
+			{
+				replacements[symbol] = work.AddSymbol("<" + work.names[symbol] + ">", false);
+				work.rules.push_back({replacements[symbol], {symbol}});
+			}
+			work.rules[i].right[j] = replacements[symbol];
+		}
+	}
+}
+
+// A -> X1 X2 ... Xk превращается в цепочку A -> X1 A1, A1 -> X2 A2, ..., A(k-2) -> X(k-1) Xk
+void Binarize(WorkGrammar& work)
+{
+	const std::size_t ruleCount = work.rules.size();
+	for (std::size_t i = 0; i < ruleCount; ++i)
+	{
+		if (work.rules[i].right.size() <= 2)
+		{
+			continue;
+		}
+
+		std::vector<SymbolId> right = std::move(work.rules[i].right);
+		SymbolId left = work.rules[i].left;
+		const std::string base = work.names[left];
+		for (std::size_t j = 0; j + 2 < right.size(); ++j)
+		{
+			const SymbolId next = work.AddSymbol(base + "." + std::to_string(j + 1), false);
+			if (j == 0)
+			{
+				work.rules[i].right = {right[j], next};
+			}
+			else
+			{
+				work.rules.push_back({left, {right[j], next}});
+			}
+			left = next;
+		}
+		work.rules.push_back({left, {right[right.size() - 2], right.back()}});
+	}
+}
+
+// Обнуляемые нетерминалы: счетчик необнуляемых символов в каждом правиле и обратный индекс символ -> правила
+std::vector<char> FindNullable(const WorkGrammar& work)
+{
+	std::vector<char> nullable(work.GetSymbolCount(), false);
+	std::vector<std::size_t> pending(work.rules.size(), 0);
+	std::vector<std::vector<std::size_t>> occurrences(work.GetSymbolCount());
+	std::vector<SymbolId> queue;
+
+	for (std::size_t i = 0; i < work.rules.size(); ++i)
+	{
+		pending[i] = work.rules[i].right.size();
+		for (const SymbolId symbol : work.rules[i].right)
+		{
+			occurrences[symbol].push_back(i);
+		}
+		if (pending[i] == 0 && !nullable[work.rules[i].left])
+		{
+			nullable[work.rules[i].left] = true;
+			queue.push_back(work.rules[i].left);
+		}
+	}
+
+	while (!queue.empty())
+	{
+		const SymbolId symbol = queue.back();
+		queue.pop_back();
+		for (const std::size_t rule : occurrences[symbol])
+		{
+			if (--pending[rule] == 0 && !nullable[work.rules[rule].left])
+			{
+				nullable[work.rules[rule].left] = true;
+				queue.push_back(work.rules[rule].left);
+			}
+		}
+	}
+	return nullable;
+}
+
+bool IsStartOnRight(const WorkGrammar& work)
+{
+	return std::any_of(work.rules.begin(), work.rules.end(), [&](const WorkRule& rule) {
+		return std::find(rule.right.begin(), rule.right.end(), work.start) != rule.right.end();
+	});
+}
+
+// Каждое правило дает варианты без любой части обнуляемых вхождений: 2^k вариантов при k вхождениях.
+// После бинаризации k не больше двух
+void EliminateEpsilonRules(WorkGrammar& work)
+{
+	const auto nullable = FindNullable(work);
+	std::vector<WorkRule> rules;
+	std::vector<std::vector<SymbolId>> variants;
+	for (auto& rule : work.rules)
+	{
+		variants.assign(1, {});
+		for (const SymbolId symbol : rule.right)
+		{
+			const std::size_t count = variants.size();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (nullable[symbol])
+				{
+					variants.push_back(variants[i]);
+				}
+				variants[i].push_back(symbol);
+			}
+		}
+		for (auto& right : variants)
+		{
+			if (!right.empty())
+			{
+				rules.push_back({rule.left, std::move(right)});
+			}
+		}
+	}
+	if (nullable[work.start])
+	{
+		rules.push_back({work.start, {}});
+	}
+	work.rules = std::move(rules);
+	SortUnique(work.rules);
+}
+
+// Пустое слово остается за стартовым символом, поэтому старт не должен встречаться справа
+void EliminateEpsilonRulesKeepingStart(WorkGrammar& work)
+{
+	if (FindNullable(work)[work.start] && IsStartOnRight(work))
+	{
+		AddStartRule(work);
+	}
+	EliminateEpsilonRules(work);
+}
+
+// Для каждого A правила A -> α берутся у всех B, достижимых из A по цепным правилам A -> B
+void EliminateUnitRules(WorkGrammar& work)
+{
+	auto isUnit = [&](const WorkRule& rule) {
+		return rule.right.size() == 1 && !work.isTerminal[rule.right[0]];
+	};
+
+	std::vector<std::vector<SymbolId>> unitTargets(work.GetSymbolCount());
+	std::vector<std::vector<std::size_t>> ownRules(work.GetSymbolCount());
+	for (std::size_t i = 0; i < work.rules.size(); ++i)
+	{
+		if (isUnit(work.rules[i]))
+		{
+			unitTargets[work.rules[i].left].push_back(work.rules[i].right[0]);
+		}
+		else
+		{
+			ownRules[work.rules[i].left].push_back(i);
+		}
+	}
+
+	std::vector<WorkRule> rules;
+	std::vector<std::size_t> visitedBy(work.GetSymbolCount(), NO_SYMBOL);
+	std::vector<SymbolId> stack;
+	for (SymbolId symbol = 0; symbol < work.GetSymbolCount(); ++symbol)
+	{
+		if (work.isTerminal[symbol])
+		{
+			continue;
+		}
+		visitedBy[symbol] = symbol;
+		stack.push_back(symbol);
+		while (!stack.empty())
+		{
+			const SymbolId current = stack.back();
+			stack.pop_back();
+			for (const std::size_t rule : ownRules[current])
+			{
+				rules.push_back({symbol, work.rules[rule].right});
+			}
+			for (const SymbolId target : unitTargets[current])
+			{
+				if (visitedBy[target] != symbol)
+				{
+					visitedBy[target] = symbol;
+					stack.push_back(target);
+				}
+			}
+		}
+	}
+	work.rules = std::move(rules);
+	SortUnique(work.rules);
+}
+
+// Нетерминалы одного цикла цепных правил A -> B -> ... -> A выводят одно и то же, поэтому
+// сливаются в один (в старт, если он среди них); ацикличные цепные правила остаются.
+// Циклы - компоненты сильной связности графа цепных правил, один проход Тарьяна
+void EliminateUnitCycles(WorkGrammar& work)
+{
+	std::vector<std::vector<SymbolId>> unitEdges(work.GetSymbolCount());
+	for (const auto& rule : work.rules)
+	{
+		if (rule.right.size() == 1 && !work.isTerminal[rule.right[0]])
+		{
+			unitEdges[rule.left].push_back(rule.right[0]);
+		}
+	}
+	const auto component = SymbolGraph::FindComponents(work.GetSymbolCount(), unitEdges);
+
+	std::vector<SymbolId> representative(work.GetSymbolCount(), NO_SYMBOL);
+	representative[component[work.start]] = work.start;
+	for (SymbolId symbol = 0; symbol < work.GetSymbolCount(); ++symbol)
+	{
+		if (representative[component[symbol]] == NO_SYMBOL)
+		{
+			representative[component[symbol]] = symbol;
+		}
+	}
+
+	auto rename = [&](SymbolId symbol) {
+		return representative[component[symbol]];
+	};
+	std::vector<WorkRule> rules;
+	for (auto& rule : work.rules)
+	{
+		rule.left = rename(rule.left);
+		std::ranges::transform(rule.right, rule.right.begin(), rename);
+		if (rule.right.size() != 1 || rule.right[0] != rule.left)
+		{
+			rules.push_back(std::move(rule));
+		}
+	}
+	work.rules = std::move(rules);
+	SortUnique(work.rules);
+}
+
+// Остаются нетерминалы, из которых выводится терминальная цепочка и которые достижимы из старта
+void EliminateUselessRules(WorkGrammar& work)
+{
+	std::vector<char> generating(work.GetSymbolCount(), false);
+	std::vector<std::size_t> pending(work.rules.size(), 0);
+	std::vector<std::vector<std::size_t>> occurrences(work.GetSymbolCount());
+	std::vector<SymbolId> queue;
+	for (SymbolId symbol = 0; symbol < work.GetSymbolCount(); ++symbol)
+	{
+		generating[symbol] = work.isTerminal[symbol];
+	}
+	for (std::size_t i = 0; i < work.rules.size(); ++i)
+	{
+		for (const SymbolId symbol : work.rules[i].right)
+		{
+			if (!work.isTerminal[symbol])
+			{
+				pending[i]++;
+				occurrences[symbol].push_back(i);
+			}
+		}
+		if (pending[i] == 0 && !generating[work.rules[i].left])
+		{
+			generating[work.rules[i].left] = true;
+			queue.push_back(work.rules[i].left);
+		}
+	}
+	while (!queue.empty())
+	{
+		const SymbolId symbol = queue.back();
+		queue.pop_back();
+		for (const std::size_t rule : occurrences[symbol])
+		{
+			if (--pending[rule] == 0 && !generating[work.rules[rule].left])
+			{
+				generating[work.rules[rule].left] = true;
+				queue.push_back(work.rules[rule].left);
+			}
+		}
+	}
+
+	std::vector<std::vector<std::size_t>> ownRules(work.GetSymbolCount());
+	for (std::size_t i = 0; i < work.rules.size(); ++i)
+	{
+		if (pending[i] == 0)
+		{
+			ownRules[work.rules[i].left].push_back(i);
+		}
+	}
+	std::vector<char> reachable(work.GetSymbolCount(), false);
+	reachable[work.start] = true;
+	queue.push_back(work.start);
+	std::vector<WorkRule> rules;
+	while (!queue.empty())
+	{
+		const SymbolId symbol = queue.back();
+		queue.pop_back();
+		for (const std::size_t rule : ownRules[symbol])
+		{
+			for (const SymbolId target : work.rules[rule].right)
+			{
+				if (!reachable[target])
+				{
+					reachable[target] = true;
+					queue.push_back(target);
+				}
+			}
+			rules.push_back(std::move(work.rules[rule]));
+		}
+	}
+	work.rules = std::move(rules);
+	SortUnique(work.rules);
+}
+
+// Алгоритм Пола: нетерминалы обходятся по номерам, правило A -> Bγ с уже обработанным B
+// раскрывается альтернативами B, затем непосредственная рекурсия A -> Aα | β заменяется на
+// A -> βA', A' -> αA' | ε. Грамматика не должна содержать ε-правил, кроме S -> ε, и циклов A =>+ A
+void EliminateLeftRecursion(WorkGrammar& work)
+{
+	const std::size_t symbolCount = work.GetSymbolCount();
+	std::vector<std::vector<std::vector<SymbolId>>> alternatives(symbolCount);
+	for (auto& rule : work.rules)
+	{
+		alternatives[rule.left].push_back(std::move(rule.right));
+	}
+
+	std::vector<WorkRule> tailRules;
+	std::vector<char> processed(symbolCount, false);
+	std::vector<std::vector<SymbolId>> pending;
+	std::vector<std::vector<SymbolId>> recursive;
+	for (SymbolId symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		if (work.isTerminal[symbol])
+		{
+			continue;
+		}
+
+		pending = std::move(alternatives[symbol]);
+		alternatives[symbol].clear();
+		recursive.clear();
+		while (!pending.empty())
+		{
+			auto right = std::move(pending.back());
+			pending.pop_back();
+			if (!right.empty() && right[0] < symbolCount && processed[right[0]])
+			{
+				for (const auto& prefix : alternatives[right[0]])
+				{
+					std::vector<SymbolId> expanded = prefix;
+					expanded.insert(expanded.end(), right.begin() + 1, right.end());
+					pending.push_back(std::move(expanded));
+				}
+			}
+			else if (!right.empty() && right[0] == symbol)
+			{
+				// A -> A ничего не добавляет к языку
+				if (right.size() > 1)
+				{
+					recursive.emplace_back(right.begin() + 1, right.end());
+				}
+			}
+			else
+			{
+				alternatives[symbol].push_back(std::move(right));
+			}
+		}
+
+		if (!recursive.empty())
+		{
+			const SymbolId tail = work.AddSymbol(work.names[symbol] + START_SUFFIX, false);
+			for (auto& right : alternatives[symbol])
+			{
+				right.push_back(tail);
+			}
+			for (auto& right : recursive)
+			{
+				right.push_back(tail);
+				tailRules.push_back({tail, std::move(right)});
+			}
+			tailRules.push_back({tail, {}});
+		}
+		processed[symbol] = true;
+	}
+
+	work.rules = std::move(tailRules);
+	for (SymbolId symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		for (auto& right : alternatives[symbol])
+		{
+			work.rules.push_back({symbol, std::move(right)});
+		}
+	}
+	SortUnique(work.rules);
+}
+} // namespace
+
+// Порядок шагов START, TERM, BIN, DEL, UNIT не дает правилам разрастаться экспоненциально
+Grammar NormalFormAlgorithm::ToChomskyNormalForm(const Grammar& grammar)
+{
+	WorkGrammar work = ToWorkGrammar(grammar);
+	AddStartRule(work);
+	ReplaceTerminals(work);
+	Binarize(work);
+	EliminateEpsilonRules(work);
+	EliminateUnitRules(work);
+	EliminateUselessRules(work);
+	return ToGrammar(work);
+}
+
+Grammar NormalFormAlgorithm::RemoveUselessSymbols(const Grammar& grammar)
+{
+	WorkGrammar work = ToWorkGrammar(grammar);
+	EliminateUselessRules(work);
+	return ToGrammar(work);
+}
+
+Grammar NormalFormAlgorithm::RemoveEpsilonRules(const Grammar& grammar)
+{
+	WorkGrammar work = ToWorkGrammar(grammar);
+	EliminateEpsilonRulesKeepingStart(work);
+	return ToGrammar(work);
+}
+
+Grammar NormalFormAlgorithm::RemoveUnitRules(const Grammar& grammar)
+{
+	WorkGrammar work = ToWorkGrammar(grammar);
+	EliminateUnitRules(work);
+	return ToGrammar(work);
+}
+
+// Пустые правила могли бы спрятать левую рекурсию (A -> B A при обнуляемом B), поэтому удаляются первыми.
+// Без ε-правил цикл A =>+ A возможен только по цепным правилам, такие нетерминалы сливаются
+Grammar NormalFormAlgorithm::RemoveLeftRecursion(const Grammar& grammar)
+{
+	WorkGrammar work = ToWorkGrammar(grammar);
+	EliminateEpsilonRulesKeepingStart(work);
+	EliminateUnitCycles(work);
+	EliminateLeftRecursion(work);
+	return ToGrammar(work);
+}
+
+bool NormalFormAlgorithm::IsChomskyNormalForm(const Grammar& grammar)
+{
+	const SymbolId start = grammar.GetStartSymbolId();
+	bool startOnRight = false;
+	bool hasEpsilonRule = false;
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const auto left = grammar.GetRuleLeft(rule);
+		const auto right = grammar.GetRuleRight(rule);
+		if (left.size() != 1 || !grammar.IsNonTerminal(left[0]))
+		{
+			return false;
+		}
+
+		const bool isTerminalRule = right.size() == 1 && grammar.IsTerminal(right[0]) && !grammar.IsNonTerminal(right[0]);
+		const bool isBinaryRule = right.size() == 2 && grammar.IsNonTerminal(right[0]) && grammar.IsNonTerminal(right[1]);
+		const bool isStartEpsilon = right.empty() && left[0] == start;
+		if (!isTerminalRule && !isBinaryRule && !isStartEpsilon)
+		{
+			return false;
+		}
+		hasEpsilonRule = hasEpsilonRule || isStartEpsilon;
+		startOnRight = startOnRight || std::find(right.begin(), right.end(), start) != right.end();
+	}
+	return !(hasEpsilonRule && startOnRight);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Grammar.h"
+
+// Преобразования контекстно-свободной грамматики, сохраняющие язык. Обнуляемые и порождающие символы
+// ищутся рабочим списком по обратным индексам (символ -> правила, где он встречается), циклы цепных правил -
+// одним проходом Тарьяна.
+// Новые нетерминалы получают имя исходного со штрихом, терминалы остаются объявленными
+class NormalFormAlgorithm
+{
+public:
+	NormalFormAlgorithm() = default;
+	~NormalFormAlgorithm() = default;
+
+	// Правила A -> BC и A -> a, плюс S' -> ε, если язык содержит пустое слово (S' не встречается справа)
+	static Grammar ToChomskyNormalForm(const Grammar& grammar);
+	static bool IsChomskyNormalForm(const Grammar& grammar);
+
+	// Удаляет непорождающие нетерминалы, затем недостижимые из стартового
+	static Grammar RemoveUselessSymbols(const Grammar& grammar);
+	// ε-правило остается только у стартового символа; если он встречается справа, добавляется S' -> S | ε
+	static Grammar RemoveEpsilonRules(const Grammar& grammar);
+	// Правила A -> B заменяются правилами всех нетерминалов, достижимых из A по цепным правилам
+	static Grammar RemoveUnitRules(const Grammar& grammar);
+	// Грамматика без левой рекурсии для LL-разбора. Сначала удаляются ε-правила и циклы цепных правил
+	static Grammar RemoveLeftRecursion(const Grammar& grammar);
+};
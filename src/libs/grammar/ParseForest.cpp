@@ -0,0 +1,162 @@
+#include "ParseForest.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr std::uint64_t INFINITE_TREES = std::numeric_limits<std::uint64_t>::max();
+
+std::uint64_t SaturatingMultiply(std::uint64_t left, std::uint64_t right)
+{
+	if (left != 0 && right > INFINITE_TREES / left)
+	{
+		return INFINITE_TREES;
+	}
+	return left * right;
+}
+
+std::uint64_t SaturatingAdd(std::uint64_t left, std::uint64_t right)
+{
+	return right > INFINITE_TREES - left ? INFINITE_TREES : left + right;
+}
+} // namespace
+
+ParseForest::NodeId ParseForest::AddNode(const Node& node)
+{
+	if (m_nodes.size() >= NO_NODE)
+	{
+		throw std::length_error("Too many nodes in parse forest");
+	}
+	m_nodes.push_back(node);
+	m_packedOffsets.emplace_back(m_packed.size(), m_packed.size());
+	return static_cast<NodeId>(m_nodes.size() - 1);
+}
+
+void ParseForest::SetPacked(NodeId node, std::span<const PackedNode> packed)
+{
+	AssertNodeExists(node);
+	auto& [first, last] = m_packedOffsets[node];
+	if (first != last)
+	{
+		throw std::invalid_argument("Packed nodes of node " + std::to_string(node) + " are already set");
+	}
+	for (const auto& variant : packed)
+	{
+		if ((variant.left != NO_NODE && variant.left >= m_nodes.size())
+			|| (variant.right != NO_NODE && variant.right >= m_nodes.size()))
+		{
+			throw std::invalid_argument("Packed node refers to an unknown node");
+		}
+	}
+	first = m_packed.size();
+	m_packed.insert(m_packed.end(), packed.begin(), packed.end());
+	last = m_packed.size();
+}
+
+void ParseForest::SetRoot(NodeId root)
+{
+	AssertNodeExists(root);
+	m_root = root;
+}
+
+ParseForest::NodeId ParseForest::GetRoot() const
+{
+	return m_root;
+}
+
+std::size_t ParseForest::GetNodeCount() const
+{
+	return m_nodes.size();
+}
+
+std::size_t ParseForest::GetPackedCount() const
+{
+	return m_packed.size();
+}
+
+const ParseForest::Node& ParseForest::GetNode(NodeId node) const
+{
+	AssertNodeExists(node);
+	return m_nodes[node];
+}
+
+std::span<const ParseForest::PackedNode> ParseForest::GetPacked(NodeId node) const
+{
+	AssertNodeExists(node);
+	const auto [first, last] = m_packedOffsets[node];
+	return std::span(m_packed).subspan(first, last - first);
+}
+
+bool ParseForest::IsAmbiguous() const
+{
+	return std::any_of(m_packedOffsets.begin(), m_packedOffsets.end(), [](const auto& offsets) {
+		return offsets.second - offsets.first > 1;
+	});
+}
+
+// Обход в глубину без рекурсии: узел считается после всех детей. Повторный вход в узел на стеке - цикл
+std::uint64_t ParseForest::CountTrees() const
+{
+	if (m_root == NO_NODE)
+	{
+		return 0;
+	}
+
+	enum class Mark : char
+	{
+		NEW,
+		ON_STACK,
+		DONE
+	};
+	std::vector<Mark> marks(m_nodes.size(), Mark::NEW);
+	std::vector<std::uint64_t> counts(m_nodes.size(), 0);
+	std::vector<std::pair<NodeId, std::size_t>> stack = {{m_root, 0}};
+	marks[m_root] = Mark::ON_STACK;
+
+	while (!stack.empty())
+	{
+		auto& [node, child] = stack.back();
+		const auto packed = GetPacked(node);
+		// Дети упакованного узла i - номера 2i и 2i + 1
+		if (child < 2 * packed.size())
+		{
+			const PackedNode& variant = packed[child / 2];
+			const NodeId next = child % 2 == 0 ? variant.left : variant.right;
+			++child;
+			if (next == NO_NODE || marks[next] == Mark::DONE)
+			{
+				continue;
+			}
+			if (marks[next] == Mark::ON_STACK)
+			{
+				return INFINITE_TREES;
+			}
+			marks[next] = Mark::ON_STACK;
+			stack.emplace_back(next, 0);
+			continue;
+		}
+
+		// Лист терминала - одно дерево
+		std::uint64_t count = packed.empty() ? 1 : 0;
+		for (const auto& variant : packed)
+		{
+			const std::uint64_t left = variant.left == NO_NODE ? 1 : counts[variant.left];
+			const std::uint64_t right = variant.right == NO_NODE ? 1 : counts[variant.right];
+			count = SaturatingAdd(count, SaturatingMultiply(left, right));
+		}
+		counts[node] = count;
+		marks[node] = Mark::DONE;
+		stack.pop_back();
+	}
+	return counts[m_root];
+}
+
+void ParseForest::AssertNodeExists(NodeId node) const
+{
+	if (node >= m_nodes.size())
+	{
+		throw std::out_of_range("Parse forest has no node " + std::to_string(node));
+	}
+}
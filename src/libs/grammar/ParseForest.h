@@ -0,0 +1,68 @@
+#pragma once
+
+#include "SymbolTable.h"
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Разделяемый упакованный лес разбора (SPPF, Scott): все деревья вывода слова в одном графе.
+// Узел символа (X, begin, end) - X выводит w[begin..end), промежуточный узел (rule, dot, begin, end) -
+// префикс длины dot правой части правила выводит w[begin..end). Варианты разбора узла - упакованные узлы
+// с точкой разбиения pivot: левый ребенок - префикс без последнего символа на [begin, pivot),
+// правый - последний символ на [pivot, end). Так каждый упакованный узел двоичный, и лес имеет кубический размер
+class ParseForest
+{
+public:
+	using NodeId = std::uint32_t;
+
+	static constexpr NodeId NO_NODE = std::numeric_limits<NodeId>::max();
+
+	struct Node
+	{
+		// NO_SYMBOL - промежуточный узел
+		SymbolId symbol;
+		// Только у промежуточного узла
+		std::size_t rule;
+		std::size_t dot;
+		std::size_t begin;
+		std::size_t end;
+	};
+
+	struct PackedNode
+	{
+		std::size_t rule;
+		std::size_t pivot;
+		// NO_NODE - префикс пуст
+		NodeId left;
+		// NO_NODE - пустое правило
+		NodeId right;
+	};
+
+	NodeId AddNode(const Node& node);
+	// Варианты разбора узла задаются один раз
+	void SetPacked(NodeId node, std::span<const PackedNode> packed);
+	void SetRoot(NodeId root);
+
+	NodeId GetRoot() const;
+	std::size_t GetNodeCount() const;
+	std::size_t GetPackedCount() const;
+	const Node& GetNode(NodeId node) const;
+	std::span<const PackedNode> GetPacked(NodeId node) const;
+
+	// Есть узел с несколькими вариантами разбора
+	bool IsAmbiguous() const;
+	// Число деревьев вывода; при переполнении и для циклического леса (A -> A) - максимум uint64
+	std::uint64_t CountTrees() const;
+
+private:
+	void AssertNodeExists(NodeId node) const;
+
+	std::vector<Node> m_nodes;
+	// Варианты узла i - m_packed[m_packedOffsets[i].first..second)
+	std::vector<std::pair<std::size_t, std::size_t>> m_packedOffsets;
+	std::vector<PackedNode> m_packed;
+	NodeId m_root = NO_NODE;
+};
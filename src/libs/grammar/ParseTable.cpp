@@ -0,0 +1,482 @@
+#include "ParseTable.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+const std::string END_OF_INPUT_NAME = "$";
+const std::string EMPTY_RULE_NAME = "ε";
+
+void AssertIndexInRange(std::size_t index, std::size_t size, const char* what)
+{
+	if (index >= size)
+	{
+		throw std::out_of_range(std::string(what) + " " + std::to_string(index) + " is out of range");
+	}
+}
+
+// Одинаковые строки таблицы получают один номер: строки сортируются и склеиваются соседние равные.
+// Ширина строки не нулевая: в таблице всегда есть конец входа и стартовый нетерминал
+void CompactRows(std::vector<std::uint32_t>& cells, std::size_t width, std::vector<std::uint32_t>& rows)
+{
+	auto row = [&](std::uint32_t index) {
+		return std::span(cells).subspan(index * width, width);
+	};
+	std::vector<std::uint32_t> order(rows.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](std::uint32_t left, std::uint32_t right) {
+		const auto leftRow = row(left);
+		const auto rightRow = row(right);
+		return std::lexicographical_compare(leftRow.begin(), leftRow.end(), rightRow.begin(), rightRow.end());
+	});
+
+	std::vector<std::uint32_t> compacted;
+	for (std::size_t i = 0; i < order.size(); ++i)
+	{
+		if (i == 0 || !std::ranges::equal(row(order[i]), row(order[i - 1])))
+		{
+			const auto current = row(order[i]);
+			compacted.insert(compacted.end(), current.begin(), current.end());
+		}
+		rows[order[i]] = static_cast<std::uint32_t>(compacted.size() / width - 1);
+	}
+	cells = std::move(compacted);
+}
+} // namespace
+
+TableGrammar::TableGrammar(const Grammar& grammar, const GrammarAnalysis& analysis)
+	: m_symbols(grammar.GetSymbolTable())
+	, m_start(analysis.GetNonTerminalIndex(grammar.GetStartSymbolId()))
+{
+	const std::size_t symbolCount = m_symbols.GetSize();
+	m_terminalIndices.resize(symbolCount);
+	for (SymbolId symbol = 0; symbol < symbolCount; ++symbol)
+	{
+		m_terminalIndices[symbol] = analysis.GetTerminalIndex(symbol);
+	}
+	for (std::size_t terminal = 0; terminal < analysis.GetTerminalCount(); ++terminal)
+	{
+		m_terminals.push_back(analysis.GetTerminal(terminal));
+	}
+	for (std::size_t nonTerminal = 0; nonTerminal < analysis.GetNonTerminalCount(); ++nonTerminal)
+	{
+		m_nonTerminals.push_back(analysis.GetNonTerminal(nonTerminal));
+	}
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		m_ruleLeft.push_back(analysis.GetNonTerminalIndex(grammar.GetRuleLeft(rule)[0]));
+		for (const SymbolId symbol : grammar.GetRuleRight(rule))
+		{
+			const std::size_t terminal = analysis.GetTerminalIndex(symbol);
+			m_ruleSymbols.push_back(static_cast<std::uint32_t>(terminal != GrammarAnalysis::NO_INDEX
+					? terminal
+					: m_terminals.size() + analysis.GetNonTerminalIndex(symbol)));
+		}
+		m_ruleOffsets.push_back(m_ruleSymbols.size());
+	}
+}
+
+std::size_t TableGrammar::GetTerminalCount() const
+{
+	return m_terminals.size();
+}
+
+std::size_t TableGrammar::GetNonTerminalCount() const
+{
+	return m_nonTerminals.size();
+}
+
+std::size_t TableGrammar::GetEndOfInputIndex() const
+{
+	return m_terminals.size() - 1;
+}
+
+std::vector<std::size_t> TableGrammar::ToTerminalIndices(std::span<const std::string_view> tokens) const
+{
+	std::vector<std::size_t> terminals;
+	terminals.reserve(tokens.size());
+	for (const auto token : tokens)
+	{
+		const auto id = m_symbols.Find(token);
+		const std::size_t index = id ? m_terminalIndices[*id] : GrammarAnalysis::NO_INDEX;
+		terminals.push_back(index == GrammarAnalysis::NO_INDEX ? GetTerminalCount() : index);
+	}
+	return terminals;
+}
+
+std::vector<std::size_t> TableGrammar::ToTerminalIndices(std::string_view word) const
+{
+	std::vector<std::string_view> tokens;
+	tokens.reserve(word.size());
+	for (std::size_t i = 0; i < word.size(); ++i)
+	{
+		tokens.push_back(word.substr(i, 1));
+	}
+	return ToTerminalIndices(tokens);
+}
+
+std::size_t TableGrammar::GetStartIndex() const
+{
+	return m_start;
+}
+
+std::size_t TableGrammar::GetRuleCount() const
+{
+	return m_ruleLeft.size();
+}
+
+std::size_t TableGrammar::GetRuleLeft(std::size_t rule) const
+{
+	return m_ruleLeft.at(rule);
+}
+
+std::span<const std::uint32_t> TableGrammar::GetRuleRight(std::size_t rule) const
+{
+	AssertIndexInRange(rule, GetRuleCount(), "Rule");
+	return std::span(m_ruleSymbols).subspan(m_ruleOffsets[rule], m_ruleOffsets[rule + 1] - m_ruleOffsets[rule]);
+}
+
+std::string TableGrammar::GetTerminalName(std::size_t terminal) const
+{
+	AssertIndexInRange(terminal, GetTerminalCount(), "Terminal");
+	return terminal == GetEndOfInputIndex() ? END_OF_INPUT_NAME : m_symbols.GetName(m_terminals[terminal]);
+}
+
+std::string TableGrammar::RuleToString(std::size_t rule) const
+{
+	const auto right = GetRuleRight(rule);
+	std::string text = m_symbols.GetName(m_nonTerminals[m_ruleLeft[rule]]) + " ->";
+	for (const auto symbol : right)
+	{
+		text += " " + GetSymbolName(symbol);
+	}
+	return right.empty() ? text + " " + EMPTY_RULE_NAME : text;
+}
+
+std::string TableGrammar::GetSymbolName(std::uint32_t symbol) const
+{
+	return symbol < GetTerminalCount() ? GetTerminalName(symbol)
+									   : m_symbols.GetName(m_nonTerminals[symbol - GetTerminalCount()]);
+}
+
+LlTable::LlTable(TableGrammar grammar)
+	: m_grammar(std::move(grammar))
+	, m_rules(m_grammar.GetNonTerminalCount() * m_grammar.GetTerminalCount(), NO_RULE)
+{
+}
+
+void LlTable::SetRule(std::size_t nonTerminal, std::size_t lookahead, std::size_t rule)
+{
+	AssertIndexInRange(nonTerminal, m_grammar.GetNonTerminalCount(), "Non-terminal");
+	AssertIndexInRange(lookahead, m_grammar.GetTerminalCount(), "Terminal");
+	AssertIndexInRange(rule, m_grammar.GetRuleCount(), "Rule");
+
+	std::uint32_t& cell = m_rules[nonTerminal * m_grammar.GetTerminalCount() + lookahead];
+	if (cell == NO_RULE)
+	{
+		cell = static_cast<std::uint32_t>(rule);
+		return;
+	}
+	if (cell != rule)
+	{
+		const std::size_t chosen = std::min<std::size_t>(cell, rule);
+		m_conflicts.push_back({nonTerminal, lookahead, chosen, std::max<std::size_t>(cell, rule)});
+		cell = static_cast<std::uint32_t>(chosen);
+	}
+}
+
+std::uint32_t LlTable::GetRule(std::size_t nonTerminal, std::size_t lookahead) const
+{
+	AssertIndexInRange(nonTerminal, m_grammar.GetNonTerminalCount(), "Non-terminal");
+	AssertIndexInRange(lookahead, m_grammar.GetTerminalCount(), "Terminal");
+	return m_rules[nonTerminal * m_grammar.GetTerminalCount() + lookahead];
+}
+
+const TableGrammar& LlTable::GetGrammar() const
+{
+	return m_grammar;
+}
+
+const std::vector<LlTable::Conflict>& LlTable::GetConflicts() const
+{
+	return m_conflicts;
+}
+
+std::vector<std::string> LlTable::DescribeConflicts() const
+{
+	std::vector<std::string> descriptions;
+	for (const auto& conflict : m_conflicts)
+	{
+		descriptions.push_back("Lookahead '" + m_grammar.GetTerminalName(conflict.lookahead) + "': "
+			+ m_grammar.RuleToString(conflict.chosenRule) + " over " + m_grammar.RuleToString(conflict.rejectedRule));
+	}
+	return descriptions;
+}
+
+std::optional<std::vector<std::size_t>> LlTable::Parse(std::span<const std::string_view> tokens) const
+{
+	return ParseTerminals(m_grammar.ToTerminalIndices(tokens));
+}
+
+std::optional<std::vector<std::size_t>> LlTable::Parse(std::string_view word) const
+{
+	return ParseTerminals(m_grammar.ToTerminalIndices(word));
+}
+
+// Магазин хранит символы в кодировке TableGrammar::GetRuleRight
+std::optional<std::vector<std::size_t>> LlTable::ParseTerminals(std::span<const std::size_t> terminals) const
+{
+	if (!m_conflicts.empty())
+	{
+		throw std::logic_error("LL(1) table has conflicts");
+	}
+
+	const std::size_t terminalCount = m_grammar.GetTerminalCount();
+	std::vector<std::uint32_t> stack = {static_cast<std::uint32_t>(terminalCount + m_grammar.GetStartIndex())};
+	std::vector<std::size_t> rules;
+	std::size_t position = 0;
+	auto lookahead = [&] {
+		return position < terminals.size() ? terminals[position] : m_grammar.GetEndOfInputIndex();
+	};
+
+	while (!stack.empty())
+	{
+		const std::uint32_t symbol = stack.back();
+		stack.pop_back();
+		if (symbol < terminalCount)
+		{
+			if (position == terminals.size() || terminals[position] != symbol)
+			{
+				return std::nullopt;
+			}
+			++position;
+			continue;
+		}
+
+		if (lookahead() >= terminalCount)
+		{
+			return std::nullopt;
+		}
+		const std::uint32_t rule = GetRule(symbol - terminalCount, lookahead());
+		if (rule == NO_RULE)
+		{
+			return std::nullopt;
+		}
+		rules.push_back(rule);
+		const auto right = m_grammar.GetRuleRight(rule);
+		stack.insert(stack.end(), right.rbegin(), right.rend());
+	}
+	return position == terminals.size() ? std::optional(std::move(rules)) : std::nullopt;
+}
+
+namespace
+{
+std::uint32_t EncodeAction(LrTable::Action action)
+{
+	return action.value << 2 | static_cast<std::uint32_t>(action.type);
+}
+
+LrTable::Action DecodeAction(std::uint32_t cell)
+{
+	return {static_cast<LrTable::ActionType>(cell & 3), cell >> 2};
+}
+
+bool IsShiftLike(LrTable::Action action)
+{
+	return action.type == LrTable::ActionType::SHIFT || action.type == LrTable::ActionType::ACCEPT;
+}
+
+bool IsPreferred(LrTable::Action action, LrTable::Action other)
+{
+	if (IsShiftLike(action) != IsShiftLike(other))
+	{
+		return IsShiftLike(action);
+	}
+	return action.value < other.value;
+}
+} // namespace
+
+LrTable::LrTable(TableGrammar grammar, std::size_t stateCount)
+	: m_grammar(std::move(grammar))
+	, m_stateCount(stateCount)
+	, m_actions(stateCount * m_grammar.GetTerminalCount(), EncodeAction({}))
+	, m_actionRows(stateCount)
+	, m_gotos(stateCount * m_grammar.GetNonTerminalCount(), NO_STATE)
+	, m_gotoRows(stateCount)
+{
+	if (stateCount >= NO_STATE >> 2)
+	{
+		throw std::length_error("Too many LR states");
+	}
+	std::iota(m_actionRows.begin(), m_actionRows.end(), 0);
+	std::iota(m_gotoRows.begin(), m_gotoRows.end(), 0);
+}
+
+void LrTable::SetAction(std::size_t state, std::size_t lookahead, Action action)
+{
+	AssertIsMutable();
+	AssertIndexInRange(state, m_stateCount, "State");
+	AssertIndexInRange(lookahead, m_grammar.GetTerminalCount(), "Terminal");
+
+	Cell& cell = m_actions[state * m_grammar.GetTerminalCount() + lookahead];
+	const Action current = DecodeAction(cell);
+	if (current.type == ActionType::ERROR)
+	{
+		cell = EncodeAction(action);
+		return;
+	}
+	if (current == action)
+	{
+		return;
+	}
+	const bool replace = IsPreferred(action, current);
+	m_conflicts.push_back({state, lookahead, replace ? action : current, replace ? current : action});
+	if (replace)
+	{
+		cell = EncodeAction(action);
+	}
+}
+
+void LrTable::SetGoto(std::size_t state, std::size_t nonTerminal, std::size_t target)
+{
+	AssertIsMutable();
+	AssertIndexInRange(state, m_stateCount, "State");
+	AssertIndexInRange(nonTerminal, m_grammar.GetNonTerminalCount(), "Non-terminal");
+	AssertIndexInRange(target, m_stateCount, "State");
+	m_gotos[state * m_grammar.GetNonTerminalCount() + nonTerminal] = static_cast<std::uint32_t>(target);
+}
+
+void LrTable::Compact()
+{
+	AssertIsMutable();
+	CompactRows(m_actions, m_grammar.GetTerminalCount(), m_actionRows);
+	CompactRows(m_gotos, m_grammar.GetNonTerminalCount(), m_gotoRows);
+	m_compacted = true;
+}
+
+std::size_t LrTable::GetStateCount() const
+{
+	return m_stateCount;
+}
+
+LrTable::Action LrTable::GetAction(std::size_t state, std::size_t lookahead) const
+{
+	AssertIndexInRange(state, m_stateCount, "State");
+	AssertIndexInRange(lookahead, m_grammar.GetTerminalCount(), "Terminal");
+	return DecodeAction(m_actions[m_actionRows[state] * m_grammar.GetTerminalCount() + lookahead]);
+}
+
+std::uint32_t LrTable::GetGoto(std::size_t state, std::size_t nonTerminal) const
+{
+	AssertIndexInRange(state, m_stateCount, "State");
+	AssertIndexInRange(nonTerminal, m_grammar.GetNonTerminalCount(), "Non-terminal");
+	return m_gotos[m_gotoRows[state] * m_grammar.GetNonTerminalCount() + nonTerminal];
+}
+
+std::size_t LrTable::GetActionRowCount() const
+{
+	return m_compacted ? m_actions.size() / m_grammar.GetTerminalCount() : m_stateCount;
+}
+
+std::size_t LrTable::GetGotoRowCount() const
+{
+	return m_compacted ? m_gotos.size() / m_grammar.GetNonTerminalCount() : m_stateCount;
+}
+
+const TableGrammar& LrTable::GetGrammar() const
+{
+	return m_grammar;
+}
+
+const std::vector<LrTable::Conflict>& LrTable::GetConflicts() const
+{
+	return m_conflicts;
+}
+
+std::vector<std::string> LrTable::DescribeConflicts() const
+{
+	std::vector<std::string> descriptions;
+	for (const auto& conflict : m_conflicts)
+	{
+		descriptions.push_back("State " + std::to_string(conflict.state) + ", lookahead '"
+			+ m_grammar.GetTerminalName(conflict.lookahead) + "': " + ActionToString(conflict.chosen) + " over "
+			+ ActionToString(conflict.rejected));
+	}
+	return descriptions;
+}
+
+std::optional<std::vector<std::size_t>> LrTable::Parse(std::span<const std::string_view> tokens) const
+{
+	return ParseTerminals(m_grammar.ToTerminalIndices(tokens));
+}
+
+std::optional<std::vector<std::size_t>> LrTable::Parse(std::string_view word) const
+{
+	return ParseTerminals(m_grammar.ToTerminalIndices(word));
+}
+
+std::optional<std::vector<std::size_t>> LrTable::ParseTerminals(std::span<const std::size_t> terminals) const
+{
+	std::vector<std::uint32_t> stack = {0};
+	std::vector<std::size_t> reductions;
+	std::size_t position = 0;
+	for (;;)
+	{
+		const std::size_t lookahead = position < terminals.size() ? terminals[position] : m_grammar.GetEndOfInputIndex();
+		if (lookahead >= m_grammar.GetTerminalCount())
+		{
+			return std::nullopt;
+		}
+
+		const Action action = GetAction(stack.back(), lookahead);
+		switch (action.type)
+		{
+		case ActionType::SHIFT:
+			stack.push_back(action.value);
+			++position;
+			break;
+		case ActionType::REDUCE: {
+			stack.resize(stack.size() - m_grammar.GetRuleRight(action.value).size());
+			const std::uint32_t target = GetGoto(stack.back(), m_grammar.GetRuleLeft(action.value));
+			if (target == NO_STATE)
+			{
+				return std::nullopt;
+			}
+			stack.push_back(target);
+			reductions.push_back(action.value);
+			break;
+		}
+		case ActionType::ACCEPT:
+			return reductions;
+		case ActionType::ERROR:
+			return std::nullopt;
+		}
+	}
+}
+
+std::string LrTable::ActionToString(Action action) const
+{
+	switch (action.type)
+	{
+	case ActionType::SHIFT:
+		return "shift " + std::to_string(action.value);
+	case ActionType::REDUCE:
+		return "reduce " + m_grammar.RuleToString(action.value);
+	case ActionType::ACCEPT:
+		return "accept";
+	case ActionType::ERROR:
+		break;
+	}
+	return "error";
+}
+
+void LrTable::AssertIsMutable() const
+{
+	if (m_compacted)
+	{
+		throw std::logic_error("LR table is already compacted");
+	}
+}
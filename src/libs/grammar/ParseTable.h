@@ -0,0 +1,157 @@
+#pragma once
+
+#include "GrammarAnalysis.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Снимок грамматики, которого достаточно таблице: имена символов для входа и отчетов,
+// плотные номера терминалов и нетерминалов, правила одним массивом
+class TableGrammar
+{
+public:
+	TableGrammar(const Grammar& grammar, const GrammarAnalysis& analysis);
+
+	std::size_t GetTerminalCount() const;
+	std::size_t GetNonTerminalCount() const;
+	std::size_t GetEndOfInputIndex() const;
+	// Неизвестный токен получает номер GetTerminalCount(): такого столбца в таблице нет
+	std::vector<std::size_t> ToTerminalIndices(std::span<const std::string_view> tokens) const;
+	// Каждый байт - отдельный терминал
+	std::vector<std::size_t> ToTerminalIndices(std::string_view word) const;
+
+	std::size_t GetStartIndex() const;
+	std::size_t GetRuleCount() const;
+	std::size_t GetRuleLeft(std::size_t rule) const;
+	// Символы правой части: терминал - его номер, нетерминал - номер + GetTerminalCount()
+	std::span<const std::uint32_t> GetRuleRight(std::size_t rule) const;
+
+	std::string GetTerminalName(std::size_t terminal) const;
+	std::string RuleToString(std::size_t rule) const;
+
+private:
+	std::string GetSymbolName(std::uint32_t symbol) const;
+
+	SymbolTable m_symbols;
+	std::vector<std::size_t> m_terminalIndices;
+	std::vector<SymbolId> m_terminals;
+	std::vector<SymbolId> m_nonTerminals;
+	std::size_t m_start;
+	std::vector<std::size_t> m_ruleLeft;
+	std::vector<std::uint32_t> m_ruleSymbols;
+	std::vector<std::size_t> m_ruleOffsets = {0};
+};
+
+// Таблица LL(1): правило по нетерминалу и следующему терминалу
+class LlTable
+{
+public:
+	static constexpr std::uint32_t NO_RULE = std::numeric_limits<std::uint32_t>::max();
+
+	struct Conflict
+	{
+		std::size_t nonTerminal;
+		std::size_t lookahead;
+		std::size_t chosenRule;
+		std::size_t rejectedRule;
+	};
+
+	explicit LlTable(TableGrammar grammar);
+
+	// При конфликте остается правило с меньшим номером, конфликт запоминается
+	void SetRule(std::size_t nonTerminal, std::size_t lookahead, std::size_t rule);
+	std::uint32_t GetRule(std::size_t nonTerminal, std::size_t lookahead) const;
+
+	const TableGrammar& GetGrammar() const;
+	const std::vector<Conflict>& GetConflicts() const;
+	std::vector<std::string> DescribeConflicts() const;
+
+	// Левый вывод - правила в порядке применения, std::nullopt - слово не выводится.
+	// Таблица с конфликтами не задает детерминированный разбор, поэтому разбор по ней - ошибка
+	std::optional<std::vector<std::size_t>> Parse(std::span<const std::string_view> tokens) const;
+	std::optional<std::vector<std::size_t>> Parse(std::string_view word) const;
+
+private:
+	std::optional<std::vector<std::size_t>> ParseTerminals(std::span<const std::size_t> terminals) const;
+
+	TableGrammar m_grammar;
+	std::vector<std::uint32_t> m_rules;
+	std::vector<Conflict> m_conflicts;
+};
+
+// Таблица LR: ACTION по состоянию и терминалу, GOTO по состоянию и нетерминалу.
+// После Compact одинаковые строки хранятся один раз: у LALR-таблиц большинство строк ACTION повторяются
+class LrTable
+{
+public:
+	static constexpr std::uint32_t NO_STATE = std::numeric_limits<std::uint32_t>::max();
+
+	enum class ActionType : std::uint8_t
+	{
+		ERROR,
+		SHIFT,
+		REDUCE,
+		ACCEPT
+	};
+
+	// value - состояние для SHIFT, правило для REDUCE
+	struct Action
+	{
+		ActionType type = ActionType::ERROR;
+		std::uint32_t value = 0;
+
+		bool operator==(const Action& other) const = default;
+	};
+
+	struct Conflict
+	{
+		std::size_t state;
+		std::size_t lookahead;
+		Action chosen;
+		Action rejected;
+	};
+
+	LrTable(TableGrammar grammar, std::size_t stateCount);
+
+	// Конфликты разрешаются как в yacc: сдвиг важнее свертки, из сверток - правило с меньшим номером
+	void SetAction(std::size_t state, std::size_t lookahead, Action action);
+	void SetGoto(std::size_t state, std::size_t nonTerminal, std::size_t target);
+	// Склеивает одинаковые строки, после этого таблица только читается
+	void Compact();
+
+	std::size_t GetStateCount() const;
+	Action GetAction(std::size_t state, std::size_t lookahead) const;
+	std::uint32_t GetGoto(std::size_t state, std::size_t nonTerminal) const;
+	std::size_t GetActionRowCount() const;
+	std::size_t GetGotoRowCount() const;
+
+	const TableGrammar& GetGrammar() const;
+	const std::vector<Conflict>& GetConflicts() const;
+	std::vector<std::string> DescribeConflicts() const;
+
+	// Свертки в порядке выполнения (обращенный правый вывод), std::nullopt - слово не выводится
+	std::optional<std::vector<std::size_t>> Parse(std::span<const std::string_view> tokens) const;
+	std::optional<std::vector<std::size_t>> Parse(std::string_view word) const;
+
+private:
+	using Cell = std::uint32_t;
+
+	std::optional<std::vector<std::size_t>> ParseTerminals(std::span<const std::size_t> terminals) const;
+	std::string ActionToString(Action action) const;
+	void AssertIsMutable() const;
+
+	TableGrammar m_grammar;
+	std::size_t m_stateCount;
+	// Строка ACTION состояния s - m_actions[m_actionRows[s] * GetTerminalCount()..)
+	std::vector<Cell> m_actions;
+	std::vector<std::uint32_t> m_actionRows;
+	std::vector<std::uint32_t> m_gotos;
+	std::vector<std::uint32_t> m_gotoRows;
+	std::vector<Conflict> m_conflicts;
+	bool m_compacted = false;
+};
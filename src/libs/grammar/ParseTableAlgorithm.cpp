@@ -0,0 +1,592 @@
+#include "ParseTableAlgorithm.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+constexpr std::uint32_t NO_NEXT = std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t NOT_VISITED = 0;
+constexpr std::size_t DONE = std::numeric_limits<std::size_t>::max();
+
+// Правила с точкой в кодировке TableGrammar: символ < terminalCount - терминал, иначе нетерминал.
+// Последнее правило - служебное S' -> S, его левая часть - нетерминал с номером GetNonTerminalCount()
+struct DottedRules
+{
+	std::size_t terminalCount;
+	std::size_t augmentedRule;
+	std::vector<std::uint32_t> ruleStates;
+	std::vector<std::uint32_t> ruleLeft;
+	std::vector<std::uint32_t> stateNext;
+	std::vector<std::uint32_t> stateRule;
+	std::vector<std::vector<std::uint32_t>> rulesByLeft;
+	std::vector<char> nullable;
+	// FIRST и обнуляемость части правила после символа за точкой - источник предпросмотра предсказанных правил
+	std::vector<TerminalSet> firstAfterNext;
+	std::vector<char> nullableAfterNext;
+
+	DottedRules(const TableGrammar& grammar, const GrammarAnalysis& analysis)
+		: terminalCount(grammar.GetTerminalCount())
+		, augmentedRule(grammar.GetRuleCount())
+		, rulesByLeft(grammar.GetNonTerminalCount() + 1)
+		, nullable(grammar.GetNonTerminalCount())
+	{
+		for (std::size_t nonTerminal = 0; nonTerminal < grammar.GetNonTerminalCount(); ++nonTerminal)
+		{
+			nullable[nonTerminal] = analysis.IsNullable(analysis.GetNonTerminal(nonTerminal));
+		}
+
+		auto addRule = [&](std::size_t left, std::span<const std::uint32_t> right) {
+			const auto rule = static_cast<std::uint32_t>(ruleLeft.size());
+			ruleLeft.push_back(static_cast<std::uint32_t>(left));
+			rulesByLeft[left].push_back(rule);
+			ruleStates.push_back(static_cast<std::uint32_t>(stateNext.size()));
+			stateNext.insert(stateNext.end(), right.begin(), right.end());
+			stateNext.push_back(NO_NEXT);
+			stateRule.insert(stateRule.end(), right.size() + 1, rule);
+		};
+		for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+		{
+			addRule(grammar.GetRuleLeft(rule), grammar.GetRuleRight(rule));
+		}
+		const auto start = static_cast<std::uint32_t>(terminalCount + grammar.GetStartIndex());
+		addRule(grammar.GetNonTerminalCount(), std::span(&start, 1));
+		ruleStates.push_back(static_cast<std::uint32_t>(stateNext.size()));
+
+		firstAfterNext.assign(stateNext.size(), TerminalSet(terminalCount));
+		nullableAfterNext.assign(stateNext.size(), true);
+		for (std::size_t rule = 0; rule < ruleLeft.size(); ++rule)
+		{
+			// Справа налево: после последнего символа - пустая цепочка
+			for (std::uint32_t state = ruleStates[rule + 1] - 1; state > ruleStates[rule]; --state)
+			{
+				const std::uint32_t after = stateNext[state];
+				if (after == NO_NEXT)
+				{
+					continue;
+				}
+				const std::uint32_t before = state - 1;
+				firstAfterNext[before] = firstAfterNext[state];
+				nullableAfterNext[before] = nullableAfterNext[state];
+				if (after < terminalCount)
+				{
+					firstAfterNext[before] = TerminalSet(terminalCount);
+					firstAfterNext[before].Insert(after);
+					nullableAfterNext[before] = false;
+				}
+				else
+				{
+					const SymbolId symbol = analysis.GetNonTerminal(after - terminalCount);
+					if (!nullable[after - terminalCount])
+					{
+						firstAfterNext[before] = TerminalSet(terminalCount);
+						nullableAfterNext[before] = false;
+					}
+					firstAfterNext[before].UnionWith(analysis.GetFirst(symbol));
+				}
+			}
+		}
+	}
+
+	bool IsNonTerminal(std::uint32_t symbol) const
+	{
+		return symbol != NO_NEXT && symbol >= terminalCount;
+	}
+
+	std::uint32_t GetCompletedState(std::size_t rule) const
+	{
+		return ruleStates[rule + 1] - 1;
+	}
+};
+
+struct Transition
+{
+	std::uint32_t symbol;
+	std::uint32_t target;
+};
+
+struct KernelHash
+{
+	std::size_t operator()(const std::vector<std::uint32_t>& kernel) const
+	{
+		std::size_t hash = kernel.size();
+		for (const auto state : kernel)
+		{
+			hash = (hash ^ state) * 0x9E3779B97F4A7C15ull;
+		}
+		return hash;
+	}
+};
+
+// Автомат LR(0): ядра состояний и переходы, отсортированные по символу
+struct Lr0Automaton
+{
+	std::vector<std::vector<std::uint32_t>> kernels;
+	std::vector<std::vector<Transition>> transitions;
+
+	std::uint32_t GetTarget(std::size_t state, std::uint32_t symbol) const
+	{
+		const auto& list = transitions[state];
+		const auto it = std::lower_bound(list.begin(), list.end(), symbol,
+			[](const Transition& transition, std::uint32_t value) { return transition.symbol < value; });
+		return it != list.end() && it->symbol == symbol ? it->target : LrTable::NO_STATE;
+	}
+};
+
+// Замыкание ядра: предсказанные правила добавляются по нетерминалу один раз
+std::vector<std::uint32_t> Closure(const DottedRules& rules, std::span<const std::uint32_t> kernel,
+	std::vector<std::size_t>& predicted, std::size_t stamp)
+{
+	std::vector<std::uint32_t> items(kernel.begin(), kernel.end());
+	for (std::size_t i = 0; i < items.size(); ++i)
+	{
+		const std::uint32_t next = rules.stateNext[items[i]];
+		if (!rules.IsNonTerminal(next) || predicted[next - rules.terminalCount] == stamp)
+		{
+			continue;
+		}
+		predicted[next - rules.terminalCount] = stamp;
+		for (const auto rule : rules.rulesByLeft[next - rules.terminalCount])
+		{
+			items.push_back(rules.ruleStates[rule]);
+		}
+	}
+	return items;
+}
+
+Lr0Automaton BuildLr0Automaton(const DottedRules& rules)
+{
+	Lr0Automaton automaton;
+	std::unordered_map<std::vector<std::uint32_t>, std::uint32_t, KernelHash> ids;
+	std::vector<std::size_t> predicted(rules.rulesByLeft.size(), NOT_VISITED);
+	std::vector<std::vector<std::uint32_t>> buckets(rules.terminalCount + rules.rulesByLeft.size());
+	std::vector<std::uint32_t> touched;
+
+	automaton.kernels.push_back({rules.ruleStates[rules.augmentedRule]});
+	ids.emplace(automaton.kernels[0], 0);
+	for (std::size_t state = 0; state < automaton.kernels.size(); ++state)
+	{
+		for (const auto item : Closure(rules, automaton.kernels[state], predicted, state + 1))
+		{
+			const std::uint32_t next = rules.stateNext[item];
+			if (next == NO_NEXT)
+			{
+				continue;
+			}
+			if (buckets[next].empty())
+			{
+				touched.push_back(next);
+			}
+			buckets[next].push_back(item + 1);
+		}
+
+		std::sort(touched.begin(), touched.end());
+		std::vector<Transition> transitions;
+		for (const auto symbol : touched)
+		{
+			auto& kernel = buckets[symbol];
+			std::sort(kernel.begin(), kernel.end());
+			const auto [it, inserted] = ids.try_emplace(kernel, static_cast<std::uint32_t>(automaton.kernels.size()));
+			if (inserted)
+			{
+				automaton.kernels.push_back(kernel);
+			}
+			transitions.push_back({symbol, it->second});
+			kernel.clear();
+		}
+		touched.clear();
+		automaton.transitions.push_back(std::move(transitions));
+	}
+	return automaton;
+}
+
+// Digraph (DeRemer-Pennello): sets[x] - объединение начальных множеств всех y, достижимых из x по relation.
+// Вершины одной сильно связной компоненты получают одно множество. Обход без рекурсии
+void Digraph(const std::vector<std::vector<std::uint32_t>>& relation, std::vector<TerminalSet>& sets)
+{
+	struct Frame
+	{
+		std::uint32_t node;
+		std::size_t edge;
+		std::size_t depth;
+	};
+
+	std::vector<std::size_t> depths(sets.size(), NOT_VISITED);
+	std::vector<std::uint32_t> stack;
+	std::vector<Frame> frames;
+	auto visit = [&](std::uint32_t node) {
+		stack.push_back(node);
+		depths[node] = stack.size();
+		frames.push_back({node, 0, stack.size()});
+	};
+
+	for (std::uint32_t root = 0; root < sets.size(); ++root)
+	{
+		if (depths[root] != NOT_VISITED)
+		{
+			continue;
+		}
+		visit(root);
+		while (!frames.empty())
+		{
+			Frame& frame = frames.back();
+			const std::uint32_t node = frame.node;
+			if (frame.edge < relation[node].size())
+			{
+				const std::uint32_t next = relation[node][frame.edge++];
+				if (depths[next] == NOT_VISITED)
+				{
+					visit(next);
+					continue;
+				}
+				depths[node] = std::min(depths[node], depths[next]);
+				sets[node].UnionWith(sets[next]);
+				continue;
+			}
+
+			const std::size_t depth = frame.depth;
+			frames.pop_back();
+			if (depths[node] == depth)
+			{
+				for (;;)
+				{
+					const std::uint32_t member = stack.back();
+					stack.pop_back();
+					depths[member] = DONE;
+					if (member == node)
+					{
+						break;
+					}
+					sets[member] = sets[node];
+				}
+			}
+			if (!frames.empty())
+			{
+				const std::uint32_t parent = frames.back().node;
+				depths[parent] = std::min(depths[parent], depths[node]);
+				sets[parent].UnionWith(sets[node]);
+			}
+		}
+	}
+}
+
+void SetShiftsAndGotos(LrTable& table, const DottedRules& rules, std::size_t state, std::span<const Transition> transitions)
+{
+	for (const auto& transition : transitions)
+	{
+		if (transition.symbol < rules.terminalCount)
+		{
+			table.SetAction(state, transition.symbol, {LrTable::ActionType::SHIFT, transition.target});
+		}
+		else
+		{
+			table.SetGoto(state, transition.symbol - rules.terminalCount, transition.target);
+		}
+	}
+}
+} // namespace
+
+LlTable ParseTableAlgorithm::BuildLl1(const Grammar& grammar)
+{
+	const GrammarAnalysis analysis(grammar);
+	LlTable table(TableGrammar(grammar, analysis));
+
+	for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+	{
+		const SymbolId left = grammar.GetRuleLeft(rule)[0];
+		const std::size_t nonTerminal = analysis.GetNonTerminalIndex(left);
+		TerminalSet lookaheads(analysis.GetTerminalCount());
+		if (analysis.AddFirst(grammar.GetRuleRight(rule), lookaheads))
+		{
+			lookaheads.UnionWith(analysis.GetFollow(left));
+		}
+		for (const auto terminal : lookaheads.ToIndices())
+		{
+			table.SetRule(nonTerminal, terminal, rule);
+		}
+	}
+	return table;
+}
+
+// Переходы по нетерминалам (p, A) - вершины relations. DR - терминалы, сдвигаемые сразу после перехода,
+// reads - переходы по обнуляемым нетерминалам из goto(p, A), includes - (p, A) для B -> β A γ с обнуляемой γ
+// и перехода (p', B), из которого β ведет в p. Предпросмотр свертки правила в q - FOLLOW переходов из lookback
+LrTable ParseTableAlgorithm::BuildLalr1(const Grammar& grammar)
+{
+	const GrammarAnalysis analysis(grammar);
+	TableGrammar tableGrammar(grammar, analysis);
+	const DottedRules rules(tableGrammar, analysis);
+	const Lr0Automaton automaton = BuildLr0Automaton(rules);
+	const std::size_t endOfInput = tableGrammar.GetEndOfInputIndex();
+	const std::uint32_t accepting = rules.GetCompletedState(rules.augmentedRule);
+
+	// Номер перехода по нетерминалу: переходы состояния p занимают [firstTransition[p], ...) в порядке transitions[p]
+	struct NonTerminalTransition
+	{
+		std::uint32_t from;
+		std::uint32_t nonTerminal;
+		std::uint32_t target;
+	};
+	std::vector<NonTerminalTransition> gotos;
+	std::vector<std::size_t> firstGoto(automaton.kernels.size() + 1, 0);
+	for (std::uint32_t state = 0; state < automaton.kernels.size(); ++state)
+	{
+		firstGoto[state] = gotos.size();
+		for (const auto& transition : automaton.transitions[state])
+		{
+			if (transition.symbol >= rules.terminalCount)
+			{
+				gotos.push_back({state, transition.symbol - static_cast<std::uint32_t>(rules.terminalCount), transition.target});
+			}
+		}
+	}
+	firstGoto.back() = gotos.size();
+	auto findGoto = [&](std::uint32_t state, std::uint32_t nonTerminal) {
+		const auto first = gotos.begin() + static_cast<std::ptrdiff_t>(firstGoto[state]);
+		const auto last = gotos.begin() + static_cast<std::ptrdiff_t>(firstGoto[state + 1]);
+		const auto it = std::lower_bound(first, last, nonTerminal,
+			[](const NonTerminalTransition& transition, std::uint32_t value) { return transition.nonTerminal < value; });
+		return static_cast<std::uint32_t>(it - gotos.begin());
+	};
+
+	std::vector<TerminalSet> follow(gotos.size(), TerminalSet(rules.terminalCount));
+	std::vector<std::vector<std::uint32_t>> reads(gotos.size());
+	for (std::uint32_t x = 0; x < gotos.size(); ++x)
+	{
+		const std::uint32_t target = gotos[x].target;
+		for (const auto& transition : automaton.transitions[target])
+		{
+			if (transition.symbol < rules.terminalCount)
+			{
+				follow[x].Insert(transition.symbol);
+			}
+		}
+		const auto& kernel = automaton.kernels[target];
+		if (std::binary_search(kernel.begin(), kernel.end(), accepting))
+		{
+			follow[x].Insert(endOfInput);
+		}
+		for (std::size_t y = firstGoto[target]; y < firstGoto[target + 1]; ++y)
+		{
+			if (rules.nullable[gotos[y].nonTerminal])
+			{
+				reads[x].push_back(static_cast<std::uint32_t>(y));
+			}
+		}
+	}
+	Digraph(reads, follow);
+
+	struct Lookback
+	{
+		std::uint32_t state;
+		std::uint32_t rule;
+		std::uint32_t transition;
+	};
+	std::vector<Lookback> lookbacks;
+	std::vector<std::vector<std::uint32_t>> includes(gotos.size());
+	for (std::uint32_t x = 0; x < gotos.size(); ++x)
+	{
+		for (const auto rule : rules.rulesByLeft[gotos[x].nonTerminal])
+		{
+			std::uint32_t state = gotos[x].from;
+			for (std::uint32_t item = rules.ruleStates[rule]; item != rules.GetCompletedState(rule); ++item)
+			{
+				const std::uint32_t symbol = rules.stateNext[item];
+				if (rules.IsNonTerminal(symbol) && rules.nullableAfterNext[item])
+				{
+					includes[findGoto(state, symbol - static_cast<std::uint32_t>(rules.terminalCount))].push_back(x);
+				}
+				state = automaton.GetTarget(state, symbol);
+			}
+			lookbacks.push_back({state, rule, x});
+		}
+	}
+	Digraph(includes, follow);
+
+	LrTable table(std::move(tableGrammar), automaton.kernels.size());
+	for (std::size_t state = 0; state < automaton.kernels.size(); ++state)
+	{
+		SetShiftsAndGotos(table, rules, state, automaton.transitions[state]);
+		const auto& kernel = automaton.kernels[state];
+		if (std::binary_search(kernel.begin(), kernel.end(), accepting))
+		{
+			table.SetAction(state, endOfInput, {LrTable::ActionType::ACCEPT, 0});
+		}
+	}
+	// Одна свертка в состоянии обычно видна через много переходов: предпросмотр сначала объединяется по словам
+	std::sort(lookbacks.begin(), lookbacks.end(), [](const Lookback& left, const Lookback& right) {
+		return std::tie(left.state, left.rule) < std::tie(right.state, right.rule);
+	});
+	for (std::size_t first = 0; first < lookbacks.size();)
+	{
+		const Lookback& reduction = lookbacks[first];
+		TerminalSet lookaheads(rules.terminalCount);
+		std::size_t last = first;
+		for (; last < lookbacks.size() && lookbacks[last].state == reduction.state && lookbacks[last].rule == reduction.rule;
+			 ++last)
+		{
+			lookaheads.UnionWith(follow[lookbacks[last].transition]);
+		}
+		for (const auto terminal : lookaheads.ToIndices())
+		{
+			table.SetAction(reduction.state, terminal, {LrTable::ActionType::REDUCE, reduction.rule});
+		}
+		first = last;
+	}
+	table.Compact();
+	return table;
+}
+
+// Пункт LR(1) - правило с точкой и множество предпросмотра; ядро упорядочено по правилу с точкой
+LrTable ParseTableAlgorithm::BuildCanonicalLr1(const Grammar& grammar)
+{
+	const GrammarAnalysis analysis(grammar);
+	TableGrammar tableGrammar(grammar, analysis);
+	const DottedRules rules(tableGrammar, analysis);
+	const std::size_t endOfInput = tableGrammar.GetEndOfInputIndex();
+	const std::size_t nonTerminalCount = rules.rulesByLeft.size();
+
+	using Kernel = std::vector<std::pair<std::uint32_t, TerminalSet>>;
+	struct Lr1KernelHash
+	{
+		std::size_t operator()(const Kernel& kernel) const
+		{
+			std::size_t hash = kernel.size();
+			for (const auto& [state, lookaheads] : kernel)
+			{
+				hash = (hash ^ state ^ lookaheads.Hash()) * 0x9E3779B97F4A7C15ull;
+			}
+			return hash;
+		}
+	};
+
+	std::vector<Kernel> kernels;
+	std::vector<std::vector<Transition>> transitions;
+	// Завершенные пункты состояния: правило и его предпросмотр
+	std::vector<std::vector<std::pair<std::uint32_t, TerminalSet>>> reductions;
+	std::unordered_map<Kernel, std::uint32_t, Lr1KernelHash> ids;
+	Kernel initial = {{rules.ruleStates[rules.augmentedRule], TerminalSet(rules.terminalCount)}};
+	initial[0].second.Insert(endOfInput);
+	ids.emplace(initial, 0);
+	kernels.push_back(std::move(initial));
+
+	// Предпросмотр предсказанных правил по нетерминалу, пересчет рабочим списком
+	std::vector<TerminalSet> predicted(nonTerminalCount, TerminalSet(rules.terminalCount));
+	std::vector<std::size_t> stamps(nonTerminalCount, NOT_VISITED);
+	std::vector<std::uint32_t> touched;
+	std::vector<std::uint32_t> worklist;
+	std::vector<char> queued(nonTerminalCount, false);
+	std::vector<Kernel> buckets(rules.terminalCount + nonTerminalCount);
+	std::vector<std::uint32_t> touchedSymbols;
+
+	for (std::size_t state = 0; state < kernels.size(); ++state)
+	{
+		auto contribute = [&](std::uint32_t item, const TerminalSet& lookaheads) {
+			const std::uint32_t next = rules.stateNext[item];
+			if (!rules.IsNonTerminal(next))
+			{
+				return;
+			}
+			const std::uint32_t nonTerminal = next - static_cast<std::uint32_t>(rules.terminalCount);
+			bool changed = stamps[nonTerminal] != state + 1;
+			if (changed)
+			{
+				stamps[nonTerminal] = state + 1;
+				predicted[nonTerminal] = TerminalSet(rules.terminalCount);
+				touched.push_back(nonTerminal);
+			}
+			changed = predicted[nonTerminal].UnionWith(rules.firstAfterNext[item]) || changed;
+			if (rules.nullableAfterNext[item])
+			{
+				changed = predicted[nonTerminal].UnionWith(lookaheads) || changed;
+			}
+			if (changed && !queued[nonTerminal])
+			{
+				queued[nonTerminal] = true;
+				worklist.push_back(nonTerminal);
+			}
+		};
+
+		for (const auto& [item, lookaheads] : kernels[state])
+		{
+			contribute(item, lookaheads);
+		}
+		while (!worklist.empty())
+		{
+			const std::uint32_t nonTerminal = worklist.back();
+			worklist.pop_back();
+			queued[nonTerminal] = false;
+			const TerminalSet lookaheads = predicted[nonTerminal];
+			for (const auto rule : rules.rulesByLeft[nonTerminal])
+			{
+				contribute(rules.ruleStates[rule], lookaheads);
+			}
+		}
+
+		reductions.emplace_back();
+		auto addItem = [&](std::uint32_t item, const TerminalSet& lookaheads) {
+			const std::uint32_t next = rules.stateNext[item];
+			if (next == NO_NEXT)
+			{
+				reductions.back().emplace_back(rules.stateRule[item], lookaheads);
+				return;
+			}
+			if (buckets[next].empty())
+			{
+				touchedSymbols.push_back(next);
+			}
+			buckets[next].emplace_back(item + 1, lookaheads);
+		};
+		for (const auto& [item, lookaheads] : kernels[state])
+		{
+			addItem(item, lookaheads);
+		}
+		for (const auto nonTerminal : touched)
+		{
+			for (const auto rule : rules.rulesByLeft[nonTerminal])
+			{
+				addItem(rules.ruleStates[rule], predicted[nonTerminal]);
+			}
+		}
+		touched.clear();
+
+		std::sort(touchedSymbols.begin(), touchedSymbols.end());
+		std::vector<Transition> stateTransitions;
+		for (const auto symbol : touchedSymbols)
+		{
+			auto& kernel = buckets[symbol];
+			std::sort(kernel.begin(), kernel.end(), [](const auto& left, const auto& right) {
+				return left.first < right.first;
+			});
+			const auto [it, inserted] = ids.try_emplace(kernel, static_cast<std::uint32_t>(kernels.size()));
+			if (inserted)
+			{
+				kernels.push_back(kernel);
+			}
+			stateTransitions.push_back({symbol, it->second});
+			kernel.clear();
+		}
+		touchedSymbols.clear();
+		transitions.push_back(std::move(stateTransitions));
+	}
+
+	LrTable table(std::move(tableGrammar), kernels.size());
+	for (std::size_t state = 0; state < kernels.size(); ++state)
+	{
+		SetShiftsAndGotos(table, rules, state, transitions[state]);
+		for (const auto& [rule, lookaheads] : reductions[state])
+		{
+			const LrTable::Action action = rule == rules.augmentedRule
+				? LrTable::Action{LrTable::ActionType::ACCEPT, 0}
+				: LrTable::Action{LrTable::ActionType::REDUCE, rule};
+			for (const auto terminal : lookaheads.ToIndices())
+			{
+				table.SetAction(state, terminal, action);
+			}
+		}
+	}
+	table.Compact();
+	return table;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ParseTable.h"
+
+// Построение таблиц синтаксического анализа по контекстно-свободной грамматике.
+// Конфликты не прерывают построение: они разрешаются по правилам таблицы и перечисляются в GetConflicts
+class ParseTableAlgorithm
+{
+public:
+	ParseTableAlgorithm() = default;
+	~ParseTableAlgorithm() = default;
+
+	static LlTable BuildLl1(const Grammar& grammar);
+	// Автомат LR(0) с предпросмотром по DeRemer-Pennello: relations reads и includes замыкаются
+	// обходом сильно связных компонент, каждое множество объединяется один раз
+	static LrTable BuildLalr1(const Grammar& grammar);
+	// Канонический LR(1): состояния различаются и ядром, и предпросмотром, поэтому их может быть намного больше
+	static LrTable BuildCanonicalLr1(const Grammar& grammar);
+};
@@ -0,0 +1,103 @@
+#include "ProductionParser.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr std::string_view ARROW = "->";
+constexpr std::string_view UNICODE_ARROW = "→";
+constexpr std::string_view EPSILON = "ε";
+constexpr std::string_view ASCII_EPSILON = "eps";
+constexpr char ALTERNATIVE_SEPARATOR = '|';
+
+bool IsSpace(char symbol)
+{
+	return symbol == ' ' || symbol == '\t' || symbol == '\r' || symbol == '\n';
+}
+
+void AssertHasArrow(std::size_t position, std::string_view text)
+{
+	if (position == std::string_view::npos)
+	{
+		throw std::invalid_argument("Rule '" + std::string(text) + "' has no '->'");
+	}
+}
+
+void AssertIsLeftSideNotEmpty(const std::vector<std::string_view>& left, std::string_view text)
+{
+	if (left.empty())
+	{
+		throw std::invalid_argument("Rule '" + std::string(text) + "' has an empty left side");
+	}
+}
+
+// Слова через пробельные символы; ε-символ не добавляется
+void SplitSymbols(std::string_view text, std::vector<std::string_view>& symbols)
+{
+	std::size_t position = 0;
+	while (position < text.size())
+	{
+		while (position < text.size() && IsSpace(text[position]))
+		{
+			++position;
+		}
+		const std::size_t begin = position;
+		while (position < text.size() && !IsSpace(text[position]))
+		{
+			++position;
+		}
+
+		const auto symbol = text.substr(begin, position - begin);
+		if (!symbol.empty() && symbol != EPSILON && symbol != ASCII_EPSILON)
+		{
+			symbols.push_back(symbol);
+		}
+	}
+}
+} // namespace
+
+void ProductionParser::Parse(std::string_view text, ParsedProduction& result)
+{
+	std::size_t arrowLength = ARROW.size();
+	std::size_t arrow = text.find(ARROW);
+	if (const std::size_t unicodeArrow = text.find(UNICODE_ARROW); unicodeArrow < arrow)
+	{
+		arrow = unicodeArrow;
+		arrowLength = UNICODE_ARROW.size();
+	}
+	AssertHasArrow(arrow, text);
+
+	result.left.clear();
+	SplitSymbols(text.substr(0, arrow), result.left);
+	AssertIsLeftSideNotEmpty(result.left, text);
+
+	// Внутренние векторы альтернатив не освобождаются, чтобы не выделять память на каждом правиле
+	std::size_t count = 0;
+	std::string_view rest = text.substr(arrow + arrowLength);
+	while (true)
+	{
+		const std::size_t separator = rest.find(ALTERNATIVE_SEPARATOR);
+		if (count == result.alternatives.size())
+		{
+			result.alternatives.emplace_back();
+		}
+		auto& alternative = result.alternatives[count++];
+		alternative.clear();
+		SplitSymbols(rest.substr(0, separator), alternative);
+
+		if (separator == std::string_view::npos)
+		{
+			break;
+		}
+		rest.remove_prefix(separator + 1);
+	}
+	result.alternatives.resize(count);
+}
+
+ParsedProduction ProductionParser::Parse(std::string_view text)
+{
+	ParsedProduction result;
+	Parse(text, result);
+	return result;
+}
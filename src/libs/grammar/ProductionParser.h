@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+// Правило в текстовом виде: "A -> α | β". Символы разделяются пробелами и могут быть многосимвольными,
+// "->" можно заменить на "→". Пустая альтернатива, "ε" и "eps" означают ε-правило.
+// Разбор не копирует текст: результат ссылается на исходную строку
+struct ParsedProduction
+{
+	std::vector<std::string_view> left;
+	// Пустая альтернатива - ε-правило
+	std::vector<std::vector<std::string_view>> alternatives;
+};
+
+class ProductionParser
+{
+public:
+	ProductionParser() = default;
+	~ProductionParser() = default;
+
+	// Векторы результата переиспользуются между вызовами
+	static void Parse(std::string_view text, ParsedProduction& result);
+	static ParsedProduction Parse(std::string_view text);
+};
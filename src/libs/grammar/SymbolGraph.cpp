@@ -0,0 +1,65 @@
+#include "SymbolGraph.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+std::vector<std::size_t> SymbolGraph::FindComponents(std::size_t vertexCount, const std::vector<std::vector<SymbolId>>& edges)
+{
+	constexpr std::size_t UNVISITED = std::numeric_limits<std::size_t>::max();
+	std::vector<std::size_t> component(vertexCount, UNVISITED);
+	std::vector<std::size_t> order(vertexCount, UNVISITED);
+	std::vector<std::size_t> low(vertexCount, 0);
+	std::vector<SymbolId> stack;
+	std::vector<std::pair<SymbolId, std::size_t>> path;
+	std::size_t time = 0;
+	std::size_t componentCount = 0;
+
+	for (SymbolId root = 0; root < vertexCount; ++root)
+	{
+		if (order[root] != UNVISITED)
+		{
+			continue;
+		}
+		path.emplace_back(root, 0);
+		order[root] = low[root] = time++;
+		stack.push_back(root);
+		while (!path.empty())
+		{
+			auto& [vertex, next] = path.back();
+			if (next < edges[vertex].size())
+			{
+				const SymbolId target = edges[vertex][next++];
+				if (order[target] == UNVISITED)
+				{
+					order[target] = low[target] = time++;
+					stack.push_back(target);
+					path.emplace_back(target, 0);
+				}
+				else if (component[target] == UNVISITED)
+				{
+					low[vertex] = std::min(low[vertex], order[target]);
+				}
+				continue;
+			}
+			const SymbolId finished = vertex;
+			path.pop_back();
+			if (!path.empty())
+			{
+				low[path.back().first] = std::min(low[path.back().first], low[finished]);
+			}
+			if (low[finished] == order[finished])
+			{
+				SymbolId member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					component[member] = componentCount;
+				} while (member != finished);
+				++componentCount;
+			}
+		}
+	}
+	return component;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "SymbolTable.h"
+
+#include <cstddef>
+#include <vector>
+
+// Граф на номерах символов грамматики: edges[A] - символы, в которые ведут ребра из A
+class SymbolGraph
+{
+public:
+	// Компоненты сильной связности (Тарьян без рекурсии) за O(V + E): номер компоненты каждой вершины
+	static std::vector<std::size_t> FindComponents(std::size_t vertexCount, const std::vector<std::vector<SymbolId>>& edges);
+};
@@ -0,0 +1,60 @@
+#include "SymbolTable.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+void AssertIsIdValid(SymbolId id, std::size_t size)
+{
+	if (id >= size)
+	{
+		throw std::out_of_range("Unknown symbol id " + std::to_string(id));
+	}
+}
+} // namespace
+
+SymbolId SymbolTable::Intern(std::string_view name)
+{
+	if (const auto it = m_ids.find(name); it != m_ids.end())
+	{
+		return it->second;
+	}
+
+	const auto id = static_cast<SymbolId>(m_names.size());
+	m_names.emplace_back(name);
+	m_ids.emplace(m_names.back(), id);
+	m_maxNameLength = std::max(m_maxNameLength, name.size());
+	return id;
+}
+
+std::optional<SymbolId> SymbolTable::Find(std::string_view name) const
+{
+	const auto it = m_ids.find(name);
+	if (it == m_ids.end())
+	{
+		return std::nullopt;
+	}
+	return it->second;
+}
+
+const std::string& SymbolTable::GetName(SymbolId id) const
+{
+	AssertIsIdValid(id, m_names.size());
+	return m_names[id];
+}
+
+std::size_t SymbolTable::GetSize() const
+{
+	return m_names.size();
+}
+
+std::size_t SymbolTable::GetMaxNameLength() const
+{
+	return m_maxNameLength;
+}
+
+std::size_t SymbolTable::NameHash::operator()(std::string_view name) const
+{
+	return std::hash<std::string_view>{}(name);
+}
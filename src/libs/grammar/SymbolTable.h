@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using SymbolId = std::uint32_t;
+
+constexpr SymbolId NO_SYMBOL = std::numeric_limits<SymbolId>::max();
+
+// Интернирование символов грамматики: каждое имя получает плотный номер 0, 1, ... в порядке появления.
+// Алгоритмы над грамматикой сравнивают номера и индексируют ими массивы вместо поиска строк
+class SymbolTable
+{
+public:
+	SymbolId Intern(std::string_view name);
+	std::optional<SymbolId> Find(std::string_view name) const;
+	const std::string& GetName(SymbolId id) const;
+
+	std::size_t GetSize() const;
+	// Длина самого длинного имени - для разбора правой части правила по наибольшему совпадению
+	std::size_t GetMaxNameLength() const;
+
+private:
+	struct NameHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(std::string_view name) const;
+	};
+
+	std::vector<std::string> m_names;
+	std::unordered_map<std::string, SymbolId, NameHash, std::equal_to<>> m_ids;
+	std::size_t m_maxNameLength = 0;
+};
@@ -0,0 +1,83 @@
+#include "TerminalSet.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr std::size_t WORD_BITS = 64;
+} // namespace
+
+TerminalSet::TerminalSet(std::size_t size)
+	: m_size(size)
+	, m_words((size + WORD_BITS - 1) / WORD_BITS, 0)
+{
+}
+
+bool TerminalSet::Insert(std::size_t index)
+{
+	if (index >= m_size)
+	{
+		throw std::out_of_range("Terminal index " + std::to_string(index) + " is out of range");
+	}
+	const Word bit = Word{1} << (index % WORD_BITS);
+	Word& word = m_words[index / WORD_BITS];
+	const bool inserted = (word & bit) == 0;
+	word |= bit;
+	return inserted;
+}
+
+bool TerminalSet::Contains(std::size_t index) const
+{
+	return index < m_size && (m_words[index / WORD_BITS] >> (index % WORD_BITS) & 1) != 0;
+}
+
+bool TerminalSet::UnionWith(const TerminalSet& other)
+{
+	if (other.m_size != m_size)
+	{
+		throw std::invalid_argument("Terminal sets have different sizes");
+	}
+	Word changed = 0;
+	for (std::size_t i = 0; i < m_words.size(); ++i)
+	{
+		changed |= other.m_words[i] & ~m_words[i];
+		m_words[i] |= other.m_words[i];
+	}
+	return changed != 0;
+}
+
+bool TerminalSet::IsEmpty() const
+{
+	return std::all_of(m_words.begin(), m_words.end(), [](Word word) { return word == 0; });
+}
+
+std::size_t TerminalSet::GetSize() const
+{
+	return m_size;
+}
+
+std::vector<std::size_t> TerminalSet::ToIndices() const
+{
+	std::vector<std::size_t> indices;
+	for (std::size_t i = 0; i < m_words.size(); ++i)
+	{
+		for (Word word = m_words[i]; word != 0; word &= word - 1)
+		{
+			indices.push_back(i * WORD_BITS + static_cast<std::size_t>(std::countr_zero(word)));
+		}
+	}
+	return indices;
+}
+
+std::size_t TerminalSet::Hash() const
+{
+	std::size_t hash = m_size;
+	for (const Word word : m_words)
+	{
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+	}
+	return hash;
+}
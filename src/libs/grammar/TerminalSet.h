@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Множество плотных номеров терминалов в виде битовой строки: объединение - по 64 терминала за операцию
+class TerminalSet
+{
+public:
+	explicit TerminalSet(std::size_t size = 0);
+
+	bool Insert(std::size_t index);
+	bool Contains(std::size_t index) const;
+	// true, если множество изменилось
+	bool UnionWith(const TerminalSet& other);
+
+	bool IsEmpty() const;
+	std::size_t GetSize() const;
+	std::vector<std::size_t> ToIndices() const;
+
+	bool operator==(const TerminalSet& other) const = default;
+
+	std::size_t Hash() const;
+
+private:
+	using Word = std::uint64_t;
+
+	std::size_t m_size;
+	std::vector<Word> m_words;
+};
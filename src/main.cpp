@@ -1,40 +1,22 @@
 #define EXIT_DATA 2
-#include "Automaton.h"
-#include "AutomatonBuilder.h"
-#include "AutomatonVisualizer.h"
-#include "DeterminizationAlgorithm.h"
-#include "MinimizationAlgorithm.h"
+#include "CommandLineParser.h"
+#include "CommandRunner.h"
 
 #include <cstdlib>
-#include <filesystem>
 #include <iostream>
 
-int main()
+int main(int argc, char* argv[])
 {
-	// Должна быть директория (res), можно указать в параметрах сборки
-	std::cout << "Current directory: " << std::filesystem::current_path() << std::endl;
-
 	try
 	{
-		auto automaton = AutomatonBuilder::FromFile("input/home.dot");
-		auto determination = DeterminizationAlgorithm::Determine(automaton, true);
-		// auto minimization = MinimizationAlgorithm::Minimize(determination, true);
-
-		const std::vector<std::string> testWords = {
-			"1101",
-			"1111101",
-			"0",
-			"0001",
-			"11010",
-			"1", // Ошибочный (нет подходящего конечного состояния)
-			"1101",
-			"11101",
-			"000",
-			"000001",
-			"11010"};
+		const auto options = CommandLineParser::Parse(argc, argv);
+		CommandRunner runner(options, std::cin, std::cout, std::cerr);
+		runner.Run();
 
-		AutomatonVisualizer::TestStrings(determination, testWords, true);
-		AutomatonVisualizer::ExportToDot(determination, "output/test.dot");
+		if (argc < 2)
+		{
+			return EXIT_FAILURE;
+		}
 	}
 	catch (const std::invalid_argument& e)
 	{
@@ -48,4 +30,4 @@ int main()
 	}
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
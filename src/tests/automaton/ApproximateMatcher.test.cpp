@@ -0,0 +1,160 @@
+#include "ApproximateMatcher.h"
+#include "Automaton.h"
+#include "DictionaryBuilder.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+class ApproximateMatcherTest : public ::testing::Test
+{
+protected:
+	const std::vector<std::string> words = {"apple", "apply", "banana", "band", "can", "cane", "cat"};
+
+	static std::size_t Levenshtein(const std::string& left, const std::string& right)
+	{
+		std::vector<std::size_t> row(right.size() + 1);
+		for (std::size_t j = 0; j <= right.size(); ++j)
+		{
+			row[j] = j;
+		}
+		for (std::size_t i = 1; i <= left.size(); ++i)
+		{
+			std::size_t diagonal = row[0];
+			row[0] = i;
+			for (std::size_t j = 1; j <= right.size(); ++j)
+			{
+				const std::size_t up = row[j];
+				row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (left[i - 1] != right[j - 1])});
+				diagonal = up;
+			}
+		}
+		return row.back();
+	}
+
+	std::size_t NearestDistance(const std::string& query) const
+	{
+		std::size_t best = SIZE_MAX;
+		for (const auto& word : words)
+		{
+			best = std::min(best, Levenshtein(query, word));
+		}
+		return best;
+	}
+};
+
+// Расстояние совпадает с перебором по словарю
+TEST_F(ApproximateMatcherTest, MatchesBruteForceOnDictionary)
+{
+	const ApproximateMatcher matcher(DictionaryBuilder::FromSortedWords(words));
+
+	for (const std::string query : {"apple", "aple", "appel", "bnd", "banan", "cta", "dog", "", "xxxxxxx", "canes"})
+	{
+		const std::size_t expected = NearestDistance(query);
+		for (std::size_t k = 0; k <= 3; ++k)
+		{
+			EXPECT_EQ(matcher.Matches(query, k), expected <= k) << query << " " << k;
+			const auto distance = matcher.Distance(query, k);
+			EXPECT_EQ(distance.has_value(), expected <= k) << query;
+			if (distance)
+			{
+				EXPECT_EQ(*distance, expected) << query;
+			}
+		}
+	}
+}
+
+// Бесконечный язык с циклами и НКА на входе
+TEST_F(ApproximateMatcherTest, HandlesCyclicNfa)
+{
+	// (ab)*c
+	Automaton nfa;
+	nfa.SetStartState(0);
+	nfa.AddFinalState(3);
+	nfa.AddTransition(0, 'a', 1);
+	nfa.AddTransition(1, 'b', 0);
+	nfa.AddTransition(0, 'c', 3);
+	nfa.AddTransition(0, 'a', 2);
+	nfa.AddTransition(2, 'b', 0);
+
+	const ApproximateMatcher matcher(nfa);
+	EXPECT_EQ(matcher.Distance("ababc", 2), 0u);
+	EXPECT_EQ(matcher.Distance("abbc", 2), 1u);
+	EXPECT_EQ(matcher.Distance("ababab", 2), 1u);
+	EXPECT_FALSE(matcher.Matches("xyz", 2));
+}
+
+// Длинные запросы считаются построчной динамикой
+TEST_F(ApproximateMatcherTest, HandlesLongQueries)
+{
+	const std::string longWord(80, 'a');
+	const ApproximateMatcher matcher(DictionaryBuilder::FromSortedWords({longWord, longWord + "b"}));
+
+	std::string query = longWord;
+	query[10] = 'x';
+	query.erase(40, 1);
+	EXPECT_EQ(matcher.Distance(query, 3), 2u);
+	EXPECT_FALSE(matcher.Matches(query, 1));
+	EXPECT_TRUE(matcher.Matches(longWord + "bb", 1));
+}
+
+// Полоса динамики для длинных запросов совпадает с полным расстоянием Левенштейна
+TEST_F(ApproximateMatcherTest, BandedRowsMatchBruteForce)
+{
+	std::mt19937 random(11);
+	auto randomWord = [&](std::size_t length) {
+		std::string word;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			word += static_cast<char>('a' + random() % 2);
+		}
+		return word;
+	};
+
+	std::vector<std::string> dictionary;
+	for (int i = 0; i < 6; ++i)
+	{
+		dictionary.push_back(randomWord(64 + random() % 20));
+	}
+	std::sort(dictionary.begin(), dictionary.end());
+	const ApproximateMatcher matcher(DictionaryBuilder::FromSortedWords(dictionary));
+
+	for (int round = 0; round < 30; ++round)
+	{
+		std::string query = dictionary[random() % dictionary.size()];
+		for (int edit = random() % 5; edit > 0; --edit)
+		{
+			query[random() % query.size()] = 'c';
+		}
+		std::size_t expected = SIZE_MAX;
+		for (const auto& word : dictionary)
+		{
+			expected = std::min(expected, Levenshtein(query, word));
+		}
+		for (std::size_t k = 0; k <= 4; ++k)
+		{
+			const auto distance = matcher.Distance(query, k);
+			EXPECT_EQ(distance.has_value(), expected <= k) << query;
+			if (distance)
+			{
+				EXPECT_EQ(*distance, expected) << query;
+			}
+		}
+	}
+}
+
+// Очень длинный запрос: обход без рекурсии и память линейна по длине
+TEST_F(ApproximateMatcherTest, HandlesVeryLongQueryWithoutRecursion)
+{
+	// a*
+	Automaton automaton;
+	automaton.SetStartState(0);
+	automaton.AddFinalState(0);
+	automaton.AddTransition(0, 'a', 0);
+
+	std::string query(300000, 'a');
+	const ApproximateMatcher matcher(automaton);
+	EXPECT_EQ(matcher.Distance(query, 2), 0u);
+	query[1000] = 'b';
+	EXPECT_EQ(matcher.Distance(query, 2), 1u);
+}
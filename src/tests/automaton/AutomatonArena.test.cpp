@@ -0,0 +1,79 @@
+#include "AutomatonArena.h"
+
+#include <gtest/gtest.h>
+
+class AutomatonArenaTest : public ::testing::Test
+{
+protected:
+	static void ExpectSameAutomaton(const Automaton& expected, const Automaton& actual)
+	{
+		EXPECT_EQ(actual.GetTitle(), expected.GetTitle());
+		EXPECT_EQ(actual.GetStartState(), expected.GetStartState());
+		EXPECT_EQ(actual.GetStates(), expected.GetStates());
+		EXPECT_EQ(actual.GetFinalStates(), expected.GetFinalStates());
+		EXPECT_EQ(actual.GetAlphabet(), expected.GetAlphabet());
+		EXPECT_EQ(actual.GetTransitions(), expected.GetTransitions());
+		EXPECT_EQ(actual.GetEpsilonTransitions(), expected.GetEpsilonTransitions());
+	}
+};
+
+// Переходы в любом порядке и с повторами дают тот же автомат, что и AddTransition
+TEST_F(AutomatonArenaTest, FreezesIntoSameAutomaton)
+{
+	Automaton expected;
+	AutomatonArena arena;
+	arena.Reserve(8, 64);
+	expected.SetTitle("Arena");
+	expected.SetStartState(5);
+	expected.AddState(42);
+	expected.AddFinalState(7);
+	arena.SetTitle("Arena");
+	arena.SetStartState(5);
+	arena.AddState(42);
+	arena.AddFinalState(7);
+
+	unsigned seed = 1;
+	for (int i = 0; i < 200; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		const State from = (seed >> 8) % 10;
+		const State to = (seed >> 16) % 10;
+		const Symbol on = static_cast<Symbol>('a' + (seed >> 24) % 3);
+		if (i % 7 == 0)
+		{
+			expected.AddEpsilonTransition(from, to);
+			arena.AddEpsilonTransition(from, to);
+		}
+		else
+		{
+			expected.AddTransition(from, on, to);
+			arena.AddTransition(from, on, to);
+		}
+	}
+
+	ExpectSameAutomaton(expected, arena.Freeze());
+	EXPECT_FALSE(expected.IsDeterministic());
+}
+
+// После Freeze построитель пуст и собирает следующий автомат с нуля
+TEST_F(AutomatonArenaTest, ClearsAfterFreeze)
+{
+	AutomatonArena arena;
+	arena.SetStartState(0);
+	arena.AddTransition(0, 'x', 1);
+	arena.AddFinalState(1);
+	const Automaton first = arena.Freeze();
+	EXPECT_TRUE(first.Recognize("x"));
+
+	const Automaton empty = arena.Freeze();
+	EXPECT_TRUE(empty.GetStates().empty());
+	EXPECT_TRUE(empty.GetTransitions().empty());
+
+	arena.SetStartState(3);
+	arena.AddTransition(3, 'y', 3);
+	arena.AddFinalState(3);
+	const Automaton second = arena.Freeze();
+	EXPECT_EQ(second.GetStates(), (std::set<State>{3}));
+	EXPECT_TRUE(second.Recognize("yyy"));
+	EXPECT_FALSE(second.Recognize("x"));
+}
@@ -0,0 +1,92 @@
+#include "Automaton.h"
+#include "BisimulationAlgorithm.h"
+#include "DeterminizationAlgorithm.h"
+#include "EquivalenceAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class BisimulationTest : public ::testing::Test
+{
+protected:
+	Automaton nfa;
+
+	void SetUp() override
+	{
+		// Две одинаковые ветви a(b|c): состояния 1 и 2, 3 и 4 бисимилярны вперед
+		nfa.SetStartState(0);
+		nfa.AddFinalState(3);
+		nfa.AddFinalState(4);
+		nfa.AddTransition(0, 'a', 1);
+		nfa.AddTransition(0, 'a', 2);
+		nfa.AddTransition(1, 'b', 3);
+		nfa.AddTransition(1, 'c', 3);
+		nfa.AddTransition(2, 'b', 4);
+		nfa.AddTransition(2, 'c', 4);
+	}
+};
+
+// Прямая бисимуляция сливает ветви с одинаковыми продолжениями
+TEST_F(BisimulationTest, ForwardMergesEqualContinuations)
+{
+	const auto reduced = BisimulationAlgorithm::Reduce(nfa, BisimulationDirection::FORWARD);
+	EXPECT_EQ(reduced.GetStates().size(), 3);
+	EXPECT_TRUE(reduced.IsDeterministic());
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(nfa, reduced));
+}
+
+// Обратная бисимуляция сливает состояния с одинаковыми префиксами
+TEST_F(BisimulationTest, BackwardMergesEqualPrefixes)
+{
+	Automaton prefixes;
+	prefixes.SetStartState(0);
+	prefixes.AddFinalState(3);
+	prefixes.AddFinalState(4);
+	prefixes.AddTransition(0, 'a', 1);
+	prefixes.AddTransition(0, 'a', 2);
+	prefixes.AddTransition(1, 'b', 3);
+	prefixes.AddTransition(2, 'c', 4);
+
+	// Вперед сливаются только конечные 3 и 4, назад - только 1 и 2
+	const auto forward = BisimulationAlgorithm::Reduce(prefixes, BisimulationDirection::FORWARD);
+	EXPECT_EQ(forward.GetStates().size(), 4);
+
+	const auto backward = BisimulationAlgorithm::Reduce(prefixes, BisimulationDirection::BACKWARD);
+	EXPECT_EQ(backward.GetStates().size(), 4);
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(prefixes, backward));
+
+	const auto combined = BisimulationAlgorithm::Reduce(prefixes);
+	EXPECT_EQ(combined.GetStates().size(), 3);
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(prefixes, combined));
+}
+
+// e-переходы участвуют в сигнатуре как отдельная метка
+TEST_F(BisimulationTest, KeepsEpsilonTransitions)
+{
+	Automaton epsilonNfa;
+	epsilonNfa.SetStartState(0);
+	epsilonNfa.AddFinalState(3);
+	epsilonNfa.AddEpsilonTransition(0, 1);
+	epsilonNfa.AddEpsilonTransition(0, 2);
+	epsilonNfa.AddTransition(1, 'a', 3);
+	epsilonNfa.AddTransition(2, 'a', 3);
+	epsilonNfa.AddTransition(2, 'b', 0);
+
+	// 1 и 2 достижимы одинаково, хотя продолжения у них разные
+	const auto reduced = BisimulationAlgorithm::Reduce(epsilonNfa);
+	EXPECT_EQ(reduced.GetStates().size(), 3);
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(epsilonNfa, reduced));
+}
+
+// Сокращение перед детерминизацией не меняет язык
+TEST_F(BisimulationTest, CombinedReductionPreservesLanguage)
+{
+	const auto reduced = BisimulationAlgorithm::Reduce(nfa);
+	EXPECT_EQ(reduced.GetStates().size(), 3);
+	EXPECT_EQ(reduced.GetTitle(), nfa.GetTitle() + "Reduced");
+
+	const auto dfa = DeterminizationAlgorithm::Determine(reduced);
+	for (const std::string word : {"", "a", "ab", "ac", "abc", "b"})
+	{
+		EXPECT_EQ(dfa.Recognize(word), nfa.Recognize(word)) << word;
+	}
+}
@@ -2,6 +2,8 @@
 #include "DeterminizationAlgorithm.h"
 #include <gtest/gtest.h>
 
+#include <functional>
+
 class DeterminizationTest : public ::testing::Test
 {
 protected:
@@ -67,7 +69,7 @@ TEST_F(DeterminizationTest, HandlesEpsilonClosureFromStart)
 {
     nfa.SetStartState(0);
     nfa.AddFinalState(2);
-    nfa.AddTransition(0, EPSILON, 1);
+    nfa.AddEpsilonTransition(0, 1);
     nfa.AddTransition(1, 'a', 2);
 
     Automaton dfa = DeterminizationAlgorithm::Determine(nfa);
@@ -83,8 +85,8 @@ TEST_F(DeterminizationTest, HandlesEpsilonClosureAfterMove)
     nfa.SetStartState(0);
     nfa.AddFinalState(3);
     nfa.AddTransition(0, 'a', 1);
-    nfa.AddTransition(1, EPSILON, 2);
-    nfa.AddTransition(2, EPSILON, 3);
+    nfa.AddEpsilonTransition(1, 2);
+    nfa.AddEpsilonTransition(2, 3);
 
     Automaton dfa = DeterminizationAlgorithm::Determine(nfa);
 
@@ -98,8 +100,8 @@ TEST_F(DeterminizationTest, HandlesEpsilonLoop)
 {
     nfa.SetStartState(0);
     nfa.AddFinalState(2);
-    nfa.AddTransition(0, EPSILON, 1);
-    nfa.AddTransition(1, EPSILON, 0);
+    nfa.AddEpsilonTransition(0, 1);
+    nfa.AddEpsilonTransition(1, 0);
     nfa.AddTransition(1, 'a', 2);
 
     Automaton dfa = DeterminizationAlgorithm::Determine(nfa);
@@ -114,7 +116,7 @@ TEST_F(DeterminizationTest, HandlesEpsilonToFinalFromStart)
 {
     nfa.SetStartState(0);
     nfa.AddFinalState(1);
-    nfa.AddTransition(0, EPSILON, 1);
+    nfa.AddEpsilonTransition(0, 1);
 
     Automaton dfa = DeterminizationAlgorithm::Determine(nfa);
 
@@ -134,13 +136,74 @@ TEST_F(DeterminizationTest, HandlesComplexMixedAutomaton)
     nfa.AddTransition(0, 'a', 1);
     nfa.AddTransition(1, 'b', 2);
 
-    nfa.AddTransition(0, EPSILON, 3);
+    nfa.AddEpsilonTransition(0, 3);
     nfa.AddTransition(3, 'a', 4);
-    nfa.AddTransition(4, EPSILON, 2);
+    nfa.AddEpsilonTransition(4, 2);
 
     Automaton dfa = DeterminizationAlgorithm::Determine(nfa);
 
     EXPECT_EQ(dfa.GetStates().size(), 3);
     EXPECT_EQ(dfa.GetFinalStates().size(), 2);
     EXPECT_EQ(GetTransitionCount(dfa), 6);
-}
\ No newline at end of file
+}
+
+// Сбор статистики по фазам детерминизации
+TEST_F(DeterminizationTest, CollectsStats)
+{
+    nfa.SetStartState(0);
+    nfa.AddFinalState(2);
+    nfa.AddTransition(0, 'a', 0);
+    nfa.AddTransition(0, 'b', 0);
+    nfa.AddTransition(0, 'a', 1);
+    nfa.AddTransition(1, 'b', 2);
+
+    DeterminizationStats stats;
+    Automaton dfa = DeterminizationAlgorithm::Determine(nfa, false, &stats);
+
+    EXPECT_EQ(stats.dfaStates, dfa.GetStates().size());
+    EXPECT_EQ(stats.dfaTransitions, GetTransitionCount(dfa));
+    EXPECT_EQ(stats.registryMisses, 3);
+    EXPECT_EQ(stats.registryHits, 4);
+    EXPECT_EQ(stats.moveCalls, 6);
+    EXPECT_EQ(stats.closureCalls, 7);
+    EXPECT_GE(stats.peakFrontierSize, 1);
+    EXPECT_GT(stats.peakBytes, 0);
+    EXPECT_GE(stats.totalTime, stats.moveTime);
+    EXPECT_NE(stats.ToJson().find("\"registryHits\": 4"), std::string::npos);
+}
+
+// Перегрузка для временного автомата дает тот же ДКА, в том числе для неподрезанного входа
+// и для бесполезного старта с петлей
+TEST_F(DeterminizationTest, MovedInputGivesSameDfa)
+{
+    nfa.SetStartState(0);
+    nfa.AddFinalState(2);
+    nfa.AddTransition(0, 'a', 0);
+    nfa.AddTransition(0, 'b', 0);
+    nfa.AddTransition(0, 'a', 1);
+    nfa.AddTransition(1, 'b', 2);
+    nfa.AddEpsilonTransition(1, 3);
+    nfa.AddTransition(5, 'a', 2);
+
+    Automaton deadLoop;
+    deadLoop.SetStartState(1);
+    deadLoop.AddTransition(1, 'b', 1);
+
+    for (Automaton& input : {std::ref(nfa), std::ref(deadLoop)})
+    {
+        const Automaton expected = DeterminizationAlgorithm::Determine(input);
+        Automaton copy = input;
+        const Automaton moved = DeterminizationAlgorithm::Determine(std::move(copy));
+        DeterminizationAlgorithm::DetermineInPlace(input);
+        const Automaton& inPlace = input;
+
+        for (const auto* dfa : {&moved, &inPlace})
+        {
+            EXPECT_EQ(dfa->GetStates(), expected.GetStates());
+            EXPECT_EQ(dfa->GetFinalStates(), expected.GetFinalStates());
+            EXPECT_EQ(dfa->GetTransitions(), expected.GetTransitions());
+            EXPECT_EQ(dfa->GetTitle(), expected.GetTitle());
+        }
+    }
+    EXPECT_TRUE(deadLoop.GetTransitions().empty());
+}
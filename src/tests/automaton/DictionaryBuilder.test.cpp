@@ -0,0 +1,96 @@
+#include "Automaton.h"
+#include "DictionaryBuilder.h"
+#include "MinimizationAlgorithm.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+class DictionaryBuilderTest : public ::testing::Test
+{
+protected:
+	const std::vector<std::string> words = {"stop", "stops", "tap", "taps", "top", "tops"};
+
+	static Automaton BuildByTransitions(const std::vector<std::string>& words)
+	{
+		Automaton trie;
+		trie.SetStartState(0);
+		State next = 1;
+		for (const auto& word : words)
+		{
+			State state = 0;
+			for (const char symbol : word)
+			{
+				trie.AddTransition(state, symbol, next);
+				state = next++;
+			}
+			trie.AddFinalState(state);
+		}
+		return trie;
+	}
+};
+
+// Автомат принимает ровно слова словаря
+TEST_F(DictionaryBuilderTest, AcceptsExactlyTheWords)
+{
+	const auto dictionary = DictionaryBuilder::FromSortedWords(words);
+
+	EXPECT_TRUE(dictionary.IsDeterministic());
+	for (const auto& word : words)
+	{
+		EXPECT_TRUE(dictionary.Recognize(word)) << word;
+	}
+	for (const std::string word : {"", "s", "sto", "stopss", "ta", "tip"})
+	{
+		EXPECT_FALSE(dictionary.Recognize(word)) << word;
+	}
+}
+
+// Результат сразу минимален: совпадает по размеру с детерминизацией и минимизацией бора
+TEST_F(DictionaryBuilderTest, BuildsMinimalAutomaton)
+{
+	const auto dictionary = DictionaryBuilder::FromSortedWords(words);
+	const auto minimized = MinimizationAlgorithm::MinimizeNfa(BuildByTransitions(words));
+
+	// Корень, s-t-o и t-(a|o) сходятся в общий хвост p-(s)
+	EXPECT_EQ(dictionary.GetStates().size(), 7);
+	EXPECT_EQ(dictionary.GetStates().size(), minimized.GetStates().size());
+}
+
+// Неотсортированный поток и повторы
+TEST_F(DictionaryBuilderTest, AcceptsUnsortedInput)
+{
+	std::istringstream stream("tops\nstop\ntap\nstop\ntaps\r\ntop\nstops\n");
+	const auto dictionary = DictionaryBuilder::FromStream(stream, false);
+
+	EXPECT_EQ(dictionary.GetStates().size(), DictionaryBuilder::FromSortedWords(words).GetStates().size());
+	EXPECT_TRUE(dictionary.Recognize("taps"));
+}
+
+// Нарушение порядка в сортированном режиме - ошибка
+TEST_F(DictionaryBuilderTest, RejectsUnsortedWords)
+{
+	DictionaryBuilder builder;
+	builder.Add("b");
+	EXPECT_THROW(builder.Add("a"), std::invalid_argument);
+}
+
+// Живых состояний не больше, чем в итоговом автомате плюс текущая ветка
+TEST_F(DictionaryBuilderTest, KeepsOnlyRegisterAndCurrentBranch)
+{
+	DictionaryBuilder builder;
+	std::size_t peak = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		builder.Add(std::to_string(100000 + i));
+		peak = std::max(peak, builder.GetStateCount());
+	}
+	const auto dictionary = builder.Build();
+
+	EXPECT_LE(peak, dictionary.GetStates().size() + 6);
+	EXPECT_TRUE(dictionary.Recognize("100999"));
+	EXPECT_FALSE(dictionary.Recognize("101000"));
+
+	// После Build построитель готов к новому словарю
+	builder.Add("x");
+	EXPECT_EQ(builder.Build().GetStates().size(), 2);
+}
@@ -0,0 +1,97 @@
+#include "Automaton.h"
+#include "DeterminizationAlgorithm.h"
+#include "EpsilonEliminationAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class EpsilonEliminationTest : public ::testing::Test
+{
+protected:
+	Automaton nfa;
+
+	void ExpectSameLanguage(const Automaton& other, const std::vector<std::string>& words) const
+	{
+		for (const auto& word : words)
+		{
+			EXPECT_EQ(nfa.Recognize(word), other.Recognize(word)) << word;
+		}
+	}
+};
+
+// Замыкание на e-цикле одно для всей компоненты
+TEST_F(EpsilonEliminationTest, SharesClosureInsideEpsilonCycle)
+{
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddEpsilonTransition(1, 2);
+	nfa.AddEpsilonTransition(2, 0);
+	nfa.AddEpsilonTransition(2, 3);
+	nfa.AddTransition(3, 'a', 4);
+
+	const EpsilonClosureTable closures(nfa);
+
+	EXPECT_EQ(closures.GetComponentCount(), 3);
+	EXPECT_EQ(closures.Get(0), (std::vector<State>{0, 1, 2, 3}));
+	EXPECT_EQ(closures.Get(1), closures.Get(0));
+	EXPECT_EQ(closures.Get(3), (std::vector<State>{3}));
+	EXPECT_EQ(closures.Get(4), (std::vector<State>{4}));
+	EXPECT_TRUE(closures.Get(42).empty());
+}
+
+// Замыкание совпадает с обходом в ширину
+TEST_F(EpsilonEliminationTest, MatchesBreadthFirstClosure)
+{
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddEpsilonTransition(0, 2);
+	nfa.AddEpsilonTransition(1, 3);
+	nfa.AddEpsilonTransition(2, 3);
+	nfa.AddEpsilonTransition(3, 4);
+	nfa.AddEpsilonTransition(4, 2);
+	nfa.AddTransition(4, 'b', 5);
+	nfa.AddEpsilonTransition(5, 0);
+
+	const EpsilonClosureTable closures(nfa);
+	for (const State state : nfa.GetStates())
+	{
+		const auto expected = DeterminizationAlgorithm::EpsilonClosure(nfa, state);
+		EXPECT_EQ(closures.Get(state), std::vector<State>(expected.begin(), expected.end())) << state;
+	}
+}
+
+// Результат без e-переходов и распознает тот же язык
+TEST_F(EpsilonEliminationTest, RemovesEpsilonPreservingLanguage)
+{
+	nfa.SetStartState(0);
+	nfa.AddFinalState(4);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddEpsilonTransition(0, 3);
+	nfa.AddTransition(1, 'a', 1);
+	nfa.AddTransition(1, 'b', 2);
+	nfa.AddEpsilonTransition(2, 4);
+	nfa.AddTransition(3, 'b', 3);
+	nfa.AddEpsilonTransition(3, 4);
+
+	const auto epsilonFree = EpsilonEliminationAlgorithm::RemoveEpsilon(nfa);
+
+	EXPECT_TRUE(epsilonFree.GetEpsilonTransitions().empty());
+	EXPECT_TRUE(epsilonFree.GetFinalStates().contains(0));
+	ExpectSameLanguage(epsilonFree, {"", "a", "b", "ab", "aab", "bb", "ba", "aba", "bbbb"});
+}
+
+// Детерминизация с таблицей замыканий дает тот же ДКА
+TEST_F(EpsilonEliminationTest, DeterminizationUsesSameClosures)
+{
+	nfa.SetStartState(0);
+	nfa.AddFinalState(3);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddTransition(1, 'a', 2);
+	nfa.AddEpsilonTransition(2, 0);
+	nfa.AddTransition(2, 'b', 3);
+
+	const auto dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_EQ(dfa.GetStates().size(), 3);
+	EXPECT_TRUE(dfa.IsDeterministic());
+	ExpectSameLanguage(dfa, {"", "a", "ab", "aab", "abab", "b"});
+}
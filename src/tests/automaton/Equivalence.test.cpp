@@ -0,0 +1,111 @@
+#include "Automaton.h"
+#include "DeterminizationAlgorithm.h"
+#include "EquivalenceAlgorithm.h"
+#include "MinimizationAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class EquivalenceTest : public ::testing::Test
+{
+protected:
+	Automaton nfa;
+
+	void SetUp() override
+	{
+		// (a|b)*a(a|b)(a|b): третий символ с конца - 'a'
+		nfa.SetStartState(0);
+		nfa.AddFinalState(3);
+		nfa.AddTransition(0, 'a', 0);
+		nfa.AddTransition(0, 'b', 0);
+		nfa.AddTransition(0, 'a', 1);
+		for (State state = 1; state < 3; ++state)
+		{
+			nfa.AddTransition(state, 'a', state + 1);
+			nfa.AddTransition(state, 'b', state + 1);
+		}
+	}
+
+	static void ExpectDistinguishes(const Automaton& left, const Automaton& right, const std::string& word)
+	{
+		EXPECT_NE(left.Recognize(word), right.Recognize(word)) << "'" << word << "'";
+	}
+};
+
+// ДКА эквивалентен своему минимальному
+TEST_F(EquivalenceTest, DfaIsEquivalentToMinimized)
+{
+	const auto dfa = DeterminizationAlgorithm::Determine(nfa);
+	const auto minimized = MinimizationAlgorithm::Minimize(dfa);
+
+	std::string counterexample = "unchanged";
+	EXPECT_TRUE(EquivalenceAlgorithm::AreDfaEquivalent(dfa, minimized, &counterexample));
+	EXPECT_EQ(counterexample, "unchanged");
+}
+
+// Различающее слово для разных ДКА
+TEST_F(EquivalenceTest, FindsDfaCounterexample)
+{
+	Automaton evenLength;
+	evenLength.SetStartState(0);
+	evenLength.AddFinalState(0);
+	evenLength.AddTransition(0, 'a', 1);
+	evenLength.AddTransition(1, 'a', 0);
+
+	Automaton aStar;
+	aStar.SetStartState(0);
+	aStar.AddFinalState(0);
+	aStar.AddTransition(0, 'a', 0);
+
+	std::string counterexample;
+	EXPECT_FALSE(EquivalenceAlgorithm::AreEquivalent(evenLength, aStar, &counterexample));
+	EXPECT_EQ(counterexample, "a");
+	ExpectDistinguishes(evenLength, aStar, counterexample);
+}
+
+// Частичный ДКА и полный ДКА с тупиковым состоянием эквивалентны
+TEST_F(EquivalenceTest, TreatsMissingTransitionsAsSink)
+{
+	Automaton partial;
+	partial.SetStartState(0);
+	partial.AddFinalState(1);
+	partial.AddTransition(0, 'a', 1);
+
+	Automaton complete = partial;
+	complete.AddTransition(0, 'b', 2);
+	complete.AddTransition(1, 'a', 2);
+	complete.AddTransition(1, 'b', 2);
+	complete.AddTransition(2, 'a', 2);
+	complete.AddTransition(2, 'b', 2);
+
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(partial, complete));
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(Automaton(), Automaton()));
+}
+
+// НКА эквивалентен своей детерминизации без ее построения
+TEST_F(EquivalenceTest, NfaIsEquivalentToDeterminized)
+{
+	const auto dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(nfa, dfa));
+	EXPECT_TRUE(EquivalenceAlgorithm::AreNfaEquivalent(dfa, nfa));
+}
+
+// Различающее слово для НКА с e-переходами
+TEST_F(EquivalenceTest, FindsNfaCounterexample)
+{
+	// (a|b)*a(a|b): второй символ с конца - 'a', через e-переход
+	Automaton other;
+	other.SetStartState(0);
+	other.AddFinalState(3);
+	other.AddTransition(0, 'a', 0);
+	other.AddTransition(0, 'b', 0);
+	other.AddTransition(0, 'a', 1);
+	other.AddEpsilonTransition(1, 2);
+	other.AddTransition(2, 'a', 3);
+	other.AddTransition(2, 'b', 3);
+
+	std::string counterexample;
+	EXPECT_FALSE(EquivalenceAlgorithm::AreEquivalent(nfa, other, &counterexample));
+	ExpectDistinguishes(nfa, other, counterexample);
+	EXPECT_EQ(counterexample.size(), 2);
+}
@@ -0,0 +1,105 @@
+#include "Automaton.h"
+#include "InclusionAlgorithm.h"
+#include "LanguageOperations.h"
+
+#include <gtest/gtest.h>
+
+class InclusionTest : public ::testing::Test
+{
+protected:
+	Automaton thirdFromEnd;
+	Automaton anyWord;
+
+	void SetUp() override
+	{
+		// (a|b)*a(a|b)(a|b): третий символ с конца - 'a'
+		thirdFromEnd.SetStartState(0);
+		thirdFromEnd.AddFinalState(3);
+		thirdFromEnd.AddTransition(0, 'a', 0);
+		thirdFromEnd.AddTransition(0, 'b', 0);
+		thirdFromEnd.AddTransition(0, 'a', 1);
+		for (State state = 1; state < 3; ++state)
+		{
+			thirdFromEnd.AddTransition(state, 'a', state + 1);
+			thirdFromEnd.AddTransition(state, 'b', state + 1);
+		}
+
+		// (a|b)*
+		anyWord.SetStartState(0);
+		anyWord.AddFinalState(0);
+		anyWord.AddTransition(0, 'a', 0);
+		anyWord.AddTransition(0, 'b', 0);
+	}
+};
+
+// Пустота и кратчайшее принимаемое слово
+TEST_F(InclusionTest, EmptinessWithWitness)
+{
+	std::string witness;
+	EXPECT_FALSE(InclusionAlgorithm::IsEmpty(thirdFromEnd, &witness));
+	EXPECT_EQ(witness, "aaa");
+
+	Automaton unreachable;
+	unreachable.SetStartState(0);
+	unreachable.AddFinalState(1);
+	unreachable.AddTransition(1, 'a', 1);
+	EXPECT_TRUE(InclusionAlgorithm::IsEmpty(unreachable));
+}
+
+// Универсальность: контрпример - кратчайшее непринимаемое слово
+TEST_F(InclusionTest, Universality)
+{
+	EXPECT_TRUE(InclusionAlgorithm::IsUniversal(anyWord));
+
+	std::string witness;
+	EXPECT_FALSE(InclusionAlgorithm::IsUniversal(thirdFromEnd, &witness));
+	EXPECT_EQ(witness, "");
+
+	EXPECT_FALSE(InclusionAlgorithm::IsUniversal(anyWord, {'a', 'b', 'c'}, &witness));
+	EXPECT_EQ(witness, "c");
+}
+
+// e-переходы учитываются через замыкание
+TEST_F(InclusionTest, UniversalityWithEpsilon)
+{
+	Automaton nfa;
+	nfa.SetStartState(0);
+	nfa.AddFinalState(1);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddTransition(1, 'a', 0);
+	EXPECT_TRUE(InclusionAlgorithm::IsUniversal(nfa));
+}
+
+// Включение и слово из разности
+TEST_F(InclusionTest, InclusionWithWitness)
+{
+	EXPECT_TRUE(InclusionAlgorithm::IsIncluded(thirdFromEnd, anyWord));
+
+	std::string witness;
+	EXPECT_FALSE(InclusionAlgorithm::IsIncluded(anyWord, thirdFromEnd, &witness));
+	EXPECT_TRUE(anyWord.Recognize(witness));
+	EXPECT_FALSE(thirdFromEnd.Recognize(witness));
+	EXPECT_EQ(witness, "");
+}
+
+// Согласованность с явной разностью языков
+TEST_F(InclusionTest, AgreesWithDifference)
+{
+	Automaton secondFromEnd;
+	secondFromEnd.SetStartState(0);
+	secondFromEnd.AddFinalState(2);
+	secondFromEnd.AddTransition(0, 'a', 0);
+	secondFromEnd.AddTransition(0, 'b', 0);
+	secondFromEnd.AddTransition(0, 'a', 1);
+	secondFromEnd.AddTransition(1, 'a', 2);
+	secondFromEnd.AddTransition(1, 'b', 2);
+
+	std::string witness;
+	EXPECT_FALSE(InclusionAlgorithm::IsIncluded(thirdFromEnd, secondFromEnd, &witness));
+	EXPECT_TRUE(thirdFromEnd.Recognize(witness));
+	EXPECT_FALSE(secondFromEnd.Recognize(witness));
+
+	const auto difference = LanguageOperations::Subtract(thirdFromEnd, secondFromEnd);
+	EXPECT_FALSE(InclusionAlgorithm::IsEmpty(difference));
+	EXPECT_TRUE(InclusionAlgorithm::IsEmpty(LanguageOperations::Subtract(thirdFromEnd, anyWord)));
+}
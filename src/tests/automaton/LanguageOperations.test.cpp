@@ -0,0 +1,153 @@
+#include "Automaton.h"
+#include "LanguageOperations.h"
+
+#include <gtest/gtest.h>
+#include <functional>
+
+class LanguageOperationsTest : public ::testing::Test
+{
+protected:
+	Automaton evenA;
+	Automaton endsWithB;
+
+	void SetUp() override
+	{
+		// Четное число букв 'a'
+		evenA.SetStartState(0);
+		evenA.AddFinalState(0);
+		evenA.AddTransition(0, 'a', 1);
+		evenA.AddTransition(1, 'a', 0);
+		evenA.AddTransition(0, 'b', 0);
+		evenA.AddTransition(1, 'b', 1);
+
+		// Оканчивается на 'b' (НКА)
+		endsWithB.SetStartState(0);
+		endsWithB.AddFinalState(1);
+		endsWithB.AddTransition(0, 'a', 0);
+		endsWithB.AddTransition(0, 'b', 0);
+		endsWithB.AddTransition(0, 'b', 1);
+	}
+
+	// Сравнение со значением предиката на всех словах над {a, b} длины до maxLength
+	static void ExpectLanguage(
+		const std::function<bool(const std::string&)>& recognize,
+		const std::function<bool(const std::string&)>& expected,
+		std::size_t maxLength = 6)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t length = 0; length <= maxLength; ++length)
+		{
+			std::vector<std::string> next;
+			for (const auto& word : words)
+			{
+				EXPECT_EQ(recognize(word), expected(word)) << "'" << word << "'";
+				next.push_back(word + "a");
+				next.push_back(word + "b");
+			}
+			words = std::move(next);
+		}
+	}
+
+	static bool IsEvenA(const std::string& word)
+	{
+		return std::count(word.begin(), word.end(), 'a') % 2 == 0;
+	}
+
+	static bool IsEndsWithB(const std::string& word)
+	{
+		return !word.empty() && word.back() == 'b';
+	}
+};
+
+// Пересечение
+TEST_F(LanguageOperationsTest, IntersectsLanguages)
+{
+	const auto result = LanguageOperations::Intersect(evenA, endsWithB);
+
+	EXPECT_TRUE(result.IsDeterministic());
+	EXPECT_EQ(result.GetStates().size(), 4);
+	ExpectLanguage([&](const std::string& w) { return result.Recognize(w); },
+		[](const std::string& w) { return IsEvenA(w) && IsEndsWithB(w); });
+}
+
+// Объединение и разность
+TEST_F(LanguageOperationsTest, UnitesAndSubtractsLanguages)
+{
+	const auto united = LanguageOperations::Unite(evenA, endsWithB);
+	const auto subtracted = LanguageOperations::Subtract(evenA, endsWithB);
+
+	ExpectLanguage([&](const std::string& w) { return united.Recognize(w); },
+		[](const std::string& w) { return IsEvenA(w) || IsEndsWithB(w); });
+	ExpectLanguage([&](const std::string& w) { return subtracted.Recognize(w); },
+		[](const std::string& w) { return IsEvenA(w) && !IsEndsWithB(w); });
+}
+
+// Дополнение частичного автомата
+TEST_F(LanguageOperationsTest, ComplementsPartialAutomaton)
+{
+	Automaton onlyAb;
+	onlyAb.SetStartState(0);
+	onlyAb.AddFinalState(2);
+	onlyAb.AddTransition(0, 'a', 1);
+	onlyAb.AddTransition(1, 'b', 2);
+
+	const auto complement = LanguageOperations::Complement(onlyAb);
+
+	EXPECT_TRUE(complement.IsDeterministic());
+	ExpectLanguage([&](const std::string& w) { return complement.Recognize(w); },
+		[](const std::string& w) { return w != "ab"; });
+	EXPECT_FALSE(complement.Recognize("c"));
+}
+
+// Ленивое произведение распознает без построения и создает только посещенные состояния
+TEST_F(LanguageOperationsTest, LazyProductExploresOnlyVisitedStates)
+{
+	auto product = LanguageOperations::LazyIntersect({evenA, endsWithB});
+
+	EXPECT_EQ(product.GetExploredStateCount(), 1);
+	EXPECT_TRUE(product.Recognize("bb"));
+	EXPECT_EQ(product.GetExploredStateCount(), 2);
+	EXPECT_FALSE(product.Recognize("ab"));
+	EXPECT_TRUE(product.Recognize("aab"));
+	EXPECT_LE(product.GetExploredStateCount(), 4);
+}
+
+// Пересечение многих ограничений: каждая буква из набора должна встретиться
+TEST_F(LanguageOperationsTest, IntersectsManyConstraints)
+{
+	const std::string letters = "abcdefghijkl";
+	std::vector<Automaton> constraints;
+	for (const char letter : letters)
+	{
+		Automaton contains;
+		contains.SetStartState(0);
+		contains.AddFinalState(1);
+		for (const char symbol : letters)
+		{
+			contains.AddTransition(0, symbol, symbol == letter ? 1 : 0);
+			contains.AddTransition(1, symbol, 1);
+		}
+		constraints.push_back(std::move(contains));
+	}
+
+	auto product = LanguageOperations::LazyIntersect(constraints);
+
+	EXPECT_TRUE(product.Recognize("lkjihgfedcba"));
+	EXPECT_TRUE(product.Recognize("abcdefghijklabc"));
+	EXPECT_FALSE(product.Recognize("abcdefghijk"));
+	EXPECT_LT(product.GetExploredStateCount(), 40);
+}
+
+// Обращение: слово принимается тогда и только тогда, когда исходный автомат принимает зеркальное
+TEST_F(LanguageOperationsTest, ReversesLanguage)
+{
+	const auto reversed = LanguageOperations::Reverse(endsWithB);
+	ExpectLanguage([&](const std::string& w) { return reversed.Recognize(w); },
+		[](const std::string& w) { return !w.empty() && w.front() == 'b'; });
+
+	// Несколько конечных состояний - новый старт с e-переходами
+	const auto reversedEven = LanguageOperations::Reverse(LanguageOperations::Unite(evenA, endsWithB));
+	EXPECT_TRUE(reversedEven.HasEpsilonTransitions());
+	ExpectLanguage([&](const std::string& w) { return reversedEven.Recognize(w); },
+		[](const std::string& w) { return IsEvenA(w) || (!w.empty() && w.front() == 'b'); });
+}
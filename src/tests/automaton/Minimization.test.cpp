@@ -1,7 +1,9 @@
 #include "Automaton.h"
+#include "EquivalenceAlgorithm.h"
 #include "MinimizationAlgorithm.h"
 
 #include <gtest/gtest.h>
+#include <random>
 
 class MinimizationTest : public ::testing::Test
 {
@@ -57,6 +59,14 @@ TEST_F(MinimizationTest, HandlesEmptyAutomaton)
 	EXPECT_EQ(automaton.GetStates().size(), 0);
 	EXPECT_NO_THROW(MinimizationAlgorithm::Minimize(automaton));
 	EXPECT_EQ(automaton.GetStates().size(), 0);
+
+	// Пустой результат подписан так же, как непустой
+	automaton.SetTitle("empty");
+	const Automaton expected = MinimizationAlgorithm::Minimize(automaton);
+	EXPECT_EQ(expected.GetTitle(), "emptyMinimized");
+	EXPECT_EQ(MinimizationAlgorithm::Minimize(Automaton(automaton)).GetTitle(), expected.GetTitle());
+	EXPECT_EQ(MinimizationAlgorithm::MinimizeHopcroft(automaton).GetTitle(), expected.GetTitle());
+	EXPECT_EQ(MinimizationAlgorithm::MinimizeBrzozowski(automaton).GetTitle(), expected.GetTitle());
 }
 
 // Проверяем автомат с одним состоянием
@@ -156,7 +166,183 @@ TEST_F(MinimizationTest, HandlesMultiStepRefinement)
 
     Automaton minimized = MinimizationAlgorithm::Minimize(automaton);
 
-    EXPECT_EQ(minimized.GetStates().size(), 4);
+    // Мертвое состояние 4 удаляется до разбиения
+    EXPECT_EQ(minimized.GetStates().size(), 3);
     EXPECT_EQ(minimized.GetFinalStates().size(), 1);
-    EXPECT_EQ(GetTransitionCount(minimized), 8);
-}
\ No newline at end of file
+    EXPECT_EQ(GetTransitionCount(minimized), 3);
+}
+
+// Сбор статистики по итерациям разбиения
+TEST_F(MinimizationTest, CollectsStats)
+{
+    automaton.SetStartState(0);
+    automaton.AddFinalState(3);
+    automaton.AddTransition(0, 'a', 1);
+    automaton.AddTransition(1, 'a', 2);
+    automaton.AddTransition(2, 'a', 3);
+
+    MinimizationStats stats;
+    Automaton minimized = MinimizationAlgorithm::Minimize(automaton, false, &stats);
+
+    EXPECT_EQ(stats.reachableStates, 4);
+    EXPECT_EQ(stats.minimizedStates, minimized.GetStates().size());
+    EXPECT_EQ(stats.refinementIterations, 3);
+    EXPECT_EQ(stats.partitionsPerIteration, (std::vector<std::size_t>{3, 4, 4}));
+    EXPECT_GT(stats.peakBytes, 0);
+    EXPECT_NE(stats.ToJson().find("\"partitionsPerIteration\": [3, 4, 4]"), std::string::npos);
+}
+
+// Брзозовский и путь через детерминизацию дают ДКА одного размера и языка
+TEST_F(MinimizationTest, BrzozowskiMatchesHopcroft)
+{
+    // (a|b)*a(a|b)^4 с лишней e-цепочкой в начале
+    automaton.SetStartState(0);
+    automaton.AddEpsilonTransition(0, 1);
+    automaton.AddTransition(1, 'a', 1);
+    automaton.AddTransition(1, 'b', 1);
+    automaton.AddTransition(1, 'a', 2);
+    for (State state = 2; state < 6; ++state)
+    {
+        automaton.AddTransition(state, 'a', state + 1);
+        automaton.AddTransition(state, 'b', state + 1);
+    }
+    automaton.AddFinalState(6);
+
+    const auto brzozowski = MinimizationAlgorithm::MinimizeNfa(automaton, MinimizationStrategy::BRZOZOWSKI);
+    const auto hopcroft = MinimizationAlgorithm::MinimizeNfa(automaton, MinimizationStrategy::HOPCROFT);
+
+    EXPECT_TRUE(brzozowski.IsDeterministic());
+    EXPECT_EQ(brzozowski.GetStates().size(), 32);
+    EXPECT_EQ(hopcroft.GetStates().size(), 32);
+    EXPECT_EQ(GetTransitionCount(brzozowski), GetTransitionCount(hopcroft));
+    for (const std::string word : {"", "a", "abbbb", "aabbbb", "babab", "bbbbbb"})
+    {
+        EXPECT_EQ(brzozowski.Recognize(word), automaton.Recognize(word)) << word;
+    }
+}
+
+// Выбор стратегии: ДКА - уточнение разбиения, n-й символ с конца - Брзозовский
+TEST_F(MinimizationTest, ChoosesStrategyBySubsetCount)
+{
+    automaton.SetStartState(0);
+    automaton.AddFinalState(1);
+    automaton.AddTransition(0, 'a', 1);
+    EXPECT_EQ(MinimizationAlgorithm::ChooseStrategy(automaton), MinimizationStrategy::HOPCROFT);
+
+    Automaton nfa;
+    constexpr State n = 10;
+    nfa.SetStartState(0);
+    nfa.AddTransition(0, 'a', 0);
+    nfa.AddTransition(0, 'b', 0);
+    nfa.AddTransition(0, 'a', 1);
+    for (State state = 1; state < n; ++state)
+    {
+        nfa.AddTransition(state, 'a', state + 1);
+        nfa.AddTransition(state, 'b', state + 1);
+    }
+    nfa.AddFinalState(n);
+    EXPECT_EQ(MinimizationAlgorithm::ChooseStrategy(nfa), MinimizationStrategy::BRZOZOWSKI);
+    EXPECT_EQ(MinimizationAlgorithm::MinimizeNfa(nfa).GetStates().size(), 1u << n);
+}
+
+// Алгоритм Хопкрофта дает тот же минимальный ДКА, что и проходы Мура
+TEST_F(MinimizationTest, HopcroftMatchesMoorePasses)
+{
+    std::mt19937 random(7);
+    for (int round = 0; round < 50; ++round)
+    {
+        Automaton dfa;
+        const State stateCount = 2 + random() % 30;
+        dfa.SetStartState(0);
+        for (State state = 0; state < stateCount; ++state)
+        {
+            dfa.AddState(state);
+            if (random() % 3 == 0)
+            {
+                dfa.AddFinalState(state);
+            }
+            for (const Symbol symbol : {'a', 'b', 'c'})
+            {
+                // Часть переходов отсутствует, ДКА частичный
+                if (random() % 4 != 0)
+                {
+                    dfa.AddTransition(state, symbol, random() % stateCount);
+                }
+            }
+        }
+
+        MinimizationStats stats;
+        const auto moore = MinimizationAlgorithm::Minimize(dfa);
+        const auto hopcroft = MinimizationAlgorithm::MinimizeHopcroft(dfa, &stats);
+
+        EXPECT_EQ(hopcroft.GetStates().size(), moore.GetStates().size()) << round;
+        EXPECT_EQ(GetTransitionCount(hopcroft), GetTransitionCount(moore)) << round;
+        EXPECT_EQ(stats.minimizedStates, hopcroft.GetStates().size());
+        EXPECT_TRUE(EquivalenceAlgorithm::AreDfaEquivalent(hopcroft, dfa)) << round;
+    }
+}
+
+// Длинная цепочка: Мур делает n проходов, а обращение цепочки - снова цепочка, выбирается Брзозовский
+TEST_F(MinimizationTest, ChoosesBrzozowskiForLongChain)
+{
+    constexpr State n = 300;
+    automaton.SetStartState(0);
+    for (State state = 0; state < n; ++state)
+    {
+        automaton.AddTransition(state, 'a', state + 1);
+    }
+    automaton.AddFinalState(n);
+
+    EXPECT_EQ(MinimizationAlgorithm::ChooseStrategy(automaton), MinimizationStrategy::BRZOZOWSKI);
+    EXPECT_EQ(MinimizationAlgorithm::MinimizeHopcroft(automaton).GetStates().size(), n + 1);
+}
+
+// Перегрузка для временного автомата и минимизация на месте совпадают с копирующей
+TEST_F(MinimizationTest, MovedAndInPlaceMatchCopy)
+{
+    automaton.SetStartState(0);
+    automaton.AddFinalState(3);
+    automaton.AddFinalState(4);
+    automaton.AddTransition(0, 'a', 1);
+    automaton.AddTransition(0, 'b', 2);
+    automaton.AddTransition(1, 'a', 3);
+    automaton.AddTransition(2, 'a', 4);
+    automaton.AddTransition(5, 'a', 0);
+
+    const Automaton expected = MinimizationAlgorithm::Minimize(automaton);
+    Automaton copy = automaton;
+    const Automaton moved = MinimizationAlgorithm::Minimize(std::move(copy));
+    MinimizationAlgorithm::MinimizeInPlace(automaton);
+    const Automaton& inPlace = automaton;
+
+    EXPECT_EQ(expected.GetStates().size(), 3u);
+    for (const auto* minimized : {&moved, &inPlace})
+    {
+        EXPECT_EQ(minimized->GetStates(), expected.GetStates());
+        EXPECT_EQ(minimized->GetFinalStates(), expected.GetFinalStates());
+        EXPECT_EQ(minimized->GetTransitions(), expected.GetTransitions());
+        EXPECT_EQ(minimized->GetTitle(), expected.GetTitle());
+    }
+
+    // Бесполезный старт с петлей: петля удаляется при любой перегрузке
+    Automaton deadLoop;
+    deadLoop.SetStartState(1);
+    deadLoop.AddTransition(1, 'b', 1);
+    for (const Automaton& dead : {
+             MinimizationAlgorithm::Minimize(deadLoop),
+             MinimizationAlgorithm::Minimize(Automaton(deadLoop)),
+             MinimizationAlgorithm::MinimizeHopcroft(deadLoop),
+             MinimizationAlgorithm::MinimizeHopcroft(Automaton(deadLoop)),
+         })
+    {
+        EXPECT_EQ(dead.GetStates().size(), 1u);
+        EXPECT_TRUE(dead.GetTransitions().empty());
+        EXPECT_TRUE(dead.GetFinalStates().empty());
+    }
+
+    Automaton nfa;
+    nfa.SetStartState(0);
+    nfa.AddTransition(0, 'a', 1);
+    nfa.AddTransition(0, 'a', 2);
+    EXPECT_THROW(MinimizationAlgorithm::MinimizeInPlace(nfa), std::logic_error);
+}
@@ -0,0 +1,51 @@
+#include "Automaton.h"
+#include "DeterminizationAlgorithm.h"
+#include "MinimizationAlgorithm.h"
+#include "SymbolFormat.h"
+
+#include <gtest/gtest.h>
+
+// Любой байт записывается в метку и читается обратно
+TEST(SymbolFormatTest, RoundTripsEveryByte)
+{
+	for (unsigned byte = 0; byte < 256; ++byte)
+	{
+		const auto symbol = static_cast<Symbol>(byte);
+		const auto label = SymbolFormat::ToLabel(symbol);
+
+		EXPECT_EQ(label.find(','), label == "\\," ? 1 : std::string::npos);
+		EXPECT_EQ(SymbolFormat::FromLabel(label), symbol) << label;
+	}
+}
+
+// Пустая метка и "ε" - e-переход, длинная метка - ошибка
+TEST(SymbolFormatTest, ParsesEpsilonAndRejectsLongLabels)
+{
+	EXPECT_FALSE(SymbolFormat::FromLabel("").has_value());
+	EXPECT_FALSE(SymbolFormat::FromLabel("ε").has_value());
+	EXPECT_EQ(SymbolFormat::FromLabel("e"), 'e');
+	EXPECT_EQ(SymbolFormat::FromLabel("\\x00"), 0);
+	EXPECT_THROW(SymbolFormat::FromLabel("ab"), std::invalid_argument);
+	EXPECT_THROW(SymbolFormat::FromLabel("\\xZZ"), std::invalid_argument);
+}
+
+// 'e' и нулевой байт - обычные символы алфавита
+TEST(SymbolFormatTest, LetterEAndZeroByteAreOrdinarySymbols)
+{
+	Automaton nfa;
+	nfa.SetStartState(0);
+	nfa.AddFinalState(2);
+	nfa.AddTransition(0, 'e', 1);
+	nfa.AddTransition(1, '\0', 2);
+	nfa.AddEpsilonTransition(0, 1);
+
+	EXPECT_EQ(nfa.GetAlphabet(), (std::set<Symbol>{'\0', 'e'}));
+	EXPECT_TRUE(nfa.Recognize(std::string("e\0", 2)));
+	EXPECT_TRUE(nfa.Recognize(std::string(1, '\0')));
+	EXPECT_FALSE(nfa.Recognize("e"));
+
+	const auto dfa = DeterminizationAlgorithm::Determine(nfa);
+	EXPECT_TRUE(dfa.IsDeterministic());
+	EXPECT_TRUE(dfa.Recognize(std::string("e\0", 2)));
+	EXPECT_EQ(MinimizationAlgorithm::Minimize(dfa).GetAlphabet().size(), 2);
+}
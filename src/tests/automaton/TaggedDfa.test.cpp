@@ -0,0 +1,112 @@
+#include "DeterminizationAlgorithm.h"
+#include "TaggedAutomaton.h"
+
+#include <gtest/gtest.h>
+
+class TaggedDfaTest : public ::testing::Test
+{
+protected:
+	using Offsets = TaggedDfa::Offsets;
+
+	// Звезда Клини над одним символом: из from по циклу с приоритетом, выход в to
+	static void AddGreedyStar(TaggedNfa& nfa, State from, State body, Symbol symbol, State to)
+	{
+		nfa.AddEpsilonTransition(from, body);
+		nfa.AddEpsilonTransition(from, to);
+		nfa.AddTransition(body, symbol, from);
+	}
+};
+
+// Жадная первая группа забирает весь вход: (a*)(a*)
+TEST_F(TaggedDfaTest, PrefersGreedyFirstGroup)
+{
+	TaggedNfa nfa;
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1, 0);
+	AddGreedyStar(nfa, 1, 2, 'a', 3);
+	nfa.AddEpsilonTransition(3, 4, 1);
+	nfa.AddEpsilonTransition(4, 5, 2);
+	AddGreedyStar(nfa, 5, 6, 'a', 7);
+	nfa.AddEpsilonTransition(7, 8, 3);
+	nfa.AddFinalState(8);
+
+	const TaggedDfa dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_EQ(dfa.GetTagCount(), 4u);
+	EXPECT_EQ(dfa.Match("aaa"), (Offsets{0, 3, 3, 3}));
+	EXPECT_EQ(dfa.Match(""), (Offsets{0, 0, 0, 0}));
+	EXPECT_EQ(dfa.Match("ab"), std::nullopt);
+}
+
+// Выбор альтернативы выясняется только в конце слова: (a|ab)(c|bcd)(d*)
+TEST_F(TaggedDfaTest, ResolvesAlternativesByPriority)
+{
+	TaggedNfa nfa;
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1, 0);
+	nfa.AddEpsilonTransition(1, 2);
+	nfa.AddEpsilonTransition(1, 3);
+	nfa.AddTransition(2, 'a', 5);
+	nfa.AddTransition(3, 'a', 4);
+	nfa.AddTransition(4, 'b', 5);
+	nfa.AddEpsilonTransition(5, 6, 1);
+	nfa.AddEpsilonTransition(6, 7, 2);
+	nfa.AddEpsilonTransition(7, 8);
+	nfa.AddEpsilonTransition(7, 9);
+	nfa.AddTransition(8, 'c', 12);
+	nfa.AddTransition(9, 'b', 10);
+	nfa.AddTransition(10, 'c', 11);
+	nfa.AddTransition(11, 'd', 12);
+	nfa.AddEpsilonTransition(12, 13, 3);
+	nfa.AddEpsilonTransition(13, 14, 4);
+	AddGreedyStar(nfa, 14, 15, 'd', 16);
+	nfa.AddEpsilonTransition(16, 17, 5);
+	nfa.AddFinalState(17);
+
+	const TaggedDfa dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_EQ(dfa.Match("abcd"), (Offsets{0, 1, 1, 4, 4, 4}));
+	EXPECT_EQ(dfa.Match("abc"), (Offsets{0, 2, 2, 3, 3, 3}));
+	EXPECT_EQ(dfa.Match("acdd"), (Offsets{0, 1, 1, 2, 2, 4}));
+	EXPECT_EQ(dfa.Match("abd"), std::nullopt);
+}
+
+// Непройденная необязательная группа не имеет позиций: (a)?b
+TEST_F(TaggedDfaTest, LeavesSkippedGroupUnset)
+{
+	TaggedNfa nfa;
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1, 0);
+	nfa.AddEpsilonTransition(0, 3);
+	nfa.AddTransition(1, 'a', 2);
+	nfa.AddEpsilonTransition(2, 3, 1);
+	nfa.AddTransition(3, 'b', 4);
+	nfa.AddFinalState(4);
+
+	const TaggedDfa dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_EQ(dfa.Match("ab"), (Offsets{0, 1}));
+	EXPECT_EQ(dfa.Match("b"), (Offsets{std::nullopt, std::nullopt}));
+}
+
+// Повторяемая группа сообщает позиции последней итерации: (a|b)*
+TEST_F(TaggedDfaTest, ReportsLastIterationOfRepeatedGroup)
+{
+	TaggedNfa nfa;
+	nfa.SetStartState(0);
+	nfa.AddEpsilonTransition(0, 1, 0);
+	nfa.AddEpsilonTransition(0, 3);
+	nfa.AddTransition(1, 'a', 2);
+	nfa.AddTransition(1, 'b', 2);
+	nfa.AddEpsilonTransition(2, 0, 1);
+	nfa.AddFinalState(3);
+
+	const TaggedDfa dfa = DeterminizationAlgorithm::Determine(nfa);
+
+	EXPECT_EQ(dfa.Match("abba"), (Offsets{3, 4}));
+	EXPECT_EQ(dfa.Match(""), (Offsets{std::nullopt, std::nullopt}));
+	EXPECT_EQ(dfa.Match("abc"), std::nullopt);
+	// Число состояний и регистров не зависит от длины входа
+	EXPECT_LE(dfa.GetStateCount(), 3u);
+	EXPECT_LE(dfa.GetRegisterCount(), 3u);
+}
@@ -0,0 +1,126 @@
+#include "Automaton.h"
+#include "CompiledDfa.h"
+#include "DeterminizationAlgorithm.h"
+#include "TrimAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class TrimTest : public ::testing::Test
+{
+protected:
+	Automaton automaton;
+
+	void SetUp() override
+	{
+		// 0 -a-> 1 -b-> 2 (конечное); 3 недостижимо; 4 и 5 - мертвые
+		automaton.SetStartState(0);
+		automaton.AddFinalState(2);
+		automaton.AddTransition(0, 'a', 1);
+		automaton.AddTransition(1, 'b', 2);
+		automaton.AddTransition(3, 'a', 2);
+		automaton.AddTransition(0, 'b', 4);
+		automaton.AddTransition(4, 'a', 5);
+		automaton.AddTransition(5, 'a', 4);
+	}
+};
+
+// Удаляются недостижимые и мертвые состояния
+TEST_F(TrimTest, RemovesUselessStates)
+{
+	EXPECT_EQ(TrimAlgorithm::FindReachableStates(automaton), (std::set<State>{0, 1, 2, 4, 5}));
+	EXPECT_EQ(TrimAlgorithm::FindCoReachableStates(automaton), (std::set<State>{0, 1, 2, 3}));
+	EXPECT_FALSE(TrimAlgorithm::IsTrim(automaton));
+
+	const auto trimmed = TrimAlgorithm::Trim(automaton);
+	EXPECT_EQ(trimmed.GetStates(), (std::set<State>{0, 1, 2}));
+	EXPECT_TRUE(TrimAlgorithm::IsTrim(trimmed));
+	EXPECT_TRUE(trimmed.Recognize("ab"));
+	EXPECT_FALSE(trimmed.Recognize("ba"));
+
+	const auto useful = TrimAlgorithm::FindUsefulStates(automaton);
+	EXPECT_FALSE(TrimAlgorithm::IsTrim(automaton, useful));
+	EXPECT_EQ(TrimAlgorithm::Trim(automaton, useful).GetStates(), trimmed.GetStates());
+
+	TrimAlgorithm::TrimInPlace(automaton, useful);
+	EXPECT_EQ(automaton.GetStates(), trimmed.GetStates());
+	EXPECT_EQ(automaton.GetFinalStates(), trimmed.GetFinalStates());
+	EXPECT_EQ(automaton.GetTransitions(), trimmed.GetTransitions());
+	EXPECT_EQ(automaton.GetAlphabet(), trimmed.GetAlphabet());
+}
+
+// Пустой язык: остается только стартовое состояние
+TEST_F(TrimTest, KeepsStartStateForEmptyLanguage)
+{
+	Automaton empty;
+	empty.SetStartState(0);
+	empty.AddTransition(0, 'a', 1);
+
+	const auto trimmed = TrimAlgorithm::Trim(empty);
+	EXPECT_EQ(trimmed.GetStates(), (std::set<State>{0}));
+	EXPECT_TRUE(TrimAlgorithm::IsTrim(trimmed));
+
+	TrimAlgorithm::TrimInPlace(empty, TrimAlgorithm::FindUsefulStates(empty));
+	EXPECT_EQ(empty.GetStates(), (std::set<State>{0}));
+	EXPECT_TRUE(empty.GetTransitions().empty());
+	EXPECT_TRUE(empty.GetAlphabet().empty());
+}
+
+// Бесполезный старт с петлей не считается подрезанным: Trim удалит петлю
+TEST_F(TrimTest, DropsLoopOnUselessStart)
+{
+	Automaton deadLoop;
+	deadLoop.SetStartState(1);
+	deadLoop.AddTransition(1, 'b', 1);
+	EXPECT_FALSE(TrimAlgorithm::IsTrim(deadLoop));
+
+	const auto trimmed = TrimAlgorithm::Trim(deadLoop);
+	EXPECT_EQ(trimmed.GetStates(), (std::set<State>{1}));
+	EXPECT_TRUE(trimmed.GetTransitions().empty());
+	EXPECT_TRUE(TrimAlgorithm::IsTrim(trimmed));
+
+	Automaton epsilonLoop;
+	epsilonLoop.SetStartState(0);
+	epsilonLoop.AddEpsilonTransition(0, 0);
+	EXPECT_FALSE(TrimAlgorithm::IsTrim(epsilonLoop));
+}
+
+// e-переходы учитываются в обоих направлениях
+TEST_F(TrimTest, FollowsEpsilonTransitions)
+{
+	Automaton nfa;
+	nfa.SetStartState(0);
+	nfa.AddFinalState(2);
+	nfa.AddEpsilonTransition(0, 1);
+	nfa.AddTransition(1, 'a', 2);
+	nfa.AddEpsilonTransition(1, 3);
+
+	const auto trimmed = TrimAlgorithm::Trim(nfa);
+	EXPECT_EQ(trimmed.GetStates(), (std::set<State>{0, 1, 2}));
+	EXPECT_TRUE(trimmed.Recognize("a"));
+}
+
+// ДКА после детерминизации не содержит мертвых состояний
+TEST_F(TrimTest, DeterminizationProducesNoDeadStates)
+{
+	const auto dfa = DeterminizationAlgorithm::Determine(automaton);
+	EXPECT_EQ(dfa.GetStates().size(), 3);
+	EXPECT_TRUE(TrimAlgorithm::IsTrim(dfa));
+}
+
+// Скомпилированная таблица отмечает мертвые состояния и распознает как исходный ДКА
+TEST_F(TrimTest, CompiledDfaMarksDeadStates)
+{
+	const CompiledDfa compiled(automaton);
+	EXPECT_EQ(compiled.GetStateCount(), 6);
+	EXPECT_EQ(compiled.GetDeadStateCount(), 2);
+
+	const State dead = compiled.Step(compiled.GetStartState(), 'b');
+	EXPECT_TRUE(compiled.IsDead(dead));
+	EXPECT_TRUE(compiled.IsDead(compiled.Step(dead, 'b')));
+	EXPECT_FALSE(compiled.IsDead(compiled.GetStartState()));
+
+	for (const std::string word : {"", "a", "ab", "abb", "ba", "baa", "b"})
+	{
+		EXPECT_EQ(compiled.Recognize(word), automaton.Recognize(word)) << word;
+	}
+}
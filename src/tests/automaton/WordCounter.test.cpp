@@ -0,0 +1,131 @@
+#include "Automaton.h"
+#include "DictionaryBuilder.h"
+#include "WordCounter.h"
+
+#include <gtest/gtest.h>
+
+class WordCounterTest : public ::testing::Test
+{
+protected:
+	// Слова над {a, b}, оканчивающиеся на "ab" (НКА)
+	static Automaton MakeEndsWithAb()
+	{
+		Automaton nfa;
+		nfa.SetStartState(0);
+		nfa.AddFinalState(2);
+		nfa.AddTransition(0, 'a', 0);
+		nfa.AddTransition(0, 'b', 0);
+		nfa.AddTransition(0, 'a', 1);
+		nfa.AddTransition(1, 'b', 2);
+		return nfa;
+	}
+
+	// Все слова над алфавитом длины length в лексикографическом порядке
+	static std::vector<std::string> AllWords(const std::string& alphabet, std::size_t length)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			std::vector<std::string> longer;
+			for (const auto& word : words)
+			{
+				for (const char symbol : alphabet)
+				{
+					longer.push_back(word + symbol);
+				}
+			}
+			words.swap(longer);
+		}
+		return words;
+	}
+};
+
+// Подсчет и перечисление совпадают с перебором через Recognize
+TEST_F(WordCounterTest, MatchesBruteForce)
+{
+	const Automaton nfa = MakeEndsWithAb();
+	const WordCounter counter(nfa);
+	auto enumerator = counter.Enumerate();
+
+	std::size_t upTo = 0;
+	for (std::size_t length = 0; length <= 8; ++length)
+	{
+		std::size_t exact = 0;
+		for (const auto& word : AllWords("ab", length))
+		{
+			if (nfa.Recognize(word))
+			{
+				exact++;
+				EXPECT_EQ(enumerator.Next(), word);
+			}
+		}
+		upTo += exact;
+		EXPECT_EQ(counter.CountWords(length), BigUnsigned(exact));
+		EXPECT_EQ(counter.CountWordsUpTo(length), BigUnsigned(upTo));
+		EXPECT_EQ(counter.CountWords(length, 7), exact % 7);
+		EXPECT_EQ(counter.CountWordsUpTo(length, 7), upTo % 7);
+	}
+	EXPECT_EQ(counter.GetShortestWord(), "ab");
+}
+
+// Длинные слова: точный счет выходит за 64 бита, по модулю считается степенью матрицы
+TEST_F(WordCounterTest, CountsLongWords)
+{
+	// Все слова над {a, b}
+	Automaton dfa;
+	dfa.SetStartState(0);
+	dfa.AddFinalState(0);
+	dfa.AddTransition(0, 'a', 0);
+	dfa.AddTransition(0, 'b', 0);
+	const WordCounter counter(dfa);
+
+	EXPECT_EQ(counter.CountWords(100).ToString(), "1267650600228229401496703205376");
+	EXPECT_EQ(counter.CountWordsUpTo(64).ToString(), "36893488147419103231");
+	EXPECT_EQ(counter.CountWords(1000000000000000000, 1000000007), 719476260u);
+
+	const WordCounter endsWithAb(MakeEndsWithAb());
+	// Слов длины n ровно 2^(n - 2), всего не длиннее n - 2^(n - 1) - 1
+	EXPECT_EQ(endsWithAb.CountWords(1000000, 1000000007), 808760520u);
+	EXPECT_EQ(endsWithAb.CountWordsUpTo(33, 1ull << 32), (1ull << 32) - 1);
+	EXPECT_THROW(endsWithAb.CountWords(3, 0), std::invalid_argument);
+}
+
+// Перечисление конечного языка заканчивается
+TEST_F(WordCounterTest, EnumeratesFiniteLanguage)
+{
+	const WordCounter counter(DictionaryBuilder::FromWords({"cat", "a", "cab", "be", "ab"}));
+	auto enumerator = counter.Enumerate();
+
+	std::vector<std::string> words;
+	while (const auto word = enumerator.Next())
+	{
+		words.push_back(*word);
+	}
+
+	EXPECT_EQ(words, (std::vector<std::string>{"a", "ab", "be", "cab", "cat"}));
+	EXPECT_EQ(counter.CountWordsUpTo(10), BigUnsigned(5));
+	EXPECT_EQ(counter.GetShortestWord(), "a");
+}
+
+// Пустой язык и язык из пустого слова
+TEST_F(WordCounterTest, HandlesDegenerateLanguages)
+{
+	Automaton empty;
+	empty.SetStartState(0);
+	empty.AddTransition(0, 'a', 1);
+	const WordCounter emptyCounter(empty);
+
+	EXPECT_EQ(emptyCounter.GetShortestWord(), std::nullopt);
+	EXPECT_TRUE(emptyCounter.CountWordsUpTo(5).IsZero());
+	EXPECT_EQ(emptyCounter.Enumerate().Next(), std::nullopt);
+
+	Automaton epsilon;
+	epsilon.SetStartState(0);
+	epsilon.AddFinalState(0);
+	const WordCounter epsilonCounter(epsilon);
+	auto enumerator = epsilonCounter.Enumerate();
+
+	EXPECT_EQ(epsilonCounter.GetShortestWord(), "");
+	EXPECT_EQ(enumerator.Next(), "");
+	EXPECT_EQ(enumerator.Next(), std::nullopt);
+}
@@ -0,0 +1,188 @@
+#include "AutomatonSerializer.h"
+#include "CommandLineParser.h"
+#include "CommandRunner.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+
+class CommandLineTest : public ::testing::Test
+{
+protected:
+	std::filesystem::path automatonPath = std::filesystem::temp_directory_path() / "cli_test.bin";
+
+	void SetUp() override
+	{
+		// Слова, оканчивающиеся на "ab"
+		Automaton nfa;
+		nfa.SetStartState(0);
+		nfa.AddFinalState(2);
+		nfa.AddTransition(0, 'a', 0);
+		nfa.AddTransition(0, 'b', 0);
+		nfa.AddTransition(0, 'a', 1);
+		nfa.AddTransition(1, 'b', 2);
+		AutomatonSerializer::ToBinaryFile(nfa, automatonPath.string());
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(automatonPath);
+	}
+
+	std::string Run(std::initializer_list<const char*> args, const std::string& input, std::string* logText = nullptr)
+	{
+		std::vector<const char*> argv = {"compiler-ta"};
+		argv.insert(argv.end(), args.begin(), args.end());
+
+		const auto options = CommandLineParser::Parse(static_cast<int>(argv.size()), argv.data());
+		std::istringstream in(input);
+		std::ostringstream out;
+		std::ostringstream log;
+		CommandRunner(options, in, out, log).Run();
+		if (logText)
+		{
+			*logText = log.str();
+		}
+		return out.str();
+	}
+};
+
+// Разбор команды и опций
+TEST_F(CommandLineTest, ParsesCommandAndOptions)
+{
+	const char* argv[] = {"compiler-ta", "match", "-i", "a.dot", "--threads", "4", "--stats", "-w", "words.txt"};
+	const auto options = CommandLineParser::Parse(9, argv);
+
+	EXPECT_EQ(options.command, Command::MATCH);
+	EXPECT_EQ(options.inputPath, "a.dot");
+	EXPECT_EQ(options.threads, 4);
+	EXPECT_TRUE(options.stats);
+	EXPECT_EQ(options.wordsPath, "words.txt");
+}
+
+// Ошибки в аргументах
+TEST_F(CommandLineTest, RejectsInvalidArguments)
+{
+	const char* unknownCommand[] = {"compiler-ta", "compile"};
+	EXPECT_THROW(CommandLineParser::Parse(2, unknownCommand), std::invalid_argument);
+
+	const char* missingInput[] = {"compiler-ta", "match"};
+	EXPECT_THROW(CommandLineParser::Parse(2, missingInput), std::invalid_argument);
+
+	const char* zeroThreads[] = {"compiler-ta", "match", "-i", "a.dot", "--threads", "0"};
+	EXPECT_THROW(CommandLineParser::Parse(6, zeroThreads), std::invalid_argument);
+
+	const char* wrappingThreads[] = {"compiler-ta", "match", "-i", "a.dot", "--threads", "4294967297"};
+	EXPECT_THROW(CommandLineParser::Parse(6, wrappingThreads), std::invalid_argument);
+
+	const char* binaryToStdout[] = {"compiler-ta", "minimize", "-i", "a.dot", "--format", "binary"};
+	EXPECT_THROW(CommandLineParser::Parse(6, binaryToStdout), std::invalid_argument);
+	// Сообщение называет опцию и значение, а не функцию разбора
+	for (const char* value : {"four", "99999999999999999999999", ""})
+	{
+		const char* notNumber[] = {"compiler-ta", "match", "-i", "a.dot", "--threads", value};
+		try
+		{
+			CommandLineParser::Parse(6, notNumber);
+			ADD_FAILURE() << value;
+		}
+		catch (const std::invalid_argument& error)
+		{
+			EXPECT_NE(std::string(error.what()).find("--threads"), std::string::npos) << error.what();
+		}
+	}
+}
+
+// Распознавание слов из stdin в несколько потоков сохраняет порядок
+TEST_F(CommandLineTest, MatchesWordsInOrder)
+{
+	const auto output = Run({"match", "-i", automatonPath.c_str(), "--threads", "3"}, "ab\nba\naab\nb\nbab\n");
+
+	EXPECT_EQ(output, "[true] \tab\n[false]\tba\n[true] \taab\n[false]\tb\n[true] \tbab\n");
+}
+
+// Поиск выводит строки с вхождением
+TEST_F(CommandLineTest, SearchesLines)
+{
+	const auto output = Run({"search", "-i", automatonPath.c_str()}, "xxabyy\nbbbb\nab\n");
+
+	EXPECT_EQ(output, "1:xxabyy\n3:ab\n");
+}
+
+// Словарь строится из слов на stdin без входного автомата
+TEST_F(CommandLineTest, BuildsDictionary)
+{
+	const auto output = Run({"dictionary", "--unsorted"}, "top\ntap\nstop\n");
+
+	EXPECT_NE(output.find("digraph Dictionary"), std::string::npos);
+	EXPECT_NE(output.find("final = "), std::string::npos);
+}
+
+// Нечеткое совпадение с допустимым числом ошибок
+TEST_F(CommandLineTest, MatchesWithinDistance)
+{
+	const auto output = Run({"match", "-i", automatonPath.c_str(), "--distance", "1"}, "ax\nbb\nxyz\n");
+
+	EXPECT_EQ(output, "[true] \tax\n[true] \tbb\n[false]\txyz\n");
+
+	// 0 - точное совпадение
+	const auto exact = Run({"match", "-i", automatonPath.c_str(), "--distance", "0"}, "ax\nab\n");
+	EXPECT_EQ(exact, "[false]\tax\n[true] \tab\n");
+}
+
+// Счетчики печатаются и для минимизации Бжозовского
+TEST_F(CommandLineTest, PrintsStatsForBrzozowski)
+{
+	for (const char* command : {"minimize", "bench"})
+	{
+		std::string log;
+		Run({command, "-i", automatonPath.c_str(), "--strategy", "brzozowski", "--stats"}, "", &log);
+		EXPECT_NE(log.find("\"refinementIterations\": 2"), std::string::npos) << command << ": " << log;
+	}
+}
+
+// Подсчет слов и перечисление в порядке shortlex
+TEST_F(CommandLineTest, CountsAndEnumeratesWords)
+{
+	const auto counted = Run({"count", "-i", automatonPath.c_str(), "--length", "3"}, "");
+	const auto enumerated = Run({"enumerate", "-i", automatonPath.c_str(), "--limit", "4"}, "");
+
+	EXPECT_EQ(counted, "length 3: 2\nup to 3: 3\nshortest: \"ab\"\n");
+	EXPECT_EQ(enumerated, "ab\naab\nbab\naaab\n");
+}
+
+// Поврежденная длина заголовка не приводит к огромному выделению памяти
+TEST_F(CommandLineTest, RejectsCorruptBinaryTitle)
+{
+	std::ostringstream output;
+	Automaton automaton;
+	automaton.SetTitle("dfa");
+	automaton.SetStartState(0);
+	AutomatonSerializer::WriteBinary(automaton, output);
+
+	auto bytes = output.str();
+	const std::size_t titleLengthOffset = 8;
+	bytes[titleLengthOffset + 3] = '\x7f';
+
+	std::istringstream input(bytes);
+	EXPECT_THROW(AutomatonSerializer::ReadBinary(input), std::invalid_argument);
+}
+
+// Формат бинарного автомата один, другие версии не читаются
+TEST_F(CommandLineTest, RejectsUnknownBinaryVersion)
+{
+	std::ostringstream output;
+	Automaton automaton;
+	automaton.SetStartState(0);
+	automaton.AddEpsilonTransition(0, 1);
+	AutomatonSerializer::WriteBinary(automaton, output);
+
+	std::istringstream valid(output.str());
+	EXPECT_EQ(AutomatonSerializer::ReadBinary(valid).GetEpsilonTransitions(), automaton.GetEpsilonTransitions());
+
+	auto bytes = output.str();
+	const std::size_t versionOffset = 4;
+	bytes[versionOffset] = '\x02';
+	std::istringstream input(bytes);
+	EXPECT_THROW(AutomatonSerializer::ReadBinary(input), std::invalid_argument);
+}
@@ -0,0 +1,162 @@
+#include "AutomatonBuilder.h"
+#include "AutomatonGenerator.h"
+#include "AutomatonSink.h"
+#include "DeterminizationAlgorithm.h"
+#include "MinimizationAlgorithm.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+class GeneratorTest : public ::testing::Test
+{
+protected:
+	RandomAutomatonParams params;
+
+	static size_t GetTransitionCount(const Automaton& automaton)
+	{
+		size_t count = 0;
+		for (const auto& [fromState, transitions] : automaton.GetTransitions())
+		{
+			for (const auto& [symbol, toStates] : transitions)
+			{
+				count += toStates.size();
+			}
+		}
+		return count;
+	}
+};
+
+// Одинаковый seed дает одинаковый автомат
+TEST_F(GeneratorTest, IsReproducibleForSameSeed)
+{
+	params.stateCount = 200;
+	params.alphabetSize = 3;
+	params.epsilonRatio = 0.2;
+	params.seed = 42;
+
+	std::stringstream first;
+	std::stringstream second;
+	{
+		DotStreamSink sink(first, "nfa");
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+	{
+		DotStreamSink sink(second, "nfa");
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+
+	EXPECT_EQ(first.str(), second.str());
+
+	params.seed = 43;
+	std::stringstream third;
+	{
+		DotStreamSink sink(third, "nfa");
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+	EXPECT_NE(first.str(), third.str());
+}
+
+// Случайный ДКА детерминирован, все состояния достижимы
+TEST_F(GeneratorTest, RandomDfaIsDeterministicAndConnected)
+{
+	params.stateCount = 500;
+	params.alphabetSize = 4;
+	params.density = 0.5;
+	params.seed = 7;
+
+	const auto dfa = AutomatonGenerator::RandomDfa(params);
+
+	EXPECT_TRUE(dfa.IsDeterministic());
+	EXPECT_EQ(dfa.GetStates().size(), 500);
+	EXPECT_LE(dfa.GetAlphabet().size(), 4);
+	EXPECT_FALSE(dfa.GetFinalStates().empty());
+}
+
+// Доля e-переходов соблюдается
+TEST_F(GeneratorTest, RandomNfaRespectsEpsilonRatio)
+{
+	params.stateCount = 300;
+	params.density = 2.0;
+	params.epsilonRatio = 0.0;
+
+	const auto nfa = AutomatonGenerator::RandomNfa(params);
+	EXPECT_TRUE(nfa.GetEpsilonTransitions().empty());
+	EXPECT_GE(GetTransitionCount(nfa), 299);
+
+	params.epsilonRatio = 0.5;
+	EXPECT_FALSE(AutomatonGenerator::RandomNfa(params).GetEpsilonTransitions().empty());
+}
+
+// Экспоненциальный рост при детерминизации: 2^n состояний
+TEST_F(GeneratorTest, NthSymbolFromEndBlowsUpOnDeterminization)
+{
+	constexpr unsigned n = 6;
+	const auto nfa = AutomatonGenerator::NthSymbolFromEnd(n);
+
+	EXPECT_EQ(nfa.GetStates().size(), n + 1);
+
+	const auto dfa = DeterminizationAlgorithm::Determine(nfa);
+	EXPECT_EQ(dfa.GetStates().size(), 1u << n);
+	EXPECT_EQ(MinimizationAlgorithm::Minimize(dfa).GetStates().size(), 1u << n);
+}
+
+// Цикл де Брёйна уже минимален
+TEST_F(GeneratorTest, DeBruijnCycleIsMinimal)
+{
+	constexpr unsigned order = 5;
+	const auto dfa = AutomatonGenerator::DeBruijnCycle(order);
+
+	EXPECT_EQ(dfa.GetStates().size(), 1u << order);
+	EXPECT_EQ(dfa.GetFinalStates().size(), 1u << (order - 1));
+	EXPECT_EQ(MinimizationAlgorithm::Minimize(dfa).GetStates().size(), 1u << order);
+}
+
+// Потоковый вывод читается AutomatonBuilder
+TEST_F(GeneratorTest, DotStreamIsReadableByBuilder)
+{
+	params.stateCount = 50;
+	params.epsilonRatio = 0.3;
+	params.seed = 3;
+
+	const auto path = std::filesystem::temp_directory_path() / "generator_test.dot";
+	{
+		std::ofstream file(path);
+		DotStreamSink sink(file, "generated");
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+
+	const auto expected = AutomatonGenerator::RandomNfa(params);
+	const auto actual = AutomatonBuilder::FromFile(path.string());
+	std::filesystem::remove(path);
+
+	EXPECT_EQ(actual.GetStates(), expected.GetStates());
+	EXPECT_EQ(actual.GetFinalStates(), expected.GetFinalStates());
+	EXPECT_EQ(actual.GetTransitions(), expected.GetTransitions());
+	EXPECT_EQ(actual.GetEpsilonTransitions(), expected.GetEpsilonTransitions());
+}
+
+// Полный байтовый алфавит проходит через .dot без потерь
+TEST_F(GeneratorTest, FullByteAlphabetRoundTripsThroughDot)
+{
+	params.stateCount = 64;
+	params.alphabetSize = AutomatonGenerator::MaxAlphabetSize();
+	params.density = 4.0;
+	params.seed = 11;
+
+	const auto path = std::filesystem::temp_directory_path() / "generator_bytes_test.dot";
+	{
+		std::ofstream file(path);
+		DotStreamSink sink(file, "bytes");
+		AutomatonGenerator::RandomNfa(params, sink);
+	}
+
+	const auto expected = AutomatonGenerator::RandomNfa(params);
+	const auto actual = AutomatonBuilder::FromFile(path.string());
+	std::filesystem::remove(path);
+
+	EXPECT_GT(expected.GetAlphabet().size(), 200);
+	EXPECT_EQ(actual.GetAlphabet(), expected.GetAlphabet());
+	EXPECT_EQ(actual.GetTransitions(), expected.GetTransitions());
+}
@@ -0,0 +1,135 @@
+#include "CykParser.h"
+#include "EarleyParser.h"
+#include "GrammarBuilder.h"
+#include "GrammarConverter.h"
+#include "NormalFormAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class CykTest : public ::testing::Test
+{
+protected:
+	// Все слова над алфавитом не длиннее maxLength
+	static std::vector<std::string> AllWords(const std::string& alphabet, std::size_t maxLength)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t i = 0; words[i].size() < maxLength; ++i)
+		{
+			for (const char symbol : alphabet)
+			{
+				words.push_back(words[i] + symbol);
+			}
+		}
+		return words;
+	}
+
+	static bool IsBalanced(const std::string& word)
+	{
+		int depth = 0;
+		for (const char symbol : word)
+		{
+			depth += symbol == '(' ? 1 : -1;
+			if (depth < 0)
+			{
+				return false;
+			}
+		}
+		return depth == 0;
+	}
+};
+
+// Нормальная форма Хомского сохраняет пустое слово только у нового стартового символа
+TEST_F(CykTest, ConvertsToChomskyNormalForm)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> a S b | A\nA -> ε | c A\nB -> d\n");
+	ASSERT_FALSE(NormalFormAlgorithm::IsChomskyNormalForm(grammar));
+
+	const Grammar normalForm = NormalFormAlgorithm::ToChomskyNormalForm(grammar);
+
+	EXPECT_TRUE(NormalFormAlgorithm::IsChomskyNormalForm(normalForm));
+	EXPECT_EQ(normalForm.GetStartSymbol(), "S'");
+	// Недостижимый B удален
+	EXPECT_FALSE(normalForm.GetNonTerminals().contains("B"));
+	EXPECT_THROW(NormalFormAlgorithm::ToChomskyNormalForm(GrammarBuilder::FromString("S -> a\na S -> b\n")),
+		std::invalid_argument);
+}
+
+// Язык a^n b^n
+TEST_F(CykTest, RecognizesContextFreeLanguage)
+{
+	const CykParser parser(GrammarBuilder::FromString("S -> a S b | ε\n"));
+
+	EXPECT_TRUE(parser.Recognize(""));
+	EXPECT_TRUE(parser.Recognize("ab"));
+	EXPECT_TRUE(parser.Recognize("aaabbb"));
+	EXPECT_FALSE(parser.Recognize("aabbb"));
+	EXPECT_FALSE(parser.Recognize("abab"));
+	EXPECT_FALSE(parser.Recognize("abc"));
+}
+
+// Неоднозначная грамматика скобок совпадает с проверкой стеком, в том числе в несколько потоков
+TEST_F(CykTest, MatchesBalancedParentheses)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> S S | ( S ) | ε\n");
+	const CykParser parser(grammar);
+	const CykParser parallelParser(grammar, 3);
+
+	for (const auto& word : AllWords("()", 10))
+	{
+		EXPECT_EQ(parser.Recognize(word), IsBalanced(word)) << word;
+		EXPECT_EQ(parallelParser.Recognize(word), IsBalanced(word)) << word;
+	}
+
+	std::string nested = std::string(300, '(') + std::string(300, ')');
+	std::string longWord;
+	for (int i = 0; i < 2; ++i)
+	{
+		longWord += nested + "()()";
+	}
+	EXPECT_TRUE(parallelParser.Recognize(longWord));
+	EXPECT_FALSE(parallelParser.Recognize(longWord + "("));
+}
+
+// Регулярная грамматика распознается так же, как ее автомат
+TEST_F(CykTest, AgreesWithAutomatonOnRegularGrammar)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> a S | b A | ε\nA -> b A | a S | b\n");
+	const CykParser parser(grammar);
+	const Automaton nfa = GrammarConverter::ToAutomaton(grammar);
+
+	for (const auto& word : AllWords("ab", 8))
+	{
+		EXPECT_EQ(parser.Recognize(word), nfa.Recognize(word)) << word;
+	}
+}
+
+// Многосимвольные терминалы
+TEST_F(CykTest, RecognizesTokens)
+{
+	const CykParser parser(GrammarBuilder::FromString(R"(
+		E -> E + T | T
+		T -> T * F | F
+		F -> ( E ) | id
+	)"));
+	const std::vector<std::string_view> expression = {"id", "+", "id", "*", "(", "id", "+", "id", ")"};
+	const std::vector<std::string_view> broken = {"id", "+", "*", "id"};
+
+	EXPECT_TRUE(parser.Recognize(std::span<const std::string_view>(expression)));
+	EXPECT_FALSE(parser.Recognize(std::span<const std::string_view>(broken)));
+}
+
+// Правила разных нетерминалов с одной парой детей проверяются один раз и помечают все левые части
+TEST_F(CykTest, AgreesWithEarleyOnSharedRulePairs)
+{
+	const auto grammar = GrammarBuilder::FromString(R"(
+		S -> S S | a S b | A
+		A -> S S | b A | b
+	)");
+	const CykParser cyk(grammar);
+	const EarleyParser earley(grammar);
+
+	for (const auto& word : AllWords("ab", 8))
+	{
+		EXPECT_EQ(cyk.Recognize(word), earley.Recognize(word)) << word;
+	}
+}
@@ -0,0 +1,159 @@
+#include "CykParser.h"
+#include "EarleyParser.h"
+#include "GrammarBuilder.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+class EarleyTest : public ::testing::Test
+{
+protected:
+	// Все слова над алфавитом не длиннее maxLength
+	static std::vector<std::string> AllWords(const std::string& alphabet, std::size_t maxLength)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t i = 0; words[i].size() < maxLength; ++i)
+		{
+			for (const char symbol : alphabet)
+			{
+				words.push_back(words[i] + symbol);
+			}
+		}
+		return words;
+	}
+
+	// Единственное дерево леса в скобочной записи: X(дети), терминал - своим именем
+	static std::string TreeToString(const Grammar& grammar, const ParseForest& forest, ParseForest::NodeId node)
+	{
+		const auto& current = forest.GetNode(node);
+		std::string children;
+		for (const auto child : CollectChildren(forest, node))
+		{
+			children += (children.empty() ? "" : " ") + TreeToString(grammar, forest, child);
+		}
+		const std::string& name = grammar.GetSymbolTable().GetName(current.symbol);
+		return grammar.IsTerminal(current.symbol) ? name : name + "(" + children + ")";
+	}
+
+	// Промежуточные узлы раскрываются в последовательность детей правила
+	static std::vector<ParseForest::NodeId> CollectChildren(const ParseForest& forest, ParseForest::NodeId node)
+	{
+		const auto packed = forest.GetPacked(node);
+		if (packed.empty())
+		{
+			return {};
+		}
+		EXPECT_EQ(packed.size(), 1u);
+		std::vector<ParseForest::NodeId> children;
+		if (packed[0].left != ParseForest::NO_NODE)
+		{
+			if (forest.GetNode(packed[0].left).symbol == NO_SYMBOL)
+			{
+				children = CollectChildren(forest, packed[0].left);
+			}
+			else
+			{
+				children.push_back(packed[0].left);
+			}
+		}
+		if (packed[0].right != ParseForest::NO_NODE)
+		{
+			children.push_back(packed[0].right);
+		}
+		return children;
+	}
+};
+
+// На неоднозначных, леворекурсивных и циклических грамматиках ответы совпадают с CYK
+TEST_F(EarleyTest, AgreesWithCyk)
+{
+	const std::vector<std::string> grammars = {
+		"S -> S S | ( S ) | ε\n",
+		"S -> a S b | A\nA -> ε | c A\n",
+		"S -> A | S a\nA -> B | b\nB -> A | c\n",
+		"S -> a S | S b | A\nA -> B B\nB -> ε | a\n",
+	};
+	for (const auto& text : grammars)
+	{
+		const Grammar grammar = GrammarBuilder::FromString(text);
+		const EarleyParser earley(grammar);
+		const CykParser cyk(grammar);
+		for (const auto& word : AllWords("()abc", 5))
+		{
+			EXPECT_EQ(earley.Recognize(word), cyk.Recognize(word)) << text << word;
+			EXPECT_EQ(earley.Parse(word).has_value(), cyk.Recognize(word)) << text << word;
+		}
+	}
+	EXPECT_THROW(EarleyParser(GrammarBuilder::FromString("S -> a\na S -> b\n")), std::invalid_argument);
+}
+
+// Лес однозначной грамматики - одно дерево, в том числе с пустыми правилами
+TEST_F(EarleyTest, BuildsParseTree)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> a S b | ε\n");
+	const auto forest = EarleyParser(grammar).Parse("aabb");
+
+	ASSERT_TRUE(forest.has_value());
+	EXPECT_FALSE(forest->IsAmbiguous());
+	EXPECT_EQ(forest->CountTrees(), 1u);
+	EXPECT_EQ(TreeToString(grammar, *forest, forest->GetRoot()), "S(a S(a S() b) b)");
+
+	const Grammar expression = GrammarBuilder::FromString(R"(
+		E -> E + T | T
+		T -> T * F | F
+		F -> ( E ) | id
+	)");
+	const std::vector<std::string_view> tokens = {"id", "+", "id", "*", "id"};
+	const auto tree = EarleyParser(expression).Parse(std::span<const std::string_view>(tokens));
+
+	ASSERT_TRUE(tree.has_value());
+	EXPECT_EQ(TreeToString(expression, *tree, tree->GetRoot()), "E(E(T(F(id))) + T(T(F(id)) * F(id)))");
+}
+
+// Неоднозначные разборы разделяют общие поддеревья: число деревьев a+a+...+a - числа Каталана
+TEST_F(EarleyTest, SharesAmbiguousDerivations)
+{
+	const EarleyParser parser(GrammarBuilder::FromString("E -> E + E | a\n"));
+
+	const auto three = parser.Parse("a+a+a");
+	ASSERT_TRUE(three.has_value());
+	EXPECT_TRUE(three->IsAmbiguous());
+	EXPECT_EQ(three->CountTrees(), 2u);
+
+	std::string word = "a";
+	for (int i = 0; i < 10; ++i)
+	{
+		word += "+a";
+	}
+	const auto eleven = parser.Parse(word);
+	ASSERT_TRUE(eleven.has_value());
+	EXPECT_EQ(eleven->CountTrees(), 16796u);
+	// Лес кубический, а не экспоненциальный
+	EXPECT_LT(eleven->GetPackedCount(), 1000u);
+
+	// S -> S S с пустым S дает бесконечно много деревьев
+	const auto cyclic = EarleyParser(GrammarBuilder::FromString("S -> S S | ( S ) | ε\n")).Parse("()");
+	ASSERT_TRUE(cyclic.has_value());
+	EXPECT_EQ(cyclic->CountTrees(), std::numeric_limits<std::uint64_t>::max());
+}
+
+// Длинная правая рекурсия: пункты Leo не копят завершения, а лес восстанавливает пропущенные узлы
+TEST_F(EarleyTest, ParsesLongRightRecursion)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> a S | A\nA -> b A | b\n");
+	const EarleyParser parser(grammar);
+	const std::string word = std::string(50000, 'a') + std::string(50000, 'b');
+
+	EXPECT_TRUE(parser.Recognize(word));
+	EXPECT_FALSE(parser.Recognize(word + "a"));
+
+	const auto forest = parser.Parse(word);
+	ASSERT_TRUE(forest.has_value());
+	EXPECT_EQ(forest->CountTrees(), 1u);
+	// Узел нетерминала и узел терминала на каждую позицию плюс корень
+	EXPECT_EQ(forest->GetNodeCount(), 2 * word.size() + 1);
+	const auto& root = forest->GetNode(forest->GetRoot());
+	EXPECT_EQ(root.begin, 0u);
+	EXPECT_EQ(root.end, word.size());
+}
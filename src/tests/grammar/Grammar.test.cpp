@@ -0,0 +1,163 @@
+#include "Grammar.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+class GrammarTest : public ::testing::Test
+{
+protected:
+	Grammar grammar;
+
+	void SetUp() override
+	{
+		grammar.AddTerminal("a");
+		grammar.AddTerminal("b");
+		grammar.AddTerminal("id");
+		grammar.AddNonTerminal("S");
+		grammar.AddNonTerminal("A");
+		grammar.SetStartSymbol("S");
+	}
+
+	std::vector<std::string> Names(std::span<const SymbolId> symbols) const
+	{
+		std::vector<std::string> names;
+		for (const SymbolId id : symbols)
+		{
+			names.push_back(grammar.GetSymbolTable().GetName(id));
+		}
+		return names;
+	}
+};
+
+// Каждое имя получает один плотный номер
+TEST_F(GrammarTest, InternsSymbols)
+{
+	const auto& table = grammar.GetSymbolTable();
+
+	EXPECT_EQ(table.GetSize(), 5u);
+	EXPECT_EQ(table.Find("id"), 2u);
+	EXPECT_EQ(table.Find("x"), std::nullopt);
+	EXPECT_EQ(table.GetName(3), "S");
+	EXPECT_EQ(grammar.GetStartSymbolId(), 3u);
+	EXPECT_TRUE(grammar.IsTerminal(2));
+	EXPECT_FALSE(grammar.IsTerminal(3));
+	EXPECT_TRUE(grammar.IsNonTerminal(4));
+	EXPECT_THROW(table.GetName(5), std::out_of_range);
+}
+
+// Правила хранятся промежутками номеров, имена разбираются по наибольшему совпадению
+TEST_F(GrammarTest, StoresRulesAsSymbolSpans)
+{
+	grammar.AddProduction({"S", "idA"});
+	grammar.AddProduction({"A", ""});
+	grammar.AddProduction({"A", "aSb"});
+
+	ASSERT_EQ(grammar.GetRuleCount(), 3u);
+	EXPECT_EQ(Names(grammar.GetRuleLeft(0)), (std::vector<std::string>{"S"}));
+	EXPECT_EQ(Names(grammar.GetRuleRight(0)), (std::vector<std::string>{"id", "A"}));
+	EXPECT_TRUE(grammar.GetRuleRight(1).empty());
+	EXPECT_EQ(Names(grammar.GetRuleRight(2)), (std::vector<std::string>{"a", "S", "b"}));
+	EXPECT_EQ(grammar.GetProductions().size(), 3u);
+}
+
+// Строковый вид правил и тип достраиваются один раз, даже если их запрашивают несколько потоков
+TEST_F(GrammarTest, BuildsProductionsOnceForConcurrentReaders)
+{
+	for (int i = 0; i < 500; ++i)
+	{
+		grammar.AddProduction({"S", "aSb"});
+		grammar.AddProduction({"A", "id"});
+	}
+
+	const Grammar& shared = grammar;
+	std::vector<std::size_t> sizes(4);
+	std::vector<ChomskyType> types(4);
+	std::vector<std::thread> readers;
+	for (std::size_t i = 0; i < sizes.size(); ++i)
+	{
+		readers.emplace_back([&shared, &sizes, &types, i] {
+			sizes[i] = shared.GetProductions().size();
+			types[i] = shared.GetType();
+		});
+	}
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	EXPECT_EQ(sizes, std::vector<std::size_t>(4, 1000));
+	EXPECT_EQ(types, std::vector<ChomskyType>(4, ChomskyType::CONTEXT_FREE));
+	const Grammar copy = grammar;
+	EXPECT_EQ(copy.GetProductions().back().m_right, "id");
+}
+
+// Проверка регулярности по номерам символов
+TEST_F(GrammarTest, DetectsRegularGrammar)
+{
+	grammar.AddProduction({"S", "aA"});
+	grammar.AddProduction({"A", "idS"});
+	grammar.AddProduction({"A", "b"});
+	EXPECT_TRUE(grammar.IsRegular());
+
+	grammar.AddProduction({"S", "Ab"});
+	EXPECT_FALSE(grammar.IsRegular());
+}
+
+// Тип определяется по правилам и пересчитывается после каждого изменения
+TEST_F(GrammarTest, ClassifiesChomskyType)
+{
+	EXPECT_EQ(grammar.GetType(), ChomskyType::REGULAR);
+
+	grammar.AddProduction({"S", "abA"});
+	grammar.AddProduction({"A", "S"});
+	grammar.AddProduction({"A", ""});
+	EXPECT_EQ(grammar.GetType(), ChomskyType::REGULAR);
+	EXPECT_TRUE(grammar.IsRegular());
+
+	grammar.AddProduction({"S", "aSb"});
+	EXPECT_EQ(grammar.GetType(), ChomskyType::CONTEXT_FREE);
+
+	grammar.SetType(ChomskyType::TURING);
+	EXPECT_EQ(grammar.GetType(), ChomskyType::TURING);
+	EXPECT_EQ(grammar.Classify().type, ChomskyType::CONTEXT_FREE);
+
+	// a^n b^n c^n: правила не сокращают строку
+	Grammar sensitive;
+	for (const auto* terminal : {"a", "b", "c"})
+	{
+		sensitive.AddTerminal(terminal);
+	}
+	sensitive.AddNonTerminal("S");
+	sensitive.AddNonTerminal("B");
+	sensitive.SetStartSymbol("S");
+	sensitive.AddProductionFromString("S -> a S B c | a b c");
+	sensitive.AddProductionFromString("c B -> B c");
+	sensitive.AddProductionFromString("b B -> b b");
+	EXPECT_EQ(sensitive.GetType(), ChomskyType::CONTEXT_DEPENDED);
+
+	sensitive.AddProductionFromString("B c -> c");
+	EXPECT_EQ(sensitive.GetType(), ChomskyType::TURING);
+}
+
+// Повторы, двусторонняя рекурсия и циклы цепных правил отмечаются с номерами правил
+TEST_F(GrammarTest, FindsAmbiguityPatterns)
+{
+	grammar.AddProduction({"S", "SaS"});
+	grammar.AddProduction({"S", "A"});
+	grammar.AddProduction({"A", "b"});
+	EXPECT_EQ(grammar.Classify().ambiguityHints.size(), 1u);
+
+	grammar.AddProduction({"A", "S"});
+	grammar.AddProduction({"A", "b"});
+	const auto& hints = grammar.Classify().ambiguityHints;
+
+	ASSERT_EQ(hints.size(), 4u);
+	EXPECT_EQ(hints[0].pattern, AmbiguityPattern::LEFT_AND_RIGHT_RECURSION);
+	EXPECT_EQ(hints[0].rule, 0u);
+	EXPECT_EQ(hints[1].pattern, AmbiguityPattern::UNIT_CYCLE);
+	EXPECT_EQ(hints[1].rule, 1u);
+	EXPECT_EQ(hints[2].pattern, AmbiguityPattern::UNIT_CYCLE);
+	EXPECT_EQ(hints[2].rule, 3u);
+	EXPECT_EQ(hints[3].pattern, AmbiguityPattern::DUPLICATE_RULE);
+	EXPECT_EQ(hints[3].rule, 4u);
+}
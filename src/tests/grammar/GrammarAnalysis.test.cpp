@@ -0,0 +1,74 @@
+#include "GrammarAnalysis.h"
+#include "GrammarBuilder.h"
+
+#include <gtest/gtest.h>
+
+class GrammarAnalysisTest : public ::testing::Test
+{
+protected:
+	static Grammar MakeExpressionGrammar()
+	{
+		return GrammarBuilder::FromString(R"(
+			E -> T X
+			X -> + T X | ε
+			T -> F Y
+			Y -> * F Y | ε
+			F -> ( E ) | id
+		)");
+	}
+
+	static std::set<std::string> ToNames(const Grammar& grammar, const GrammarAnalysis& analysis, const TerminalSet& set)
+	{
+		std::set<std::string> names;
+		for (const auto index : set.ToIndices())
+		{
+			const SymbolId terminal = analysis.GetTerminal(index);
+			names.insert(terminal == NO_SYMBOL ? "$" : grammar.GetSymbolTable().GetName(terminal));
+		}
+		return names;
+	}
+
+	static SymbolId Id(const Grammar& grammar, std::string_view name)
+	{
+		return *grammar.GetSymbolTable().Find(name);
+	}
+};
+
+// Классический пример: FIRST и FOLLOW грамматики выражений без левой рекурсии
+TEST_F(GrammarAnalysisTest, ComputesFirstAndFollow)
+{
+	const Grammar grammar = MakeExpressionGrammar();
+	const GrammarAnalysis analysis(grammar);
+	auto first = [&](std::string_view name) { return ToNames(grammar, analysis, analysis.GetFirst(Id(grammar, name))); };
+	auto follow = [&](std::string_view name) { return ToNames(grammar, analysis, analysis.GetFollow(Id(grammar, name))); };
+
+	EXPECT_TRUE(analysis.IsNullable(Id(grammar, "X")));
+	EXPECT_TRUE(analysis.IsNullable(Id(grammar, "Y")));
+	EXPECT_FALSE(analysis.IsNullable(Id(grammar, "E")));
+	EXPECT_EQ(first("E"), (std::set<std::string>{"(", "id"}));
+	EXPECT_EQ(first("X"), (std::set<std::string>{"+"}));
+	EXPECT_EQ(first("+"), (std::set<std::string>{"+"}));
+	EXPECT_EQ(follow("E"), (std::set<std::string>{")", "$"}));
+	EXPECT_EQ(follow("X"), (std::set<std::string>{")", "$"}));
+	EXPECT_EQ(follow("T"), (std::set<std::string>{"+", ")", "$"}));
+	EXPECT_EQ(follow("F"), (std::set<std::string>{"*", "+", ")", "$"}));
+	EXPECT_THROW(analysis.GetFollow(Id(grammar, "id")), std::invalid_argument);
+}
+
+// Обнуляемость и FIRST распространяются через цепочки обнуляемых символов и циклы
+TEST_F(GrammarAnalysisTest, PropagatesThroughNullableChains)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> A B c\nA -> B | a\nB -> A | ε | b\n");
+	const GrammarAnalysis analysis(grammar);
+
+	EXPECT_TRUE(analysis.IsNullable(Id(grammar, "A")));
+	EXPECT_TRUE(analysis.IsNullable(Id(grammar, "B")));
+	EXPECT_FALSE(analysis.IsNullable(Id(grammar, "S")));
+	EXPECT_EQ(ToNames(grammar, analysis, analysis.GetFirst(Id(grammar, "S"))), (std::set<std::string>{"a", "b", "c"}));
+	EXPECT_EQ(ToNames(grammar, analysis, analysis.GetFollow(Id(grammar, "A"))), (std::set<std::string>{"a", "b", "c"}));
+
+	TerminalSet first(analysis.GetTerminalCount());
+	const std::vector<SymbolId> symbols = {Id(grammar, "A"), Id(grammar, "B")};
+	EXPECT_TRUE(analysis.AddFirst(symbols, first));
+	EXPECT_EQ(ToNames(grammar, analysis, first), (std::set<std::string>{"a", "b"}));
+}
@@ -0,0 +1,100 @@
+#include "GrammarBuilder.h"
+
+#include <gtest/gtest.h>
+
+class GrammarBuilderTest : public ::testing::Test
+{
+protected:
+	static std::vector<std::string> Names(const Grammar& grammar, std::span<const SymbolId> symbols)
+	{
+		std::vector<std::string> names;
+		for (const SymbolId id : symbols)
+		{
+			names.push_back(grammar.GetSymbolTable().GetName(id));
+		}
+		return names;
+	}
+};
+
+// Альтернативы, многосимвольные символы и ε-правила; нетерминалы выводятся из левых частей
+TEST_F(GrammarBuilderTest, LoadsGrammarText)
+{
+	const Grammar grammar = GrammarBuilder::FromString(R"(
+		# Арифметические выражения
+		%name Expr
+		Expr -> Expr + Term | Term
+		Term -> Term * Factor | Factor
+		Factor -> ( Expr ) | id
+		Rest → ε |
+	)");
+
+	EXPECT_EQ(grammar.GetName(), "Expr");
+	EXPECT_EQ(grammar.GetStartSymbol(), "Expr");
+	EXPECT_EQ(grammar.GetNonTerminals(), (std::set<std::string>{"Expr", "Term", "Factor", "Rest"}));
+	EXPECT_EQ(grammar.GetTerminals(), (std::set<std::string>{"+", "*", "(", ")", "id"}));
+	ASSERT_EQ(grammar.GetRuleCount(), 8u);
+	EXPECT_EQ(Names(grammar, grammar.GetRuleRight(0)), (std::vector<std::string>{"Expr", "+", "Term"}));
+	EXPECT_EQ(Names(grammar, grammar.GetRuleRight(5)), (std::vector<std::string>{"id"}));
+	EXPECT_TRUE(grammar.GetRuleRight(6).empty());
+	EXPECT_TRUE(grammar.GetRuleRight(7).empty());
+}
+
+// С директивой %terminals незнакомые символы - ошибка с номером строки
+TEST_F(GrammarBuilderTest, ValidatesDeclaredSymbols)
+{
+	const Grammar grammar = GrammarBuilder::FromString("%terminals a b\n%start S\nS -> a S b | eps\n");
+	EXPECT_EQ(grammar.GetStartSymbol(), "S");
+	EXPECT_EQ(grammar.GetRuleCount(), 2u);
+
+	try
+	{
+		GrammarBuilder::FromString("%terminals a b\nS -> a S b\n\nS -> c\n");
+		FAIL() << "Unknown symbol was accepted";
+	}
+	catch (const std::invalid_argument& error)
+	{
+		EXPECT_EQ(std::string(error.what()), "Line 4: Unknown symbol 'c'");
+	}
+	EXPECT_THROW(GrammarBuilder::FromString("S a b\n"), std::invalid_argument);
+	EXPECT_THROW(GrammarBuilder::FromString("%unknown x\nS -> a\n"), std::invalid_argument);
+	EXPECT_THROW(GrammarBuilder::FromString("%start T\nS -> a\n"), std::invalid_argument);
+}
+
+// Разбор строки правила в уже объявленной грамматике
+TEST_F(GrammarBuilderTest, AddsProductionFromString)
+{
+	Grammar grammar;
+	grammar.AddTerminal("a");
+	grammar.AddTerminal("num");
+	grammar.AddNonTerminal("S");
+	grammar.AddNonTerminal("A");
+	grammar.SetStartSymbol("S");
+
+	grammar.AddProductionFromString("S -> num A | aA | ε");
+
+	ASSERT_EQ(grammar.GetRuleCount(), 3u);
+	EXPECT_EQ(Names(grammar, grammar.GetRuleRight(0)), (std::vector<std::string>{"num", "A"}));
+	EXPECT_EQ(Names(grammar, grammar.GetRuleRight(1)), (std::vector<std::string>{"a", "A"}));
+	EXPECT_TRUE(grammar.GetRuleRight(2).empty());
+	EXPECT_EQ(grammar.GetProductions()[0].m_right, "numA");
+	EXPECT_THROW(grammar.AddProductionFromString("S -> b"), std::invalid_argument);
+	EXPECT_THROW(grammar.AddProductionFromString("a -> A"), std::invalid_argument);
+}
+
+// Большая грамматика загружается целиком
+TEST_F(GrammarBuilderTest, LoadsManyRules)
+{
+	constexpr std::size_t RULE_COUNT = 5000;
+	std::string text;
+	for (std::size_t i = 0; i < RULE_COUNT; ++i)
+	{
+		text += "N" + std::to_string(i) + " -> t" + std::to_string(i) + " N" + std::to_string((i + 1) % RULE_COUNT) + " | ε\n";
+	}
+
+	const Grammar grammar = GrammarBuilder::FromString(text);
+
+	EXPECT_EQ(grammar.GetRuleCount(), 2 * RULE_COUNT);
+	EXPECT_EQ(grammar.GetNonTerminals().size(), RULE_COUNT);
+	EXPECT_EQ(grammar.GetTerminals().size(), RULE_COUNT);
+	EXPECT_TRUE(grammar.IsRegular());
+}
@@ -0,0 +1,94 @@
+#include "DeterminizationAlgorithm.h"
+#include "EquivalenceAlgorithm.h"
+#include "GrammarConverter.h"
+#include "MinimizationAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class GrammarConverterTest : public ::testing::Test
+{
+protected:
+	static Grammar MakeGrammar(const std::string& terminals, const std::string& nonTerminals,
+		const std::vector<Production>& productions)
+	{
+		Grammar grammar;
+		for (const char terminal : terminals)
+		{
+			grammar.AddTerminal(SymbolString(1, terminal));
+		}
+		for (const char nonTerminal : nonTerminals)
+		{
+			grammar.AddNonTerminal(SymbolString(1, nonTerminal));
+		}
+		grammar.SetStartSymbol(SymbolString(1, nonTerminals.front()));
+		for (const auto& production : productions)
+		{
+			grammar.AddProduction(production);
+		}
+		return grammar;
+	}
+};
+
+// Праволинейная грамматика слов вида (ab)*c
+TEST_F(GrammarConverterTest, ConvertsRightLinearGrammar)
+{
+	const Grammar grammar = MakeGrammar("abc", "SA", {{"S", "aA"}, {"A", "bS"}, {"S", "c"}});
+	ASSERT_TRUE(grammar.IsRegular());
+
+	const Automaton nfa = GrammarConverter::ToAutomaton(grammar);
+
+	EXPECT_TRUE(nfa.Recognize("c"));
+	EXPECT_TRUE(nfa.Recognize("ababc"));
+	EXPECT_FALSE(nfa.Recognize("abab"));
+	EXPECT_FALSE(nfa.Recognize("ac"));
+}
+
+// Леволинейная грамматика того же языка и цепочки терминалов в правилах
+TEST_F(GrammarConverterTest, ConvertsLeftLinearGrammar)
+{
+	const Grammar leftLinear = MakeGrammar("abc", "SA", {{"S", "Ac"}, {"A", "Aab"}, {"A", ""}});
+	const Grammar rightLinear = MakeGrammar("abc", "S", {{"S", "abS"}, {"S", "c"}});
+
+	const Automaton left = GrammarConverter::ToAutomaton(leftLinear);
+	const Automaton right = GrammarConverter::ToAutomaton(rightLinear);
+
+	EXPECT_TRUE(left.Recognize("abc"));
+	EXPECT_FALSE(left.Recognize("bac"));
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(left, right));
+}
+
+// Автомат -> грамматика -> автомат сохраняет язык
+TEST_F(GrammarConverterTest, RoundTripsAutomaton)
+{
+	// Слова над {a, b} с четным числом a, включая пустое
+	Automaton dfa;
+	dfa.SetTitle("EvenA");
+	dfa.SetStartState(0);
+	dfa.AddFinalState(0);
+	dfa.AddTransition(0, 'a', 1);
+	dfa.AddTransition(0, 'b', 0);
+	dfa.AddTransition(1, 'a', 0);
+	dfa.AddTransition(1, 'b', 1);
+
+	const Grammar grammar = GrammarConverter::ToRightLinearGrammar(dfa);
+
+	EXPECT_TRUE(grammar.IsRegular());
+	EXPECT_EQ(grammar.GetStartSymbol(), "S");
+	EXPECT_EQ(grammar.GetProductions().size(), 5u);
+
+	const Automaton restored = GrammarConverter::ToAutomaton(grammar);
+	EXPECT_TRUE(EquivalenceAlgorithm::AreEquivalent(dfa, restored));
+	EXPECT_EQ(MinimizationAlgorithm::Minimize(DeterminizationAlgorithm::Determine(restored)).GetStates().size(), 2u);
+}
+
+// Грамматики, не являющиеся линейными
+TEST_F(GrammarConverterTest, RejectsNonLinearGrammar)
+{
+	const Grammar mixed = MakeGrammar("ab", "SA", {{"S", "aA"}, {"A", "Sb"}});
+	const Grammar twoNonTerminals = MakeGrammar("ab", "SA", {{"S", "AA"}, {"A", "a"}});
+
+	EXPECT_THROW(GrammarConverter::ToAutomaton(mixed), std::invalid_argument);
+	EXPECT_THROW(GrammarConverter::ToAutomaton(twoNonTerminals), std::invalid_argument);
+	// Незнакомый символ отвергается уже при добавлении правила
+	EXPECT_THROW(MakeGrammar("ab", "S", {{"S", "aX"}}), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+#include "EarleyParser.h"
+#include "GrammarBuilder.h"
+#include "NormalFormAlgorithm.h"
+#include "ParseTableAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+
+class NormalFormTest : public ::testing::Test
+{
+protected:
+	// Все слова над алфавитом не длиннее maxLength
+	static std::vector<std::string> AllWords(const std::string& alphabet, std::size_t maxLength)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t i = 0; words[i].size() < maxLength; ++i)
+		{
+			for (const char symbol : alphabet)
+			{
+				words.push_back(words[i] + symbol);
+			}
+		}
+		return words;
+	}
+
+	static void ExpectSameLanguage(const Grammar& expected, const Grammar& actual, const std::string& alphabet)
+	{
+		const EarleyParser expectedParser(expected);
+		const EarleyParser actualParser(actual);
+		for (const auto& word : AllWords(alphabet, 6))
+		{
+			EXPECT_EQ(actualParser.Recognize(word), expectedParser.Recognize(word)) << word;
+		}
+	}
+
+	static bool HasRule(const Grammar& grammar, std::function<bool(std::span<const SymbolId>, std::span<const SymbolId>)> match)
+	{
+		for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+		{
+			if (match(grammar.GetRuleLeft(rule), grammar.GetRuleRight(rule)))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Есть ли вывод A =>+ Aγ: ребро A -> X, если правило A начинается с X после обнуляемого префикса
+	static bool HasLeftRecursion(const Grammar& grammar)
+	{
+		const std::size_t symbolCount = grammar.GetSymbolTable().GetSize();
+		std::vector<bool> nullable(symbolCount, false);
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+			{
+				const SymbolId left = grammar.GetRuleLeft(rule)[0];
+				const auto right = grammar.GetRuleRight(rule);
+				if (!nullable[left] && std::all_of(right.begin(), right.end(), [&](SymbolId symbol) {
+						return nullable[symbol];
+					}))
+				{
+					nullable[left] = changed = true;
+				}
+			}
+		}
+
+		std::vector<std::vector<SymbolId>> corners(symbolCount);
+		for (std::size_t rule = 0; rule < grammar.GetRuleCount(); ++rule)
+		{
+			for (const SymbolId symbol : grammar.GetRuleRight(rule))
+			{
+				corners[grammar.GetRuleLeft(rule)[0]].push_back(symbol);
+				if (!nullable[symbol])
+				{
+					break;
+				}
+			}
+		}
+
+		for (SymbolId from = 0; from < symbolCount; ++from)
+		{
+			std::vector<bool> visited(symbolCount, false);
+			std::vector<SymbolId> stack = corners[from];
+			while (!stack.empty())
+			{
+				const SymbolId current = stack.back();
+				stack.pop_back();
+				if (current == from)
+				{
+					return true;
+				}
+				if (!visited[current])
+				{
+					visited[current] = true;
+					stack.insert(stack.end(), corners[current].begin(), corners[current].end());
+				}
+			}
+		}
+		return false;
+	}
+};
+
+// Непорождающий A и недостижимый B удаляются вместе со своими правилами
+TEST_F(NormalFormTest, RemovesUselessSymbols)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> a | a A | b S\nA -> A b\nB -> c\n");
+	const Grammar trimmed = NormalFormAlgorithm::RemoveUselessSymbols(grammar);
+
+	EXPECT_EQ(trimmed.GetRuleCount(), 2u);
+	EXPECT_EQ(trimmed.GetNonTerminals(), (std::set<SymbolString>{"S"}));
+	ExpectSameLanguage(grammar, trimmed, "abc");
+}
+
+// После удаления ε-правил и цепных правил язык тот же, а пустое слово выводится только из нового старта
+TEST_F(NormalFormTest, RemovesEpsilonAndUnitRules)
+{
+	const Grammar grammar = GrammarBuilder::FromString("S -> A S B | c\nA -> a | ε\nB -> S | b | ε\n");
+
+	const Grammar withoutEpsilon = NormalFormAlgorithm::RemoveEpsilonRules(grammar);
+	EXPECT_EQ(withoutEpsilon.GetStartSymbol(), "S");
+	EXPECT_FALSE(HasRule(withoutEpsilon, [](auto, auto right) {
+		return right.empty();
+	}));
+	ExpectSameLanguage(grammar, withoutEpsilon, "abc");
+
+	const Grammar withoutUnit = NormalFormAlgorithm::RemoveUnitRules(withoutEpsilon);
+	EXPECT_FALSE(HasRule(withoutUnit, [&](auto, auto right) {
+		return right.size() == 1 && withoutUnit.IsNonTerminal(right[0]);
+	}));
+	ExpectSameLanguage(grammar, withoutUnit, "abc");
+
+	const Grammar nullableStart = GrammarBuilder::FromString("S -> a S b | S S | ε\n");
+	const Grammar separated = NormalFormAlgorithm::RemoveEpsilonRules(nullableStart);
+	EXPECT_EQ(separated.GetStartSymbol(), "S'");
+	ExpectSameLanguage(nullableStart, separated, "ab");
+}
+
+// Выражения без левой рекурсии дают таблицу LL(1) без конфликтов, в том числе через косвенную рекурсию
+TEST_F(NormalFormTest, RemovesLeftRecursion)
+{
+	const Grammar expression = GrammarBuilder::FromString(R"(
+		E -> E + T | T
+		T -> T * F | F
+		F -> ( E ) | i
+	)");
+	const Grammar llExpression = NormalFormAlgorithm::RemoveLeftRecursion(expression);
+	const LlTable table = ParseTableAlgorithm::BuildLl1(llExpression);
+
+	EXPECT_TRUE(table.GetConflicts().empty());
+	EXPECT_TRUE(table.Parse("i+i*(i+i)").has_value());
+	EXPECT_FALSE(table.Parse("i+*i").has_value());
+	ExpectSameLanguage(expression, llExpression, "i+*()");
+
+	const Grammar indirect = GrammarBuilder::FromString("S -> A a | b\nA -> S c | A d | ε\n");
+	const Grammar direct = NormalFormAlgorithm::RemoveLeftRecursion(indirect);
+	const auto& symbols = direct.GetSymbolTable();
+	EXPECT_FALSE(HasRule(direct, [&](auto left, auto right) {
+		return !right.empty() && right[0] == left[0];
+	}));
+	EXPECT_FALSE(HasRule(direct, [&](auto left, auto right) {
+		return symbols.GetName(left[0]) == "A" && !right.empty() && symbols.GetName(right[0]) == "S";
+	}));
+	ExpectSameLanguage(indirect, direct, "abcd");
+}
+
+// Циклы по цепным правилам (S =>+ S) и обнуляемые префиксы не оставляют скрытой левой рекурсии
+TEST_F(NormalFormTest, RemovesLeftRecursionThroughCycles)
+{
+	const std::vector<std::string> texts = {
+		"S -> S a | T\nT -> S | b\n",
+		"S -> A S b | A | c\nA -> S | a | ε\n",
+		"S -> A B\nA -> B | S a | a\nB -> A | b | ε\n",
+	};
+	for (const auto& text : texts)
+	{
+		const Grammar grammar = GrammarBuilder::FromString(text);
+		ASSERT_TRUE(HasLeftRecursion(grammar)) << text;
+
+		const Grammar direct = NormalFormAlgorithm::RemoveLeftRecursion(grammar);
+		EXPECT_FALSE(HasLeftRecursion(direct)) << text;
+		ExpectSameLanguage(grammar, direct, "abc");
+	}
+}
@@ -0,0 +1,141 @@
+#include "EarleyParser.h"
+#include "GrammarBuilder.h"
+#include "ParseTableAlgorithm.h"
+
+#include <gtest/gtest.h>
+
+class ParseTableTest : public ::testing::Test
+{
+protected:
+	// Все слова над алфавитом не длиннее maxLength
+	static std::vector<std::string> AllWords(const std::string& alphabet, std::size_t maxLength)
+	{
+		std::vector<std::string> words = {""};
+		for (std::size_t i = 0; words[i].size() < maxLength; ++i)
+		{
+			for (const char symbol : alphabet)
+			{
+				words.push_back(words[i] + symbol);
+			}
+		}
+		return words;
+	}
+
+	static std::vector<std::string> RulesToStrings(const TableGrammar& grammar, const std::vector<std::size_t>& rules)
+	{
+		std::vector<std::string> result;
+		for (const auto rule : rules)
+		{
+			result.push_back(grammar.RuleToString(rule));
+		}
+		return result;
+	}
+
+	static const std::vector<std::string_view>& Tokens()
+	{
+		static const std::vector<std::string_view> tokens = {"id", "+", "id", "*", "id"};
+		return tokens;
+	}
+};
+
+// LL(1): левый вывод по таблице, левая рекурсия дает конфликты
+TEST_F(ParseTableTest, BuildsLl1Table)
+{
+	const LlTable table = ParseTableAlgorithm::BuildLl1(GrammarBuilder::FromString(R"(
+		E -> T X
+		X -> + T X | ε
+		T -> F Y
+		Y -> * F Y | ε
+		F -> ( E ) | id
+	)"));
+	ASSERT_TRUE(table.GetConflicts().empty());
+
+	const auto rules = table.Parse(std::span<const std::string_view>(Tokens()));
+	ASSERT_TRUE(rules.has_value());
+	EXPECT_EQ(RulesToStrings(table.GetGrammar(), *rules),
+		(std::vector<std::string>{"E -> T X", "T -> F Y", "F -> id", "Y -> ε", "X -> + T X", "T -> F Y", "F -> id",
+			"Y -> * F Y", "F -> id", "Y -> ε", "X -> ε"}));
+	const std::vector<std::string_view> broken = {"id", "+", "*"};
+	EXPECT_FALSE(table.Parse(std::span<const std::string_view>(broken)).has_value());
+
+	const LlTable leftRecursive = ParseTableAlgorithm::BuildLl1(GrammarBuilder::FromString("E -> E + a | a\n"));
+	EXPECT_EQ(leftRecursive.DescribeConflicts(), (std::vector<std::string>{"Lookahead 'a': E -> E + a over E -> a"}));
+	EXPECT_THROW(leftRecursive.Parse("a+a"), std::logic_error);
+}
+
+// LALR(1) и канонический LR(1) разбирают леворекурсивную грамматику выражений одинаково
+TEST_F(ParseTableTest, BuildsLrTables)
+{
+	const Grammar grammar = GrammarBuilder::FromString(R"(
+		E -> E + T | T
+		T -> T * F | F
+		F -> ( E ) | id
+	)");
+	const LrTable lalr = ParseTableAlgorithm::BuildLalr1(grammar);
+	const LrTable canonical = ParseTableAlgorithm::BuildCanonicalLr1(grammar);
+	ASSERT_TRUE(lalr.GetConflicts().empty());
+	ASSERT_TRUE(canonical.GetConflicts().empty());
+	EXPECT_EQ(lalr.GetStateCount(), 12u);
+	EXPECT_GT(canonical.GetStateCount(), lalr.GetStateCount());
+	EXPECT_LT(lalr.GetActionRowCount(), lalr.GetStateCount());
+
+	const std::vector<std::string> expected = {"F -> id", "T -> F", "E -> T", "F -> id", "T -> F", "F -> id",
+		"T -> T * F", "E -> E + T"};
+	const auto tokens = std::span<const std::string_view>(Tokens());
+	ASSERT_TRUE(lalr.Parse(tokens).has_value());
+	ASSERT_TRUE(canonical.Parse(tokens).has_value());
+	EXPECT_EQ(RulesToStrings(lalr.GetGrammar(), *lalr.Parse(tokens)), expected);
+	EXPECT_EQ(RulesToStrings(canonical.GetGrammar(), *canonical.Parse(tokens)), expected);
+}
+
+// Грамматика не SLR(1), но LALR(1); вторая - LR(1), но не LALR(1): слияние состояний дает конфликт сверток
+TEST_F(ParseTableTest, DistinguishesLalrFromCanonicalLr)
+{
+	const Grammar assignment = GrammarBuilder::FromString("S -> L = R | R\nL -> * R | id\nR -> L\n");
+	EXPECT_TRUE(ParseTableAlgorithm::BuildLalr1(assignment).GetConflicts().empty());
+
+	const Grammar grammar = GrammarBuilder::FromString("S -> a A d | b B d | a B e | b A e\nA -> c\nB -> c\n");
+	const LrTable lalr = ParseTableAlgorithm::BuildLalr1(grammar);
+	const LrTable canonical = ParseTableAlgorithm::BuildCanonicalLr1(grammar);
+
+	EXPECT_TRUE(canonical.GetConflicts().empty());
+	ASSERT_EQ(lalr.GetConflicts().size(), 2u);
+	EXPECT_EQ(lalr.GetConflicts()[0].chosen.type, LrTable::ActionType::REDUCE);
+	EXPECT_EQ(lalr.GetConflicts()[0].rejected.type, LrTable::ActionType::REDUCE);
+	EXPECT_NE(lalr.DescribeConflicts()[0].find("reduce A -> c over reduce B -> c"), std::string::npos);
+	for (const auto& word : {"acd", "bcd", "ace", "bce"})
+	{
+		EXPECT_TRUE(canonical.Parse(word).has_value()) << word;
+	}
+}
+
+// Неоднозначная грамматика: сдвиг важнее свертки, а без конфликтов ответы совпадают с алгоритмом Эрли
+TEST_F(ParseTableTest, ResolvesConflictsAndAgreesWithEarley)
+{
+	const LrTable ambiguous = ParseTableAlgorithm::BuildLalr1(GrammarBuilder::FromString("E -> E + E | a\n"));
+	ASSERT_FALSE(ambiguous.GetConflicts().empty());
+	EXPECT_EQ(ambiguous.GetConflicts()[0].chosen.type, LrTable::ActionType::SHIFT);
+	// Правая ассоциативность: сначала свертка самого правого сложения
+	const auto reductions = ambiguous.Parse("a+a+a");
+	ASSERT_TRUE(reductions.has_value());
+	EXPECT_EQ(reductions->size(), 5u);
+
+	const std::vector<std::string> grammars = {
+		"S -> ( S ) S | ε\n",
+		"S -> A B\nA -> a A | ε\nB -> b B c | ε\n",
+		"S -> S a | A\nA -> b | ε\n",
+	};
+	for (const auto& text : grammars)
+	{
+		const Grammar grammar = GrammarBuilder::FromString(text);
+		const LrTable lalr = ParseTableAlgorithm::BuildLalr1(grammar);
+		const LrTable canonical = ParseTableAlgorithm::BuildCanonicalLr1(grammar);
+		const EarleyParser earley(grammar);
+		ASSERT_TRUE(lalr.GetConflicts().empty()) << text;
+		for (const auto& word : AllWords("()abc", 5))
+		{
+			EXPECT_EQ(lalr.Parse(word).has_value(), earley.Recognize(word)) << text << word;
+			EXPECT_EQ(canonical.Parse(word).has_value(), earley.Recognize(word)) << text << word;
+		}
+	}
+}